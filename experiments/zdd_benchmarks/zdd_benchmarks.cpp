@@ -0,0 +1,380 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+/*
+ * Benchmarks of the ZDD packages: `zdd_base` vs. `cudd::cudd_zdd`.
+ *
+ * Usage: zdd_benchmarks [--backend bill|cudd|all] [--scale small|large] [benchmark...]
+ *
+ * Every benchmark runs once per backend on a fresh manager.  The results are written to the
+ * standard output as JSON, one entry per run, with the time, the size of the result, and the
+ * statistics of the manager (see `bill::zdd_stats`).
+ *
+ * Build in release mode (`-DCMAKE_BUILD_TYPE=Release`): in debug mode, `cudd_zdd` checks the
+ * whole CUDD manager after every operation.  The build mode is part of every entry.
+ */
+#include <bill/dd/zdd_manager.hpp>
+#include <bill/dd/zdd_stats.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fmt/format.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace bill;
+
+namespace {
+
+/* Families of sets with one queen per row and no two queens attacking each other */
+struct n_queens {
+	uint32_t n;
+
+	std::string parameters() const
+	{
+		return fmt::format("n={}", n);
+	}
+
+	uint32_t num_variables() const
+	{
+		return n * n;
+	}
+
+	template<class Manager>
+	zdd_family<Manager> operator()(zdd_manager<Manager>& zdd) const
+	{
+		auto const square = [&](uint32_t row, uint32_t column) {
+			return zdd.elementary(row * n + column);
+		};
+		auto boards = zdd.top();
+		for (auto row = 0u; row < n; ++row) {
+			auto queens = zdd.bottom();
+			auto conflicts = zdd.bottom();
+			for (auto column = 0u; column < n; ++column) {
+				queens = queens | square(row, column);
+				for (auto previous = 0u; previous < row; ++previous) {
+					auto const distance = row - previous;
+					auto attacked = square(previous, column);
+					if (column >= distance) {
+						attacked = attacked | square(previous, column - distance);
+					}
+					if (column + distance < n) {
+						attacked = attacked | square(previous, column + distance);
+					}
+					conflicts = conflicts | (square(row, column) * attacked);
+				}
+			}
+			boards = zdd.nonsupersets(boards * queens, conflicts);
+		}
+		return boards;
+	}
+};
+
+/* Partitions of `n` elements into blocks of at most `max_block` elements.  There is one
+ * variable per block, hence each set of the result is a set partition. */
+struct set_partitions {
+	uint32_t n;
+	uint32_t max_block;
+
+	std::string parameters() const
+	{
+		return fmt::format("n={},max_block={}", n, max_block);
+	}
+
+	std::vector<std::vector<uint32_t>> blocks() const
+	{
+		std::vector<std::vector<uint32_t>> result;
+		for (uint32_t mask = 1u; mask < (1u << n); ++mask) {
+			std::vector<uint32_t> block;
+			for (auto element = 0u; element < n; ++element) {
+				if ((mask >> element) & 1u) {
+					block.emplace_back(element);
+				}
+			}
+			if (block.size() <= max_block) {
+				result.emplace_back(block);
+			}
+		}
+		return result;
+	}
+
+	uint32_t num_variables() const
+	{
+		return blocks().size();
+	}
+
+	template<class Manager>
+	zdd_family<Manager> operator()(zdd_manager<Manager>& zdd) const
+	{
+		auto const all_blocks = blocks();
+		std::vector<zdd_family<Manager>> containing(n, zdd.bottom());
+		for (auto i = 0u; i < all_blocks.size(); ++i) {
+			for (auto const element : all_blocks.at(i)) {
+				containing.at(element) = containing.at(element) | zdd.elementary(i);
+			}
+		}
+
+		/* pick at most one block per element, with the element as its minimum */
+		auto partitions = zdd.top();
+		for (auto element = 0u; element < n; ++element) {
+			auto choices = zdd.top();
+			for (auto i = 0u; i < all_blocks.size(); ++i) {
+				if (all_blocks.at(i).front() == element) {
+					choices = choices | zdd.elementary(i);
+				}
+			}
+			partitions = partitions * choices;
+		}
+		for (auto element = 0u; element < n; ++element) {
+			/* no two blocks overlap */
+			auto const overlaps = zdd.choose(containing.at(element), 2);
+			partitions = zdd.nonsupersets(partitions, overlaps);
+			/* every element is covered */
+			partitions = partitions - zdd.nonsupersets(partitions, containing.at(element));
+		}
+		return partitions;
+	}
+};
+
+/* All transversals (hitting sets) of a random `k`-uniform hypergraph */
+struct hypergraph_transversals {
+	uint32_t num_vertices;
+	uint32_t num_edges;
+	uint32_t k;
+	uint32_t seed;
+
+	std::string parameters() const
+	{
+		return fmt::format("vertices={},edges={},k={},seed={}", num_vertices, num_edges, k,
+		                   seed);
+	}
+
+	uint32_t num_variables() const
+	{
+		return num_vertices;
+	}
+
+	template<class Manager>
+	zdd_family<Manager> operator()(zdd_manager<Manager>& zdd) const
+	{
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<uint32_t> vertex(0u, num_vertices - 1u);
+		auto transversals = zdd.tautology();
+		for (auto i = 0u; i < num_edges; ++i) {
+			auto edge = zdd.bottom();
+			for (auto j = 0u; j < k; ++j) {
+				edge = edge | zdd.elementary(vertex(rng));
+			}
+			/* remove the sets that are disjoint with the edge */
+			transversals = transversals - zdd.nonsupersets(transversals, edge);
+		}
+		return transversals;
+	}
+};
+
+/* All `k`-combinations of a large universe, for `k` from 1 to `max_k` */
+struct choose_universe {
+	uint32_t n;
+	uint32_t max_k;
+
+	std::string parameters() const
+	{
+		return fmt::format("n={},max_k={}", n, max_k);
+	}
+
+	uint32_t num_variables() const
+	{
+		return n;
+	}
+
+	template<class Manager>
+	zdd_family<Manager> operator()(zdd_manager<Manager>& zdd) const
+	{
+		auto universe = zdd.bottom();
+		for (auto var = 0u; var < n; ++var) {
+			universe = universe | zdd.elementary(var);
+		}
+		auto combinations = zdd.bottom();
+		for (auto k = 1u; k <= max_k; ++k) {
+			combinations = combinations | zdd.choose(universe, k);
+		}
+		return combinations;
+	}
+};
+
+/* A union of power sets of blocks of variables, each one built as a chain of joins with
+ * `{{}, {var}}` */
+struct join_chain {
+	uint32_t num_blocks;
+	uint32_t block_size;
+
+	std::string parameters() const
+	{
+		return fmt::format("blocks={},block_size={}", num_blocks, block_size);
+	}
+
+	uint32_t num_variables() const
+	{
+		return num_blocks * block_size;
+	}
+
+	template<class Manager>
+	zdd_family<Manager> operator()(zdd_manager<Manager>& zdd) const
+	{
+		auto family = zdd.bottom();
+		for (auto block = 0u; block < num_blocks; ++block) {
+			auto power_set = zdd.top();
+			for (auto i = 0u; i < block_size; ++i) {
+				power_set = power_set * (zdd.top() | zdd.elementary(block * block_size + i));
+			}
+			family = family | power_set;
+		}
+		return family;
+	}
+};
+
+/* A union of many random sets, each one built as a join of elementary families */
+struct union_chain {
+	uint32_t num_vars;
+	uint32_t num_sets;
+	uint32_t set_size;
+	uint32_t seed;
+
+	std::string parameters() const
+	{
+		return fmt::format("vars={},sets={},set_size={},seed={}", num_vars, num_sets, set_size,
+		                   seed);
+	}
+
+	uint32_t num_variables() const
+	{
+		return num_vars;
+	}
+
+	template<class Manager>
+	zdd_family<Manager> operator()(zdd_manager<Manager>& zdd) const
+	{
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<uint32_t> var(0u, num_vars - 1u);
+		auto family = zdd.bottom();
+		for (auto i = 0u; i < num_sets; ++i) {
+			auto set = zdd.top();
+			for (auto j = 0u; j < set_size; ++j) {
+				set = set * zdd.elementary(var(rng));
+			}
+			family = family | set;
+		}
+		return family;
+	}
+};
+
+#ifdef NDEBUG
+constexpr char const* build_mode = "release";
+#else
+constexpr char const* build_mode = "debug";
+#endif
+
+struct measurement {
+	uint64_t num_sets = 0u;
+	uint64_t result_nodes = 0u;
+	double time = 0.0;
+	zdd_stats stats;
+};
+
+template<class Benchmark>
+measurement run(zdd_backend backend, Benchmark const& benchmark)
+{
+	return with_zdd_manager(backend, benchmark.num_variables(), [&](auto& zdd) {
+		zdd.backend().reset_stats();
+		auto const start = std::chrono::steady_clock::now();
+		auto const result = benchmark(zdd);
+		measurement m;
+		m.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now()
+		                                                   - start)
+		             .count();
+		m.stats = zdd.backend().stats();
+		m.num_sets = result.count_sets();
+		m.result_nodes = result.count_nodes();
+		return m;
+	});
+}
+
+std::string to_json(std::string const& name, std::string const& parameters,
+                    uint32_t num_vars, zdd_backend backend, measurement const& m)
+{
+	std::vector<std::string> operations;
+	for (auto i = 0u; i < uint32_t(zdd_operation::num_operations); ++i) {
+		auto const& op = m.stats.operations.at(i);
+		if (op.calls == 0u && op.cache_lookups == 0u) {
+			continue;
+		}
+		operations.emplace_back(fmt::format(
+		    "\"{}\": {{\"calls\": {}, \"cache_lookups\": {}, \"cache_hit_rate\": {:.4f}}}",
+		    zdd_operation_name(zdd_operation(i)), op.calls, op.cache_lookups, op.hit_rate()));
+	}
+	return fmt::format(
+	    "    {{\"benchmark\": \"{}\", \"parameters\": \"{}\", \"backend\": \"{}\", "
+	    "\"build\": \"{}\", "
+	    "\"num_variables\": {}, \"num_sets\": {}, \"result_nodes\": {}, \"time_ms\": {:.3f}, "
+	    "\"peak_nodes\": {}, \"live_nodes\": {}, \"cache_lookups\": {}, "
+	    "\"cache_hit_rate\": {:.4f}, \"unique_load_factor\": {:.4f}, "
+	    "\"garbage_collections\": {}, \"garbage_collection_time_ms\": {:.3f}, "
+	    "\"memory_in_use\": {}, \"peak_memory\": {}, \"operations\": {{{}}}}}",
+	    name, parameters, backend == zdd_backend::bill ? "bill" : "cudd", build_mode,
+	    num_vars, m.num_sets, m.result_nodes,
+	    m.time, m.stats.peak_nodes, m.stats.num_nodes, m.stats.cache_lookups,
+	    m.stats.hit_rate(), m.stats.unique_load_factor(), m.stats.num_garbage_collections,
+	    m.stats.garbage_collection_time, m.stats.memory_in_use, m.stats.peak_memory,
+	    fmt::join(operations, ", "));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	std::vector<zdd_backend> backends = {zdd_backend::bill, zdd_backend::cudd};
+	bool large = false;
+	std::vector<std::string> selected;
+	for (auto i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+			std::string const backend = argv[++i];
+			if (backend == "bill") {
+				backends = {zdd_backend::bill};
+			} else if (backend == "cudd") {
+				backends = {zdd_backend::cudd};
+			}
+		} else if (std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+			large = std::strcmp(argv[++i], "large") == 0;
+		} else {
+			selected.emplace_back(argv[i]);
+		}
+	}
+
+	std::vector<std::string> entries;
+	auto const benchmark = [&](std::string const& name, auto const& workload) {
+		if (!selected.empty()
+		    && std::find(selected.begin(), selected.end(), name) == selected.end()) {
+			return;
+		}
+		for (auto const backend : backends) {
+			auto const m = run(backend, workload);
+			entries.emplace_back(to_json(name, workload.parameters(), workload.num_variables(),
+			                                  backend, m));
+		}
+	};
+
+	benchmark("n_queens", n_queens{large ? 11u : 8u});
+	benchmark("set_partitions", set_partitions{large ? 10u : 8u, 3u});
+	benchmark("hypergraph_transversals",
+	          hypergraph_transversals{large ? 40u : 28u, large ? 60u : 40u, 4u, 1u});
+	benchmark("choose", choose_universe{large ? 4000u : 1000u, large ? 6u : 4u});
+	benchmark("join_chain", join_chain{large ? 100u : 25u, 40u});
+	benchmark("union_chain", union_chain{large ? 1024u : 256u, large ? 20000u : 2000u, 8u, 1u});
+
+	std::cout << fmt::format("{{\n  \"benchmarks\": [\n{}\n  ]\n}}\n", fmt::join(entries, ",\n"));
+	return 0;
+}
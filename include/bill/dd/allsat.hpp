@@ -0,0 +1,372 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "../sat/interface/common.hpp"
+#include "../sat/interface/types.hpp"
+#include "zdd_manager.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Statistics of `allsat_zdd`. */
+struct allsat_zdd_stats {
+	/*! \brief Number of calls to the SAT solver */
+	uint64_t num_solver_calls = 0u;
+	/*! \brief Number of decisions, i.e., branchings on a projection variable */
+	uint64_t num_decisions = 0u;
+	/*! \brief Number of components that were compiled */
+	uint64_t num_components = 0u;
+	/*! \brief Number of components whose family was found in the cache */
+	uint64_t num_cache_hits = 0u;
+	/*! \brief Number of components solved by a single (shrunk) cube */
+	uint64_t num_cubes = 0u;
+};
+
+namespace detail {
+
+template<class Solver, class Manager>
+class allsat_compiler {
+	using family_type = zdd_family<Manager>;
+	using traits = zdd_traits<Manager>;
+	using clause_type = std::vector<lit_type>;
+	using cnf_type = std::vector<clause_type>;
+
+	struct key_hash {
+		std::size_t operator()(std::vector<uint32_t> const& key) const
+		{
+			std::size_t seed = key.size();
+			for (auto const value : key) {
+				seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			}
+			return seed;
+		}
+	};
+
+public:
+	allsat_compiler(Solver& solver, std::vector<var_type> const& projection, Manager& zdd,
+	                allsat_zdd_stats& st)
+	    : solver_(solver)
+	    , zdd_(zdd)
+	    , st_(st)
+	{
+		assert(projection.size() <= traits::num_variables(zdd));
+		for (auto i = 0u; i < projection.size(); ++i) {
+			zdd_var_.emplace(projection.at(i), i);
+		}
+	}
+
+	family_type run(cnf_type const& clauses)
+	{
+		cnf_type normalized;
+		normalized.reserve(clauses.size());
+		for (auto clause : clauses) {
+			std::sort(clause.begin(), clause.end());
+			clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+			bool tautology = false;
+			for (auto i = 1u; i < clause.size(); ++i) {
+				tautology |= clause.at(i - 1u).variable() == clause.at(i).variable();
+			}
+			if (!tautology) {
+				normalized.emplace_back(std::move(clause));
+			}
+		}
+		std::vector<var_type> scope;
+		scope.reserve(zdd_var_.size());
+		for (auto const& [var, _] : zdd_var_) {
+			scope.emplace_back(var);
+		}
+		std::sort(scope.begin(), scope.end());
+		if (normalized.empty()) {
+			return power_set(scope);
+		}
+		std::vector<lit_type> assumptions;
+		return compile(assumptions, normalized, scope);
+	}
+
+private:
+	/* Families of the solutions of `clauses` (the residual formula under `assumptions`) over
+	 * the projection variables in `scope` */
+	family_type compile(std::vector<lit_type>& assumptions, cnf_type const& clauses,
+	                    std::vector<var_type> const& scope)
+	{
+		++st_.num_solver_calls;
+		if (solver_.solve(assumptions) != result::states::satisfiable) {
+			return bottom();
+		}
+		auto const model = solver_.get_model().model();
+		return decompose(assumptions, clauses, scope, model);
+	}
+
+	/* Splits the residual formula into components that share no variable */
+	family_type decompose(std::vector<lit_type>& assumptions, cnf_type const& clauses,
+	                      std::vector<var_type> const& scope, result::model_type const& model)
+	{
+		std::unordered_map<uint32_t, uint32_t> parent;
+		auto const find = [&](uint32_t var) {
+			auto it = parent.emplace(var, var).first;
+			while (it->second != var) {
+				var = it->second;
+				it = parent.find(var);
+			}
+			return var;
+		};
+		for (auto const& clause : clauses) {
+			auto const root = find(clause.front().variable());
+			for (auto const lit : clause) {
+				parent.at(find(lit.variable())) = root;
+			}
+		}
+
+		std::unordered_map<uint32_t, uint32_t> component_of;
+		std::vector<cnf_type> components;
+		std::vector<std::vector<var_type>> component_scopes;
+		for (auto const& clause : clauses) {
+			auto const root = find(clause.front().variable());
+			auto const [it, inserted] = component_of.emplace(root, components.size());
+			if (inserted) {
+				components.emplace_back();
+				component_scopes.emplace_back();
+			}
+			components.at(it->second).emplace_back(clause);
+		}
+		std::vector<var_type> free_vars;
+		for (auto const var : scope) {
+			auto const it = parent.find(var);
+			if (it == parent.end()) {
+				free_vars.emplace_back(var);
+			} else {
+				component_scopes.at(component_of.at(find(var))).emplace_back(var);
+			}
+		}
+
+		auto result = power_set(free_vars);
+		for (auto i = 0u; i < components.size(); ++i) {
+			auto const family = compile_component(assumptions, components.at(i),
+			                                      component_scopes.at(i), model);
+			if (family.node() == traits::bottom(zdd_)) {
+				return bottom();
+			}
+			result = result * family;
+		}
+		return result;
+	}
+
+	/* Compiles one component, satisfied by `model`, with caching */
+	family_type compile_component(std::vector<lit_type>& assumptions, cnf_type const& clauses,
+	                              std::vector<var_type> const& scope,
+	                              result::model_type const& model)
+	{
+		auto key = make_key(clauses);
+		if (auto const it = cache_.find(key); it != cache_.end()) {
+			++st_.num_cache_hits;
+			return it->second;
+		}
+		++st_.num_components;
+
+		auto const cube = shrink(clauses, scope, model);
+		if (cube.empty()) {
+			++st_.num_cubes;
+			auto result = power_set(scope);
+			cache_.emplace(std::move(key), result);
+			return result;
+		}
+
+		/* branch on the cube variable with the most occurrences */
+		std::unordered_map<uint32_t, uint32_t> occurrences;
+		for (auto const& clause : clauses) {
+			for (auto const lit : clause) {
+				++occurrences[lit.variable()];
+			}
+		}
+		auto const decision = *std::max_element(cube.begin(), cube.end(), [&](auto a, auto b) {
+			return occurrences.at(a.variable()) < occurrences.at(b.variable());
+		});
+		++st_.num_decisions;
+
+		std::vector<var_type> sub_scope;
+		sub_scope.reserve(scope.size() - 1u);
+		for (auto const var : scope) {
+			if (var != decision.variable()) {
+				sub_scope.emplace_back(var);
+			}
+		}
+		auto const branch = [&](lit_type lit) {
+			cnf_type residual;
+			if (!simplify(clauses, lit, residual)) {
+				return bottom();
+			}
+			if (residual.empty()) {
+				return power_set(sub_scope);
+			}
+			assumptions.emplace_back(lit);
+			/* `model` is still a model of the branch that agrees with it */
+			auto family = lit == decision ? decompose(assumptions, residual, sub_scope, model)
+			                              : compile(assumptions, residual, sub_scope);
+			assumptions.pop_back();
+			return family;
+		};
+		auto const var = decision.variable();
+		auto const hi = branch(lit_type(var, positive_polarity));
+		auto const lo = branch(lit_type(var, negative_polarity));
+		auto result = lo | (hi * elementary(var));
+		cache_.emplace(std::move(key), result);
+		return result;
+	}
+
+	/* Returns the projection literals of `model` that are needed to satisfy `clauses`; every
+	 * assignment of the other projection variables in `scope` satisfies them too */
+	clause_type shrink(cnf_type const& clauses, std::vector<var_type> const& scope,
+	                   result::model_type const& model) const
+	{
+		auto const is_true = [&](lit_type lit) {
+			auto const value = model.at(lit.variable());
+			return lit.is_complemented() ? value != lbool_type::true_
+			                             : value == lbool_type::true_;
+		};
+		std::vector<uint32_t> num_true(clauses.size(), 0u);
+		std::unordered_map<uint32_t, std::vector<uint32_t>> satisfied;
+		for (auto i = 0u; i < clauses.size(); ++i) {
+			for (auto const lit : clauses.at(i)) {
+				if (is_true(lit)) {
+					++num_true.at(i);
+					satisfied[lit.variable()].emplace_back(i);
+				}
+			}
+		}
+
+		clause_type cube;
+		for (auto const var : scope) {
+			auto const it = satisfied.find(var);
+			if (it == satisfied.end()) {
+				continue;
+			}
+			bool const needed = std::any_of(it->second.begin(), it->second.end(),
+			                                [&](auto i) { return num_true.at(i) == 1u; });
+			if (needed) {
+				cube.emplace_back(var, model.at(var) == lbool_type::true_ ? positive_polarity :
+				                                                            negative_polarity);
+				continue;
+			}
+			for (auto const i : it->second) {
+				--num_true.at(i);
+			}
+		}
+		return cube;
+	}
+
+	/* Assigns `lit` to true in `clauses`, returns false if a clause becomes empty */
+	static bool simplify(cnf_type const& clauses, lit_type lit, cnf_type& residual)
+	{
+		residual.reserve(clauses.size());
+		for (auto const& clause : clauses) {
+			if (std::find(clause.begin(), clause.end(), lit) != clause.end()) {
+				continue;
+			}
+			auto& reduced = residual.emplace_back();
+			reduced.reserve(clause.size());
+			for (auto const other : clause) {
+				if (other != ~lit) {
+					reduced.emplace_back(other);
+				}
+			}
+			if (reduced.empty()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* Canonical representation of a component: its sorted clauses, separated by `0` */
+	static std::vector<uint32_t> make_key(cnf_type const& clauses)
+	{
+		std::vector<std::vector<uint32_t>> sorted;
+		sorted.reserve(clauses.size());
+		for (auto const& clause : clauses) {
+			auto& literals = sorted.emplace_back();
+			for (auto const lit : clause) {
+				literals.emplace_back(2u * lit.variable() + lit.is_complemented() + 1u);
+			}
+		}
+		std::sort(sorted.begin(), sorted.end());
+		std::vector<uint32_t> key;
+		for (auto const& literals : sorted) {
+			key.insert(key.end(), literals.begin(), literals.end());
+			key.emplace_back(0u);
+		}
+		return key;
+	}
+
+	family_type bottom()
+	{
+		return family_type(zdd_, traits::acquire(zdd_, traits::bottom(zdd_)));
+	}
+
+	family_type elementary(var_type var)
+	{
+		auto const node = traits::elementary(zdd_, zdd_var_.at(var));
+		return family_type(zdd_, traits::acquire(zdd_, node));
+	}
+
+	/* All subsets of `vars` */
+	family_type power_set(std::vector<var_type> const& vars)
+	{
+		family_type const top(zdd_, traits::acquire(zdd_, traits::top(zdd_)));
+		auto result = top;
+		for (auto const var : vars) {
+			result = result * (top | elementary(var));
+		}
+		return result;
+	}
+
+private:
+	Solver& solver_;
+	Manager& zdd_;
+	allsat_zdd_stats& st_;
+	std::unordered_map<uint32_t, uint32_t> zdd_var_;
+	std::unordered_map<std::vector<uint32_t>, family_type, key_hash> cache_;
+};
+
+} // namespace detail
+
+/*! \brief Compiles the solutions of a CNF, projected onto some variables, into a ZDD.
+ *
+ * Instead of enumerating the models one by one with blocking clauses, the compiler follows a
+ * decision-DNNF style recursion.  The residual formula is split into components that share no
+ * variable, whose families are compiled independently, joined, and cached.  Each model found
+ * by the solver is shrunk to the projection literals that are needed to satisfy the component:
+ * if none is needed, all assignments of its projection variables are solutions, otherwise the
+ * compiler branches on one of them.
+ *
+ * The solver must contain `clauses` (and possibly constraints implied by them), and is called
+ * with assumptions on the projection variables only.  Set `i` of the result contains ZDD
+ * variable `i` if `projection[i]` is true, hence `zdd` needs at least `projection.size()`
+ * variables.
+ *
+ * \param solver SAT solver, e.g., any `bill::solver<>`
+ * \param clauses Clauses of the CNF
+ * \param projection Projection variables
+ * \param zdd Target ZDD package (`zdd_base` or `cudd::cudd_zdd`)
+ * \param st Statistics (optional)
+ * \return Family of the projected solutions
+ */
+template<class Solver, class Manager>
+zdd_family<Manager> allsat_zdd(Solver& solver, std::vector<std::vector<lit_type>> const& clauses,
+                               std::vector<var_type> const& projection, Manager& zdd,
+                               allsat_zdd_stats* st = nullptr)
+{
+	allsat_zdd_stats local_st;
+	detail::allsat_compiler<Solver, Manager> compiler(solver, projection, zdd,
+	                                                  st ? *st : local_st);
+	return compiler.run(clauses);
+}
+
+} // namespace bill
@@ -1,5 +1,10 @@
+#pragma once
+
 #include "cplusplus/cuddObj.hh"
 #include "cudd/cuddInt.h"
+#include "zdd_stats.hpp"
+#include <algorithm>
+#include <numeric>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -9,23 +14,90 @@
 
 namespace cudd {
 
+struct cudd_zdd_params
+{
+  /* initial number of slots in each subtable of the unique table */
+  uint32_t unique_slots = CUDD_UNIQUE_SLOTS;
+
+  /* initial number of slots in the computed table (cache) */
+  uint32_t cache_slots = CUDD_CACHE_SLOTS;
+
+  /* hard limit on the number of cache slots when the cache grows (0: CUDD's default) */
+  uint32_t max_cache_slots = 0;
+
+  /* memory ceiling in bytes; limits the growth of the tables (0: derived from available memory) */
+  size_t max_memory = 0;
+
+  /* enable automatic dynamic reordering of the ZDD variables */
+  bool auto_reorder = false;
+
+  /* heuristic used by automatic reordering */
+  Cudd_ReorderingType reorder_method = CUDD_REORDER_SYMM_SIFT;
+
+  /* number of live nodes that triggers the first automatic reordering (0: CUDD's default) */
+  uint32_t first_reordering = 0;
+};
+
+struct cudd_zdd_reordering_stats
+{
+  /* number of reorderings performed (on demand and automatic) */
+  uint32_t num_reorderings = 0;
+
+  /* time spent reordering in milliseconds */
+  int64_t reordering_time = 0;
+
+  /* number of live ZDD nodes */
+  uint64_t num_nodes = 0;
+
+  /* number of live nodes that triggers the next automatic reordering */
+  uint32_t next_reordering = 0;
+
+  /* whether automatic reordering is enabled */
+  bool auto_reorder = false;
+};
+
 class cudd_zdd 
 {
 public:
-  cudd_zdd( uint32_t num_variables ) 
-    : num_variables( num_variables ), empty( cudd.zddZero() ), base( cudd.zddOne( INT_MAX ) )
+  cudd_zdd( uint32_t num_vars, cudd_zdd_params const& ps = {} ) 
+    : cudd( 0, 0, ps.unique_slots, ps.cache_slots, ps.max_memory )
+    , num_vars( num_vars ), empty( cudd.zddZero() ), base( cudd.zddOne( INT_MAX ) )
   {
-    elementaries.reserve( num_variables );
-    for ( auto i = 0u; i < num_variables; ++i )
+    elementaries.reserve( num_vars );
+    for ( auto i = 0u; i < num_vars; ++i )
     {
       elementaries.emplace_back( base.Change( i ) );
     }
-    tautologies.reserve( num_variables );
-    for ( auto i = 0u; i < num_variables; ++i )
+    tautologies.reserve( num_vars );
+    for ( auto i = 0u; i < num_vars; ++i )
     {
       tautologies.emplace_back( cudd.zddOne( i ) );
     }
-    assert( cudd.ReadZddSize() == int( num_variables ) );
+    assert( cudd.ReadZddSize() == int( num_vars ) );
+    assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
+
+    if ( ps.max_cache_slots != 0 )
+    {
+      Cudd_SetMaxCacheHard( cudd.getManager(), ps.max_cache_slots );
+    }
+    if ( ps.first_reordering != 0 )
+    {
+      Cudd_SetNextReordering( cudd.getManager(), ps.first_reordering );
+    }
+    if ( ps.auto_reorder )
+    {
+      enable_reordering( ps.reorder_method );
+    }
+  }
+
+  /* `order` gives the variable at each level, from top to bottom (see `bill/dd/variable_order.hpp`) */
+  cudd_zdd( std::vector<uint32_t> const& order, cudd_zdd_params const& ps = {} )
+    : cudd_zdd( order.size(), ps )
+  {
+    std::vector<int> permutation( order.begin(), order.end() );
+    [[maybe_unused]] auto const ok = Cudd_zddShuffleHeap( cudd.getManager(), permutation.data() );
+    assert( ok == 1 );
+    refresh_tautologies();
     assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
   }
 
@@ -36,7 +108,7 @@ public:
   void print( ZDD const& node, std::string const& name = "", int verbosity = 4 )
   {
     std::cout << name << " (" << node.getNode() << ", level = " << Cudd_NodeReadIndex( node.getNode() ) << ")";
-    node.print( num_variables, verbosity );
+    node.print( num_vars, verbosity );
   }
 
   ZDD ref( ZDD const& node )
@@ -66,26 +138,52 @@ public:
    */
   ZDD unique( uint32_t var, ZDD const& E, ZDD const& T )
   {
-    assert( T.NodeReadIndex() > var && E.NodeReadIndex() > var );
-    return ZDD( cudd, cuddZddGetNode( cudd.getManager(), var, T.getNode(), E.getNode() ) );
+    assert( level( T.getNode() ) > level( var ) && level( E.getNode() ) > level( var ) );
+    /* the children are ordered w.r.t. the current order, do not reorder in between */
+    DdManager* dd = cudd.getManager();
+    auto const auto_reorder = dd->autoDynZ;
+    dd->autoDynZ = 0;
+    auto const node = cuddZddGetNode( dd, var, T.getNode(), E.getNode() );
+    dd->autoDynZ = auto_reorder;
+    return ZDD( cudd, node );
   }
 
 public: /* basic getters; does NOT increase ref count */
+  uint32_t num_variables() const { return num_vars; }
+
+
   ZDD& bottom() { return empty; }
   ZDD& top() { return base; }
 
   ZDD& elementary( uint32_t var )
   {
-    assert( var < num_variables );
+    assert( var < num_vars );
     return elementaries[var];
   }
 
+  /* every combination of the variables at levels >= `var` */
   ZDD& tautology( uint32_t var = 0 )
   {
-    assert( var < num_variables );
+    assert( var < num_vars );
+    if ( Cudd_ReadReorderings( cudd.getManager() ) != num_reorderings )
+    {
+      refresh_tautologies();
+    }
     return tautologies[var];
   }
 
+  /* level of variable `var` in the current variable order */
+  uint32_t level( uint32_t var ) const
+  {
+    return Cudd_ReadPermZdd( cudd.getManager(), var );
+  }
+
+  /* variable at level `level` in the current variable order */
+  uint32_t var_at_level( uint32_t level ) const
+  {
+    return Cudd_ReadInvPermZdd( cudd.getManager(), level );
+  }
+
 public: /* operations provided by CUDD, wrapped with `bill` function names */
   ZDD union_( ZDD const& f, ZDD const& g )
   {
@@ -106,8 +204,8 @@ public: /* operations not provided by CUDD */
   /* union every pair of subsets in f and g */
   ZDD join( ZDD const& f, ZDD const& g )
   {
-    assert( ( f == empty || f == base || f.NodeReadIndex() < num_variables) && ( g == empty || g == base || g.NodeReadIndex() < num_variables ) );
-    auto r = ZDD( cudd, join( f.getNode(), g.getNode() ) );
+    assert( ( f == empty || f == base || f.NodeReadIndex() < num_vars) && ( g == empty || g == base || g.NodeReadIndex() < num_vars ) );
+    auto r = apply( [&]() { return join( f.getNode(), g.getNode() ); } );
     assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
     return r;
   }
@@ -116,35 +214,73 @@ public: /* operations not provided by CUDD */
   /* \forall A \in result, A \in f and \forall B \in g, A \notsuperset B */
   ZDD nonsupersets( ZDD const& f, ZDD const& g )
   {
-    assert( ( f == empty || f == base || f.NodeReadIndex() < num_variables) && ( g == empty || g == base || g.NodeReadIndex() < num_variables ) );
-    auto r = ZDD( cudd, nonsupersets( f.getNode(), g.getNode() ) );
+    assert( ( f == empty || f == base || f.NodeReadIndex() < num_vars) && ( g == empty || g == base || g.NodeReadIndex() < num_vars ) );
+    auto r = apply( [&]() { return nonsupersets( f.getNode(), g.getNode() ); } );
     assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
     return r;
   }
 
   ZDD choose( ZDD const& f, uint32_t k )
   {
-    assert( f == empty || f == base || f.NodeReadIndex() < num_variables );
-    auto r = ZDD( cudd, choose( f.getNode(), k ) );
+    assert( f == empty || f == base || f.NodeReadIndex() < num_vars );
+    auto r = apply( [&]() { return choose( f.getNode(), k ); } );
     assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
     return r;
   }
 
-  /* builds an ZDD with one minterm, having '-' at variables in `vec`, and '0' at other variables
-   * `vec` is assumed to be sorted decreasingly
-   */
-  ZDD care( std::vector<uint32_t> const& vec )
+  /* sets in f that are not a subset of another set in f */
+  ZDD maximal( ZDD const& f )
+  {
+    auto r = apply( [&]() { return maximal( f.getNode() ); } );
+    assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
+    return r;
+  }
+
+  /* intersect every pair of subsets in f and g */
+  ZDD meet( ZDD const& f, ZDD const& g )
+  {
+    auto r = apply( [&]() { return meet( f.getNode(), g.getNode() ); } );
+    assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
+    return r;
+  }
+
+  /* resulting sets are elements in f, but not subset of any element in g */
+  /* \forall A \in result, A \in f and \forall B \in g, A \notsubset B */
+  ZDD nonsubsets( ZDD const& f, ZDD const& g )
+  {
+    auto r = apply( [&]() { return nonsubsets( f.getNode(), g.getNode() ); } );
+    assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
+    return r;
+  }
+
+  /* weak division: the largest family q such that join( q, g ) \subseteq f and every set of q
+   * is disjoint with every set of g, i.e., { A | A \cup B \in f and A \cap B = \emptyset, \forall B \in g } */
+  ZDD edivide( ZDD const& f, ZDD const& g )
+  {
+    auto r = apply( [&]() { return edivide( f.getNode(), g.getNode() ); } );
+    assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
+    return r;
+  }
+
+  /* builds an ZDD with one minterm, having '-' at variables in `vec`, and '0' at other variables */
+  ZDD care( std::vector<uint32_t> vec )
   {
     DdNode* n1 = base.getNode();
     DdNode* n2 = 0;
 
+    /* build bottom-up, without reordering in between */
+    DdManager* dd = cudd.getManager();
+    auto const auto_reorder = dd->autoDynZ;
+    dd->autoDynZ = 0;
+    std::sort( vec.begin(), vec.end(), [&]( auto a, auto b ) { return level( a ) > level( b ); } );
     for ( auto i : vec )
     {
-      assert( i < num_variables );
+      assert( i < num_vars );
       n2 = unique( i, n1, n1 ); ref( n2 );
       if ( n1 != base.getNode() ) { Cudd_Deref( n1 ); }
       n1 = n2;
     }
+    dd->autoDynZ = auto_reorder;
 
     Cudd_Deref( n2 );
     auto r = ZDD( cudd, n2 );
@@ -156,7 +292,7 @@ public: /* operations not provided by CUDD */
   ZDD dont_care( std::vector<uint32_t> const& vec )
   {
     std::vector<uint32_t> vec2;
-    for ( int i = num_variables - 1; i >= 0; --i )
+    for ( int i = num_vars - 1; i >= 0; --i )
     {
       bool found = false;
       for ( auto j : vec )
@@ -176,12 +312,162 @@ public: /* operations not provided by CUDD */
     return care( vec2 );
   }
 
-  //edivide
-  //maximal
-  //meet
-  //nonsubsets
+public: /* conversion from and to BDDs in the same manager */
+  /* the CUDD manager, e.g., to build BDDs */
+  Cudd& manager() { return cudd; }
+
+  /* BDD variable `var`, which corresponds to ZDD variable `var` in `from_bdd` and `to_bdd` */
+  BDD bdd_variable( uint32_t var )
+  {
+    return cudd.bddVar( var );
+  }
+
+  /* the family of the satisfying assignments (as sets of true variables) of a BDD */
+  ZDD from_bdd( BDD const& f )
+  {
+    sync_bdd_order( 1u );
+    return ZDD( cudd, Cudd_zddPortFromBdd( cudd.getManager(), f.getNode() ) );
+  }
+
+  /* the characteristic function of a family */
+  BDD to_bdd( ZDD const& f )
+  {
+    return BDD( cudd, Cudd_zddPortToBdd( cudd.getManager(), f.getNode() ) );
+  }
+
+  /* Irredundant sum of products of a function in the interval [`lower`, `upper`] (both equal for a
+   * single function), as a family of cubes.  BDD variable i is represented by ZDD variables 2i (positive
+   * literal) and 2i + 1 (negative literal), as in `bill::lit_type`, which must be adjacent in the order.
+   * The BDD of the chosen function is stored in `function` if given. */
+  ZDD isop( BDD const& lower, BDD const& upper, BDD* function = nullptr )
+  {
+    sync_bdd_order( 2u );
+    ZDD cover;
+    auto const g = lower.zddIsop( upper, &cover );
+    if ( function != nullptr )
+    {
+      *function = g;
+    }
+    return cover;
+  }
+
+public: /* variable reordering */
+  /* enables automatic dynamic reordering, triggered when the number of nodes grows */
+  void enable_reordering( Cudd_ReorderingType method = CUDD_REORDER_SYMM_SIFT )
+  {
+    Cudd_AutodynEnableZdd( cudd.getManager(), method );
+  }
+
+  void disable_reordering()
+  {
+    Cudd_AutodynDisableZdd( cudd.getManager() );
+  }
+
+  /* reorders the variables now, unless there are fewer than `min_size` live nodes */
+  bool reorder( Cudd_ReorderingType method = CUDD_REORDER_SYMM_SIFT, int min_size = 0 )
+  {
+    auto const ok = Cudd_zddReduceHeap( cudd.getManager(), method, min_size );
+    refresh_tautologies();
+    assert( Cudd_DebugCheck( cudd.getManager() ) == 0 );
+    return ok == 1;
+  }
+
+  cudd_zdd_reordering_stats reordering_stats() const
+  {
+    DdManager* dd = cudd.getManager();
+    Cudd_ReorderingType method;
+    cudd_zdd_reordering_stats st;
+    st.num_reorderings = Cudd_ReadReorderings( dd );
+    st.reordering_time = Cudd_ReadReorderingTime( dd );
+    st.num_nodes = Cudd_zddReadNodeCount( dd );
+    st.next_reordering = Cudd_ReadNextReordering( dd );
+    st.auto_reorder = Cudd_ReorderingStatusZdd( dd, &method ) == 1;
+    return st;
+  }
+
+public: /* statistics */
+  /* Statistics sourced from CUDD's counters (see `bill::zdd_stats`).  The per-operation counters cover the
+   * operations implemented here, and count one call per computed table lookup; the totals include CUDD's
+   * own operations.  `peak_nodes` is the number of nodes allocated by CUDD, and `peak_memory` is sampled
+   * whenever the statistics are read. */
+  bill::zdd_stats stats() const
+  {
+    DdManager* dd = cudd.getManager();
+    bill::zdd_stats st;
+    st.operations = operation_counters;
+    st.cache_lookups = uint64_t( Cudd_ReadCacheLookUps( dd ) ) - baseline.cache_lookups;
+    st.cache_misses = uint64_t( Cudd_ReadCacheLookUps( dd ) - Cudd_ReadCacheHits( dd ) ) - baseline.cache_misses;
+    st.cache_slots = Cudd_ReadCacheSlots( dd );
+    st.cache_entries = uint64_t( Cudd_ReadCacheUsedSlots( dd ) * st.cache_slots );
+    st.num_nodes = Cudd_zddReadNodeCount( dd );
+    st.num_dead_nodes = dd->deadZ;
+    st.peak_nodes = Cudd_ReadPeakNodeCount( dd );
+    st.unique_entries = dd->keysZ;
+    for ( auto i = 0; i < dd->sizeZ; ++i )
+    {
+      st.unique_slots += dd->subtableZ[i].slots;
+    }
+    st.num_garbage_collections = Cudd_ReadGarbageCollections( dd ) - baseline.num_garbage_collections;
+    st.garbage_collection_time = Cudd_ReadGarbageCollectionTime( dd ) - baseline.garbage_collection_time;
+    st.num_reorderings = Cudd_ReadReorderings( dd ) - baseline.num_reorderings;
+    st.reordering_time = Cudd_ReadReorderingTime( dd ) - baseline.reordering_time;
+    st.memory_in_use = Cudd_ReadMemoryInUse( dd );
+    peak_memory = std::max<uint64_t>( peak_memory, st.memory_in_use );
+    st.peak_memory = peak_memory;
+    return st;
+  }
+
+  /* resets the counters (CUDD's counters are not modified, the current values become the baseline) */
+  void reset_stats()
+  {
+    operation_counters = {};
+    baseline = {};
+    baseline = stats();
+    peak_memory = baseline.memory_in_use;
+  }
 
 private: /* implementation details */
+  /* the universe of each level changes when the variables are reordered */
+  void refresh_tautologies()
+  {
+    for ( auto i = 0u; i < num_vars; ++i )
+    {
+      tautologies[i] = cudd.zddOne( i );
+    }
+    num_reorderings = Cudd_ReadReorderings( cudd.getManager() );
+  }
+
+  /* Creates the BDD variables that correspond to the ZDD variables (`multiplicity` ZDD variables each,
+   * in the order of the ZDD variables `i * multiplicity`), and puts them into the same order. */
+  void sync_bdd_order( uint32_t multiplicity )
+  {
+    DdManager* dd = cudd.getManager();
+    uint32_t const num_bdd_vars = num_vars / multiplicity;
+    while ( uint32_t( Cudd_ReadSize( dd ) ) < num_bdd_vars )
+    {
+      cudd.bddVar();
+    }
+    std::vector<int> permutation( Cudd_ReadSize( dd ) );
+    std::iota( permutation.begin(), permutation.end(), 0 );
+    auto const key = [&]( uint32_t var ) { return var < num_bdd_vars ? level( var * multiplicity ) : num_vars + var; };
+    std::sort( permutation.begin(), permutation.end(), [&]( auto a, auto b ) { return key( a ) < key( b ); } );
+    for ( auto i = 0u; i < permutation.size(); ++i )
+    {
+      if ( Cudd_ReadInvPerm( dd, i ) != permutation[i] )
+      {
+        [[maybe_unused]] auto const ok = Cudd_ShuffleHeap( dd, permutation.data() );
+        assert( ok == 1 );
+        break;
+      }
+    }
+  }
+
+  /* level of the top variable of `f`; constants are below all variables */
+  uint32_t level( DdNode* f ) const
+  {
+    return cuddIsConstant( f ) ? CUDD_CONST_INDEX : cudd.getManager()->permZ[f->index];
+  }
+
   DdNode* lo( DdNode* f ) { return cuddE( f ); }
   DdNode* hi( DdNode* f ) { return cuddT( f ); }
   DdNode* ref( DdNode* node ) { Cudd_Ref( node ); return node; }
@@ -207,19 +493,42 @@ private: /* implementation details */
   DdNode* unique( uint32_t var, DdNode* lo, DdNode* hi )
   { return cuddZddGetNode( cudd.getManager(), var, hi, lo ); }
 
+  /* The following recursive routines use CUDD's internal operators, which return NULL when a
+   * dynamic reordering (or a memory out) happened in the meantime.  In that case, all
+   * intermediate results are released and NULL is propagated up to `apply`, which restarts
+   * the operation, as in CUDD's own operators. */
   DdNode* union_( DdNode* f, DdNode* g )
-  { return Cudd_zddUnion( cudd.getManager(), f, g ); }
+  { return cuddZddUnion( cudd.getManager(), f, g ); }
 
   DdNode* intersection( DdNode* f, DdNode* g )
-  { return Cudd_zddIntersect( cudd.getManager(), f, g ); }
+  { return cuddZddIntersect( cudd.getManager(), f, g ); }
 
   DdNode* difference( DdNode* f, DdNode* g )
-  { return Cudd_zddDiff( cudd.getManager(), f, g ); }
+  { return cuddZddDiff( cudd.getManager(), f, g ); }
+
+  /* runs a recursive operation until it completes without being interrupted by reordering */
+  template<class Fn>
+  ZDD apply( Fn&& fn )
+  {
+    DdManager* dd = cudd.getManager();
+    DdNode* r;
+    do
+    {
+      dd->reordered = 0;
+      r = fn();
+    } while ( dd->reordered == 1 );
+    /* the ZDD constructor reports a NULL result (e.g., memory out) to the error handler */
+    return ZDD( cudd, r );
+  }
 
   /* replacement of function pointers to be used in the operation cache */
   uint64_t join_ = 2;
   uint64_t nonsupersets_ = 4;
-  uint64_t choose_ = 6;
+  uint64_t choose_ = 6; /* even numbers from here on are used by `choose`, one per k */
+  uint64_t maximal_ = 3;
+  uint64_t meet_ = 5;
+  uint64_t nonsubsets_ = 7;
+  uint64_t edivide_ = 9;
 
   DdNode* join( DdNode* f, DdNode* g )
   {
@@ -230,7 +539,7 @@ private: /* implementation details */
     if ( f == b ) { return g; }
     if ( g == b ) { return f; }
 
-    if ( Cudd_NodeReadIndex( f ) < Cudd_NodeReadIndex( g ) ) { return join( g, f ); }
+    if ( level( f ) < level( g ) ) { return join( g, f ); }
 
     /* cache lookup */
     auto res = cache_lookup( cudd.getManager(), join_, f, g );
@@ -240,33 +549,58 @@ private: /* implementation details */
     DdNode* lo = 0;
     DdNode* hi = 0;
     
-    if ( Cudd_NodeReadIndex( f ) > Cudd_NodeReadIndex( g ) )
+    if ( level( f ) > level( g ) )
     {
-      lo = join( f, cuddE( g ) ); ref( lo );
-      hi = join( f, cuddT( g ) ); ref( hi );
+      lo = join( f, cuddE( g ) );
+      if ( lo == NULL ) { return NULL; }
+      ref( lo );
+      hi = join( f, cuddT( g ) );
+      if ( hi == NULL ) { deref( lo ); return NULL; }
+      ref( hi );
     }
     else /* f_var == g_var */
     {
       #if 1 /* Knuth's book */
-      DdNode* tmp0 = join( cuddE( f ), cuddT( g ) ); ref( tmp0 );
-      DdNode* tmp1 = join( cuddT( f ), cuddE( g ) ); ref( tmp1 );
-      DdNode* tmp2 = join( cuddT( f ), cuddT( g ) ); ref( tmp2 );
-      DdNode* tmp3 = union_( tmp0, tmp1 ); ref( tmp3 );
+      DdNode* tmp0 = join( cuddE( f ), cuddT( g ) );
+      if ( tmp0 == NULL ) { return NULL; }
+      ref( tmp0 );
+      DdNode* tmp1 = join( cuddT( f ), cuddE( g ) );
+      if ( tmp1 == NULL ) { deref( tmp0 ); return NULL; }
+      ref( tmp1 );
+      DdNode* tmp2 = join( cuddT( f ), cuddT( g ) );
+      if ( tmp2 == NULL ) { deref( tmp0 ); deref( tmp1 ); return NULL; }
+      ref( tmp2 );
+      DdNode* tmp3 = union_( tmp0, tmp1 );
+      if ( tmp3 == NULL ) { deref( tmp0 ); deref( tmp1 ); deref( tmp2 ); return NULL; }
+      ref( tmp3 );
       deref( tmp0 ); deref( tmp1 );
-      hi = union_( tmp2, tmp3 ); ref( hi );
+      hi = union_( tmp2, tmp3 );
+      if ( hi == NULL ) { deref( tmp2 ); deref( tmp3 ); return NULL; }
+      ref( hi );
       deref( tmp2 ); deref( tmp3 );
       #else /* Bruno's implementation */
-      DdNode* tmp0 = union_( cuddE( g ), cuddT( g ) ); ref( tmp0 );
-      DdNode* tmp1 = join( cuddT( f ), tmp0 ); ref( tmp1 );
+      DdNode* tmp0 = union_( cuddE( g ), cuddT( g ) );
+      if ( tmp0 == NULL ) { return NULL; }
+      ref( tmp0 );
+      DdNode* tmp1 = join( cuddT( f ), tmp0 );
+      if ( tmp1 == NULL ) { deref( tmp0 ); return NULL; }
+      ref( tmp1 );
       deref( tmp0 );
-      DdNode* tmp2 = join( cuddE( f ), cuddT( g ) ); ref( tmp2 );
-      hi = union_( tmp1, tmp2 ); ref( hi );
+      DdNode* tmp2 = join( cuddE( f ), cuddT( g ) );
+      if ( tmp2 == NULL ) { deref( tmp1 ); return NULL; }
+      ref( tmp2 );
+      hi = union_( tmp1, tmp2 );
+      if ( hi == NULL ) { deref( tmp1 ); deref( tmp2 ); return NULL; }
+      ref( hi );
       deref( tmp1 ); deref( tmp2 );
       #endif
-      lo = join( cuddE( f ), cuddE( g ) ); ref( lo );
+      lo = join( cuddE( f ), cuddE( g ) );
+      if ( lo == NULL ) { deref( hi ); return NULL; }
+      ref( lo );
     }
     auto r = unique( var, lo, hi );
-    deref( lo ); deref( hi );
+    if ( r == NULL ) { deref( lo ); deref( hi ); return NULL; }
+    cuddDeref( lo ); cuddDeref( hi );
     
     cache_insert( cudd.getManager(), join_, f, g, r );
     return r;
@@ -280,7 +614,7 @@ private: /* implementation details */
     if ( g == e ) { return f; }
     if ( f == e || g == b || f == g ) { return e; }
 
-    if ( Cudd_NodeReadIndex( f ) > Cudd_NodeReadIndex( g ) )
+    if ( level( f ) > level( g ) )
       { return nonsupersets( f, cuddE( g ) ); }
 
     /* cache lookup */
@@ -290,21 +624,34 @@ private: /* implementation details */
     /* recursive computation */
     DdNode* lo = 0;
     DdNode* hi = 0;
-    if ( Cudd_NodeReadIndex( f ) < Cudd_NodeReadIndex( g ) )
+    if ( level( f ) < level( g ) )
     {
-      lo = nonsupersets( cuddE( f ), g ); ref( lo );
-      hi = nonsupersets( cuddT( f ), g ); ref( hi );
+      lo = nonsupersets( cuddE( f ), g );
+      if ( lo == NULL ) { return NULL; }
+      ref( lo );
+      hi = nonsupersets( cuddT( f ), g );
+      if ( hi == NULL ) { deref( lo ); return NULL; }
+      ref( hi );
     }
     else /* f_var == g_var */
     {
-      DdNode* tmp0 = nonsupersets( cuddT( f ), cuddT( g ) ); ref( tmp0 );
-      DdNode* tmp1 = nonsupersets( cuddT( f ), cuddE( g ) ); ref( tmp1 );
-      hi = intersection( tmp0, tmp1 ); ref( hi );
+      DdNode* tmp0 = nonsupersets( cuddT( f ), cuddT( g ) );
+      if ( tmp0 == NULL ) { return NULL; }
+      ref( tmp0 );
+      DdNode* tmp1 = nonsupersets( cuddT( f ), cuddE( g ) );
+      if ( tmp1 == NULL ) { deref( tmp0 ); return NULL; }
+      ref( tmp1 );
+      hi = intersection( tmp0, tmp1 );
+      if ( hi == NULL ) { deref( tmp0 ); deref( tmp1 ); return NULL; }
+      ref( hi );
       deref( tmp0 ); deref( tmp1 );
-      lo = nonsupersets( cuddE( f ), cuddE( g ) ); ref( lo );
+      lo = nonsupersets( cuddE( f ), cuddE( g ) );
+      if ( lo == NULL ) { deref( hi ); return NULL; }
+      ref( lo );
     }
     auto r = unique( Cudd_NodeReadIndex( f ), lo, hi );
-    //deref( lo ); deref( hi );
+    if ( r == NULL ) { deref( lo ); deref( hi ); return NULL; }
+    cuddDeref( lo ); cuddDeref( hi );
     
     cache_insert( cudd.getManager(), nonsupersets_, f, g, r );
     return r;
@@ -312,7 +659,7 @@ private: /* implementation details */
 
   DdNode* choose( DdNode* f, uint64_t k )
   {
-    if ( Cudd_NodeReadIndex( f ) >= num_variables )
+    if ( Cudd_NodeReadIndex( f ) >= num_vars )
     {
       return k > 0 ? empty.getNode() : base.getNode();
     }
@@ -324,15 +671,217 @@ private: /* implementation details */
     if ( res != NULL ) { return res; }
 
     /* k > 0 */
-    DdNode* n = choose( cuddE( f ), k ); ref( n ); /* don't take this var */
-    DdNode* tmp = choose( cuddE( f ), k - 1 ); ref( tmp ); /* take this var */
+    DdNode* n = choose( cuddE( f ), k ); /* don't take this var */
+    if ( n == NULL ) { return NULL; }
+    ref( n );
+    DdNode* tmp = choose( cuddE( f ), k - 1 ); /* take this var */
+    if ( tmp == NULL ) { deref( n ); return NULL; }
+    ref( tmp );
     auto r = unique( Cudd_NodeReadIndex( f ), n, tmp );
-    deref( n ); deref( tmp );
+    if ( r == NULL ) { deref( n ); deref( tmp ); return NULL; }
+    cuddDeref( n ); cuddDeref( tmp );
 
     cache_insert( cudd.getManager(), choose_ + k * 2, f, f, r );
     return r;
   }
 
+  DdNode* maximal( DdNode* f )
+  {
+    /* terminal cases */
+    if ( cuddIsConstant( f ) ) { return f; }
+
+    /* cache lookup */
+    auto res = cache_lookup( cudd.getManager(), maximal_, f, f );
+    if ( res != NULL ) { return res; }
+
+    DdNode* hi = maximal( cuddT( f ) );
+    if ( hi == NULL ) { return NULL; }
+    ref( hi );
+    DdNode* tmp = maximal( cuddE( f ) );
+    if ( tmp == NULL ) { deref( hi ); return NULL; }
+    ref( tmp );
+    DdNode* lo = nonsubsets( tmp, hi );
+    if ( lo == NULL ) { deref( hi ); deref( tmp ); return NULL; }
+    ref( lo );
+    deref( tmp );
+    auto r = unique( Cudd_NodeReadIndex( f ), lo, hi );
+    if ( r == NULL ) { deref( lo ); deref( hi ); return NULL; }
+    cuddDeref( lo ); cuddDeref( hi );
+
+    cache_insert( cudd.getManager(), maximal_, f, f, r );
+    return r;
+  }
+
+  DdNode* meet( DdNode* f, DdNode* g )
+  {
+    /* terminal cases */
+    DdNode* e = empty.getNode();
+    DdNode* b = base.getNode();
+    if ( f == e || g == e ) { return e; }
+    if ( f == b || g == b ) { return b; }
+
+    if ( f > g ) { std::swap( f, g ); }
+
+    /* cache lookup */
+    auto res = cache_lookup( cudd.getManager(), meet_, f, g );
+    if ( res != NULL ) { return res; }
+
+    DdNode* r = 0;
+    if ( level( f ) != level( g ) )
+    {
+      /* the top variable cannot be in the result */
+      if ( level( f ) > level( g ) ) { std::swap( f, g ); }
+      DdNode* tmp = union_( cuddE( f ), cuddT( f ) );
+      if ( tmp == NULL ) { return NULL; }
+      ref( tmp );
+      r = meet( tmp, g );
+      if ( r == NULL ) { deref( tmp ); return NULL; }
+      ref( r );
+      deref( tmp );
+      cuddDeref( r );
+      if ( f > g ) { std::swap( f, g ); }
+    }
+    else /* f_var == g_var */
+    {
+      DdNode* hi = meet( cuddT( f ), cuddT( g ) );
+      if ( hi == NULL ) { return NULL; }
+      ref( hi );
+      DdNode* tmp0 = union_( cuddE( f ), cuddT( f ) );
+      if ( tmp0 == NULL ) { deref( hi ); return NULL; }
+      ref( tmp0 );
+      DdNode* tmp1 = meet( tmp0, cuddE( g ) );
+      if ( tmp1 == NULL ) { deref( hi ); deref( tmp0 ); return NULL; }
+      ref( tmp1 );
+      deref( tmp0 );
+      DdNode* tmp2 = meet( cuddE( f ), cuddT( g ) );
+      if ( tmp2 == NULL ) { deref( hi ); deref( tmp1 ); return NULL; }
+      ref( tmp2 );
+      DdNode* lo = union_( tmp1, tmp2 );
+      if ( lo == NULL ) { deref( hi ); deref( tmp1 ); deref( tmp2 ); return NULL; }
+      ref( lo );
+      deref( tmp1 ); deref( tmp2 );
+      r = unique( Cudd_NodeReadIndex( f ), lo, hi );
+      if ( r == NULL ) { deref( lo ); deref( hi ); return NULL; }
+      cuddDeref( lo ); cuddDeref( hi );
+    }
+
+    cache_insert( cudd.getManager(), meet_, f, g, r );
+    return r;
+  }
+
+  DdNode* nonsubsets( DdNode* f, DdNode* g )
+  {
+    /* terminal cases */
+    DdNode* e = empty.getNode();
+    DdNode* b = base.getNode();
+    if ( g == e ) { return f; }
+    if ( f == e || f == b || f == g ) { return e; }
+
+    /* cache lookup */
+    auto res = cache_lookup( cudd.getManager(), nonsubsets_, f, g );
+    if ( res != NULL ) { return res; }
+
+    DdNode* r = 0;
+    if ( level( f ) > level( g ) )
+    {
+      /* the top variable of g is not in any set of f */
+      DdNode* tmp = union_( cuddE( g ), cuddT( g ) );
+      if ( tmp == NULL ) { return NULL; }
+      ref( tmp );
+      r = nonsubsets( f, tmp );
+      if ( r == NULL ) { deref( tmp ); return NULL; }
+      ref( r );
+      deref( tmp );
+      cuddDeref( r );
+    }
+    else
+    {
+      DdNode* lo = 0;
+      DdNode* hi = 0;
+      if ( level( f ) < level( g ) )
+      {
+        lo = nonsubsets( cuddE( f ), g );
+        if ( lo == NULL ) { return NULL; }
+        ref( lo );
+        hi = ref( cuddT( f ) );
+      }
+      else /* f_var == g_var */
+      {
+        DdNode* tmp0 = nonsubsets( cuddE( f ), cuddT( g ) );
+        if ( tmp0 == NULL ) { return NULL; }
+        ref( tmp0 );
+        DdNode* tmp1 = nonsubsets( cuddE( f ), cuddE( g ) );
+        if ( tmp1 == NULL ) { deref( tmp0 ); return NULL; }
+        ref( tmp1 );
+        lo = intersection( tmp0, tmp1 );
+        if ( lo == NULL ) { deref( tmp0 ); deref( tmp1 ); return NULL; }
+        ref( lo );
+        deref( tmp0 ); deref( tmp1 );
+        hi = nonsubsets( cuddT( f ), cuddT( g ) );
+        if ( hi == NULL ) { deref( lo ); return NULL; }
+        ref( hi );
+      }
+      r = unique( Cudd_NodeReadIndex( f ), lo, hi );
+      if ( r == NULL ) { deref( lo ); deref( hi ); return NULL; }
+      cuddDeref( lo ); cuddDeref( hi );
+    }
+
+    cache_insert( cudd.getManager(), nonsubsets_, f, g, r );
+    return r;
+  }
+
+  DdNode* edivide( DdNode* f, DdNode* g )
+  {
+    /* terminal cases */
+    DdNode* e = empty.getNode();
+    DdNode* b = base.getNode();
+    if ( g == b ) { return f; }
+    if ( g == e || f == e || f == b ) { return e; }
+    if ( f == g ) { return b; }
+
+    /* the top variable of g is in some set of g, but in no set of f */
+    if ( level( f ) > level( g ) ) { return e; }
+
+    /* cache lookup */
+    auto res = cache_lookup( cudd.getManager(), edivide_, f, g );
+    if ( res != NULL ) { return res; }
+
+    DdNode* r = 0;
+    if ( level( f ) < level( g ) )
+    {
+      DdNode* lo = edivide( cuddE( f ), g );
+      if ( lo == NULL ) { return NULL; }
+      ref( lo );
+      DdNode* hi = edivide( cuddT( f ), g );
+      if ( hi == NULL ) { deref( lo ); return NULL; }
+      ref( hi );
+      r = unique( Cudd_NodeReadIndex( f ), lo, hi );
+      if ( r == NULL ) { deref( lo ); deref( hi ); return NULL; }
+      cuddDeref( lo ); cuddDeref( hi );
+    }
+    else /* f_var == g_var, the quotient does not contain this variable */
+    {
+      r = edivide( cuddT( f ), cuddT( g ) );
+      if ( r == NULL ) { return NULL; }
+      ref( r );
+      if ( cuddE( g ) != e && r != e )
+      {
+        DdNode* tmp0 = edivide( cuddE( f ), cuddE( g ) );
+        if ( tmp0 == NULL ) { deref( r ); return NULL; }
+        ref( tmp0 );
+        DdNode* tmp1 = intersection( r, tmp0 );
+        if ( tmp1 == NULL ) { deref( r ); deref( tmp0 ); return NULL; }
+        ref( tmp1 );
+        deref( r ); deref( tmp0 );
+        r = tmp1;
+      }
+      cuddDeref( r );
+    }
+
+    cache_insert( cudd.getManager(), edivide_, f, g, r );
+    return r;
+  }
+
 private: /* iterator, counting, etc */
   template<class Fn>
   bool foreach_set_rec( DdNode* f, std::vector<uint32_t>& set, Fn&& fn ) const
@@ -402,18 +951,22 @@ public:
   /* \!brief Return the number of sets in a ZDD. */
   uint64_t count_sets( ZDD const& f ) const
   {
-    if ( f.getNode() == base.getNode() )
+    /* CUDD's count is exact as long as it fits into the mantissa, since all partial counts are smaller */
+    auto const count = count_sets_double( f );
+    if ( count < 9007199254740992.0 /* 2^53 */ )
     {
-      return 1;
-    }
-    if ( f.getNode() == empty.getNode() )
-    {
-      return 0;
+      return static_cast<uint64_t>( count );
     }
     std::unordered_map<DdNode*, uint64_t> visited;
     return count_sets_rec( f.getNode(), visited );
   }
 
+  /* \!brief Return the number of sets in a ZDD as a floating-point number (for very large families). */
+  double count_sets_double( ZDD const& f ) const
+  {
+    return Cudd_zddCountDouble( cudd.getManager(), f.getNode() );
+  }
+
   std::vector<std::vector<uint32_t>> sets_as_vectors( ZDD const& f ) const
   {
     std::vector<std::vector<uint32_t>> sets_vectors;
@@ -425,6 +978,19 @@ public:
   }
 
 private: /* operation cache */
+  bill::zdd_operation operation( uint64_t op ) const
+  {
+    if ( op == join_ ) { return bill::zdd_operation::join; }
+    if ( op == nonsupersets_ ) { return bill::zdd_operation::nonsupersets; }
+    if ( op == maximal_ ) { return bill::zdd_operation::maximal; }
+    if ( op == meet_ ) { return bill::zdd_operation::meet; }
+    if ( op == nonsubsets_ ) { return bill::zdd_operation::nonsubsets; }
+    if ( op == edivide_ ) { return bill::zdd_operation::edivide; }
+    assert( op > choose_ && op % 2 == 0 );
+    return bill::zdd_operation::choose;
+  }
+
+
   DdNode * cache_lookup( DdManager * table, uint64_t op, DdNode * f, DdNode * g )
   {
     int posn;
@@ -438,6 +1004,10 @@ private: /* operation cache */
       }
     #endif
 
+    auto& counters = operation_counters[uint32_t( operation( op ) )];
+    ++counters.calls;
+    ++counters.cache_lookups;
+
     posn = ddCHash2(op,f,g,table->cacheShift);
     en = &cache[posn];
     if (en->data != NULL && en->f==f && en->g==g && en->h==(ptruint)op) {
@@ -451,6 +1021,7 @@ private: /* operation cache */
 
     /* Cache miss: decide whether to resize. */
     table->cacheMisses++;
+    ++counters.cache_misses;
 
     if (table->cacheSlack >= 0 && table->cacheHits > table->cacheMisses * table->minHit) {
       cuddCacheResize(table);
@@ -483,11 +1054,15 @@ private: /* operation cache */
 
 private:
   Cudd cudd; /* the CUDD manager */
-  uint32_t num_variables;
+  uint32_t num_vars;
   ZDD empty; /* the empty family {} (minterms: none; constant 0) */
   ZDD base; /* the unit family {{}} (minterms: the all-zero cube) */
   std::vector<ZDD> elementaries; /* the single-set family of the single-element set {{i}} (minterms: 0...010...0) */
   std::vector<ZDD> tautologies; /* every combinations of variables >= var (minterms: 0...0-...-) */
+  uint32_t num_reorderings = 0; /* number of reorderings when `tautologies` were built */
+  std::array<bill::zdd_operation_stats, uint32_t( bill::zdd_operation::num_operations )> operation_counters;
+  bill::zdd_stats baseline; /* CUDD's counters at the last `reset_stats` */
+  mutable uint64_t peak_memory = 0;
 };
 
 } // namespace cudd
\ No newline at end of file
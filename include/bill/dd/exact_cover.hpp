@@ -0,0 +1,119 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "frontier.hpp"
+#include "zdd.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace bill {
+
+namespace detail {
+
+/* One bit per item on the frontier, telling whether it is already covered.  Option `i` is
+ * variable `i` of the frontier, which touches the items of the option. */
+class exact_cover_spec {
+public:
+	exact_cover_spec(element_frontier const& frontier,
+	                 std::vector<std::vector<uint32_t>> const& options,
+	                 uint32_t num_secondary_items)
+	    : frontier_(frontier)
+	    , options_(options)
+	    , num_primary_items_(frontier.num_elements() - num_secondary_items)
+	    , covered_(frontier.num_elements())
+	{}
+
+	/* Some primary item is not contained in any option */
+	bool is_uncoverable() const
+	{
+		for (auto item = 0u; item < num_primary_items_; ++item) {
+			if (!frontier_.is_covered(item)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	frontier_result operator()(frontier_state& state, uint32_t var, bool take)
+	{
+		frontier_.load(state, var, covered_);
+		for (auto const item : frontier_.entering(var)) {
+			covered_.at(item) = 0u;
+		}
+
+		if (take) {
+			for (auto const item : options_.at(var)) {
+				if (covered_.at(item)) {
+					return frontier_result::reject;
+				}
+				covered_.at(item) = 1u;
+			}
+		}
+
+		for (auto const item : frontier_.leaving(var)) {
+			if (is_primary(item) && !covered_.at(item)) {
+				return frontier_result::reject;
+			}
+		}
+		if (frontier_.is_last(var)) {
+			return frontier_result::accept;
+		}
+		frontier_.store(state, var, covered_);
+		return frontier_result::proceed;
+	}
+
+private:
+	bool is_primary(uint32_t item) const
+	{
+		return item < num_primary_items_;
+	}
+
+private:
+	element_frontier const& frontier_;
+	std::vector<std::vector<uint32_t>> const& options_;
+	uint32_t num_primary_items_;
+	std::vector<uint32_t> covered_;
+};
+
+} // namespace detail
+
+/*! \brief Computes the family of all exact covers.
+ *
+ * Given items `0` to `num_items - 1` and a list of options (each option is a subset of the
+ * items), an exact cover is a set of options that contains every *primary* item exactly once
+ * and every *secondary* item at most once.  The last `num_secondary_items` items are
+ * secondary (as in Knuth's Algorithm X).  Option `i` corresponds to ZDD variable `i`.
+ *
+ * The ZDD is compiled in one top-down pass over the options, merging partial covers which
+ * agree on the items that are still shared with later options.  The family can then be
+ * counted with `count_sets` and enumerated with `foreach_set`.  Placing options that share
+ * items next to each other keeps the frontier (and hence the number of states) small.
+ *
+ * \param zdd ZDD base with at least `options.size()` variables
+ * \param num_items Number of items
+ * \param options List of options
+ * \param num_secondary_items Number of secondary items (default: 0)
+ * \return Referenced root of the family of exact covers
+ */
+inline zdd_base::node_index exact_covers(zdd_base& zdd, uint32_t num_items,
+                                         std::vector<std::vector<uint32_t>> const& options,
+                                         uint32_t num_secondary_items = 0u)
+{
+	assert(num_secondary_items <= num_items);
+	element_frontier const frontier(num_items, options, decision_order(zdd, options.size()));
+	detail::exact_cover_spec spec(frontier, options, num_secondary_items);
+	if (spec.is_uncoverable()) {
+		return zdd.ref(zdd.bottom());
+	}
+	if (options.empty()) {
+		return zdd.ref(zdd.top());
+	}
+	return frontier_construct(zdd, options.size(), {}, spec);
+}
+
+} // namespace bill
@@ -0,0 +1,367 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "zdd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+/*! \brief State of a frontier-based construction.
+ *
+ * A state is a small vector of integers, which only describes the part of the problem that
+ * is still relevant for the remaining decisions (the "frontier").  Two states that are equal
+ * lead to the same sub-family and are therefore merged into one ZDD node.
+ */
+using frontier_state = std::vector<uint32_t>;
+
+/*! \brief Outcome of a single decision during a frontier-based construction. */
+enum class frontier_result : int8_t {
+	reject = -1,  /*!< The partial set cannot be extended into a member of the family */
+	proceed = 0,  /*!< Decision is valid, continue with the modified state */
+	accept = 1,   /*!< Partial set is a member of the family, all remaining variables are 0 */
+};
+
+namespace detail {
+
+struct frontier_state_hash {
+	std::size_t operator()(frontier_state const& state) const
+	{
+		std::size_t seed = state.size();
+		for (auto const value : state) {
+			std::hash_combine(seed, value);
+		}
+		return seed;
+	}
+};
+
+} // namespace detail
+
+/*! \brief Returns the variables `0` to `num_levels - 1` of `zdd` in the order of their levels.
+ *
+ * This is the order in which `frontier_construct` decides them.  With the identity order of
+ * `zdd`, variable `i` is decided at step `i`.
+ */
+inline std::vector<uint32_t> decision_order(zdd_base const& zdd, uint32_t num_levels)
+{
+	assert(num_levels <= zdd.num_variables());
+	std::vector<uint32_t> order(num_levels);
+	for (auto var = 0u; var < num_levels; ++var) {
+		order.at(var) = var;
+	}
+	std::sort(order.begin(), order.end(),
+	          [&](uint32_t a, uint32_t b) { return zdd.level(a) < zdd.level(b); });
+	return order;
+}
+
+/*! \brief Builds a ZDD top-down by exploring the states of a frontier-based specification.
+ *
+ * Variables `0` to `num_levels - 1` are decided one per step, in the order of their levels
+ * in `zdd` (see `decision_order`).  For each step, and each distinct state reached at this
+ * step, `fn(state, var, take)` is called twice with the variable `var` of this step: once
+ * with `take == false` and once with `take == true`.  The function may modify the state
+ * (which is a copy) to describe the state at the next step, and returns a `frontier_result`.
+ * A state which proceeds beyond the last step is rejected, i.e., specifications must accept
+ * explicitly.
+ *
+ * Once all states are known, the ZDD is built bottom-up using `zdd_base::unique`.  Equal
+ * states are merged on the fly (like Knuth's SIMPATH or Minato's frontier-based search), so
+ * the construction is linear in the number of distinct states rather than in the number of
+ * sets of the resulting family.
+ *
+ * \param zdd ZDD base in which the family is built (must have at least `num_levels` variables)
+ * \param num_levels Number of variables to decide
+ * \param root Initial state
+ * \param fn Transition function
+ * \return Referenced root of the constructed family, or `zdd.aborted()` if the construction
+ *         exceeded the node or memory limit of `zdd`
+ */
+template<class Fn>
+zdd_base::node_index frontier_construct(zdd_base& zdd, uint32_t num_levels,
+                                        frontier_state const& root, Fn&& fn)
+{
+	assert(num_levels <= zdd.num_variables());
+	using state_table = std::unordered_map<frontier_state, uint32_t,
+	                                       detail::frontier_state_hash>;
+
+	/* Children of the states at each step: 0 is bottom, 1 is top, and any other value `i`
+	 * refers to the (i - 2)-th state of the next step. */
+	std::vector<std::vector<std::pair<uint32_t, uint32_t>>> children(num_levels);
+
+	if (num_levels == 0u) {
+		return zdd.ref(zdd.bottom());
+	}
+
+	/* Top-down: enumerate distinct states step by step */
+	auto const order = decision_order(zdd, num_levels);
+	std::vector<frontier_state> current = {root};
+	for (auto step = 0u; step < num_levels; ++step) {
+		auto const var = order.at(step);
+		std::vector<frontier_state> next;
+		state_table next_table;
+		auto const is_last = (step + 1u == num_levels);
+		auto const decide = [&](frontier_state state, bool take) -> uint32_t {
+			switch (fn(state, var, take)) {
+			case frontier_result::accept:
+				return 1u;
+			case frontier_result::proceed:
+				if (is_last) {
+					return 0u;
+				} else {
+					auto const [it, inserted] = next_table.emplace(std::move(state),
+					                                               next.size());
+					if (inserted) {
+						next.emplace_back(it->first);
+					}
+					return it->second + 2u;
+				}
+			case frontier_result::reject:
+			default:
+				return 0u;
+			}
+		};
+
+		children.at(step).reserve(current.size());
+		for (auto const& state : current) {
+			auto const lo = decide(state, false);
+			auto const hi = decide(state, true);
+			children.at(step).emplace_back(lo, hi);
+		}
+		current = std::move(next);
+	}
+
+	/* Bottom-up: create ZDD nodes, each entry of `nodes` owns one reference */
+	std::vector<zdd_base::node_index> nodes;
+	for (int32_t step = num_levels - 1; step >= 0; --step) {
+		auto const resolve = [&](uint32_t child) {
+			if (child == 0u) {
+				return zdd.ref(zdd.bottom());
+			}
+			if (child == 1u) {
+				return zdd.ref(zdd.top());
+			}
+			return zdd.ref(nodes.at(child - 2u));
+		};
+
+		std::vector<zdd_base::node_index> level_nodes;
+		level_nodes.reserve(children.at(step).size());
+		for (auto const& [lo, hi] : children.at(step)) {
+			auto const index_lo = resolve(lo);
+			auto const index_hi = resolve(hi);
+			auto const index = zdd.unique(order.at(step), index_lo, index_hi);
+			if (index == zdd.aborted()) {
+				for (auto const owned : level_nodes) {
+					zdd.deref(owned);
+				}
+				for (auto const owned : nodes) {
+					zdd.deref(owned);
+				}
+				return zdd.aborted();
+			}
+			level_nodes.emplace_back(index);
+		}
+		for (auto const index : nodes) {
+			zdd.deref(index);
+		}
+		nodes = std::move(level_nodes);
+		children.at(step).clear();
+		children.at(step).shrink_to_fit();
+	}
+	assert(nodes.size() == 1u);
+	return nodes.front();
+}
+
+/*! \brief Bookkeeping of element frontiers for step-by-step constructions.
+ *
+ * Variable `i` touches the elements of `incidences[i]`, and the variables are decided in the
+ * order given by `order` (default: `0`, `1`, ...), as `frontier_construct` does with the
+ * `decision_order` of its ZDD base.  An element *enters* at the first variable that touches
+ * it and *leaves* after the last one.  The frontier before deciding a variable contains all
+ * elements that entered before it and have not left yet.  States only store per-element data
+ * for the elements on the frontier, in increasing order.  All accessors take variables.
+ */
+class element_frontier {
+public:
+	element_frontier(uint32_t num_elements, std::vector<std::vector<uint32_t>> const& incidences,
+	                 std::vector<uint32_t> const& order = {})
+	    : num_elements_(num_elements)
+	    , steps_(incidences.size())
+	    , frontiers_(incidences.size() + 1u)
+	    , entering_(incidences.size())
+	    , leaving_(incidences.size())
+	    , covered_(num_elements, false)
+	{
+		assert(order.empty() || order.size() == incidences.size());
+		for (auto step = 0u; step < steps_.size(); ++step) {
+			steps_.at(order.empty() ? step : order.at(step)) = step;
+		}
+		std::vector<int32_t> first(num_elements, -1);
+		std::vector<int32_t> last(num_elements, -1);
+		for (auto step = 0u; step < incidences.size(); ++step) {
+			auto const var = order.empty() ? step : order.at(step);
+			for (auto const v : incidences.at(var)) {
+				assert(v < num_elements);
+				if (first.at(v) == -1) {
+					first.at(v) = step;
+				}
+				last.at(v) = step;
+			}
+		}
+		for (auto v = 0u; v < num_elements; ++v) {
+			if (first.at(v) == -1) {
+				continue;
+			}
+			covered_.at(v) = true;
+			entering_.at(first.at(v)).emplace_back(v);
+			leaving_.at(last.at(v)).emplace_back(v);
+			for (auto i = first.at(v) + 1; i <= last.at(v); ++i) {
+				frontiers_.at(i).emplace_back(v);
+			}
+		}
+	}
+
+	/*! \brief Number of elements */
+	uint32_t num_elements() const
+	{
+		return num_elements_;
+	}
+
+	/*! \brief Number of variables (and steps) */
+	uint32_t num_levels() const
+	{
+		return steps_.size();
+	}
+
+	/*! \brief Returns whether `var` is decided last */
+	bool is_last(uint32_t var) const
+	{
+		return steps_.at(var) + 1u == steps_.size();
+	}
+
+	/*! \brief Elements on the frontier before deciding `var` */
+	std::vector<uint32_t> const& frontier(uint32_t var) const
+	{
+		return frontiers_.at(steps_.at(var));
+	}
+
+	/*! \brief Elements on the frontier after deciding `var` */
+	std::vector<uint32_t> const& next_frontier(uint32_t var) const
+	{
+		return frontiers_.at(steps_.at(var) + 1u);
+	}
+
+	/*! \brief Elements whose first variable is `var` */
+	std::vector<uint32_t> const& entering(uint32_t var) const
+	{
+		return entering_.at(steps_.at(var));
+	}
+
+	/*! \brief Elements whose last variable is `var` */
+	std::vector<uint32_t> const& leaving(uint32_t var) const
+	{
+		return leaving_.at(steps_.at(var));
+	}
+
+	/*! \brief Returns whether element `v` is touched by at least one variable */
+	bool is_covered(uint32_t v) const
+	{
+		return covered_.at(v);
+	}
+
+	/*! \brief Returns the maximum frontier size, which bounds the state size */
+	uint32_t width() const
+	{
+		uint32_t width = 0u;
+		for (auto const& elements : frontiers_) {
+			width = std::max<uint32_t>(width, elements.size());
+		}
+		return width;
+	}
+
+	/*! \brief Copies state values before deciding `var` into `data` (indexed by element) */
+	void load(frontier_state const& state, uint32_t var, std::vector<uint32_t>& data) const
+	{
+		auto const& elements = frontier(var);
+		assert(state.size() == elements.size());
+		for (auto i = 0u; i < elements.size(); ++i) {
+			data.at(elements.at(i)) = state.at(i);
+		}
+	}
+
+	/*! \brief Stores values from `data` for the frontier after deciding `var` */
+	void store(frontier_state& state, uint32_t var, std::vector<uint32_t> const& data) const
+	{
+		auto const& elements = next_frontier(var);
+		state.resize(elements.size());
+		for (auto i = 0u; i < elements.size(); ++i) {
+			state.at(i) = data.at(elements.at(i));
+		}
+	}
+
+private:
+	uint32_t num_elements_;
+	/* step at which each variable is decided */
+	std::vector<uint32_t> steps_;
+	/* by step */
+	std::vector<std::vector<uint32_t>> frontiers_;
+	std::vector<std::vector<uint32_t>> entering_;
+	std::vector<std::vector<uint32_t>> leaving_;
+	std::vector<bool> covered_;
+};
+
+/*! \brief Bookkeeping of vertex frontiers for edge-by-edge graph constructions.
+ *
+ * Edge `i` of the edge list corresponds to ZDD variable `i`, which touches the two end points
+ * of the edge.
+ */
+class graph_frontier : public element_frontier {
+public:
+	using edge_type = std::pair<uint32_t, uint32_t>;
+
+	graph_frontier(uint32_t num_vertices, std::vector<edge_type> const& edges,
+	               std::vector<uint32_t> const& order = {})
+	    : element_frontier(num_vertices, end_points(edges), order)
+	    , edges_(edges)
+	{}
+
+	/*! \brief Number of vertices of the graph */
+	uint32_t num_vertices() const
+	{
+		return num_elements();
+	}
+
+	/*! \brief Number of edges (and levels) of the graph */
+	uint32_t num_edges() const
+	{
+		return edges_.size();
+	}
+
+	edge_type const& edge(uint32_t index) const
+	{
+		return edges_.at(index);
+	}
+
+private:
+	static std::vector<std::vector<uint32_t>> end_points(std::vector<edge_type> const& edges)
+	{
+		std::vector<std::vector<uint32_t>> incidences;
+		incidences.reserve(edges.size());
+		for (auto const& [u, v] : edges) {
+			incidences.push_back({u, v});
+		}
+		return incidences;
+	}
+
+private:
+	std::vector<edge_type> edges_;
+};
+
+} // namespace bill
@@ -0,0 +1,366 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "../utils/hash.hpp"
+#include "zdd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+/*! \brief A permutation decision diagram (πDD, Minato 2011).
+ *
+ * A πDD represents a family of permutations of `{0, ..., n - 1}`.  Every permutation `p` has a
+ * unique decomposition
+ *
+ *   p = t(n - 1) o t(n - 2) o ... o t(1)
+ *
+ * in which each `t(x)` is either the identity or the transposition `(x y)` of `x` with some
+ * `y < x`.  A permutation is hence a set of transpositions with at most one transposition per
+ * `x`, and a family of permutations is a ZDD over the `n (n - 1) / 2` transpositions.  The
+ * variable of `(x y)` is `x (x - 1) / 2 + y`, so that the root holds the transposition with the
+ * smallest `x`, which is the last one applied.
+ *
+ * The nodes live in a `zdd_base`, hence the unique table and the garbage collection are the
+ * ones of the ZDD, and union, intersection, difference and cardinality are the ZDD operations.
+ * Composition is implemented on top of them, with its own computed tables.  Entries of these
+ * tables hold references to their nodes, they are released by `clear_cache` and
+ * `collect_garbage`.
+ *
+ * Permutations are vectors of images, i.e., `p[i]` is the image of `i`, and `p o q` maps `i`
+ * to `p[q[i]]`.  At most 91 elements are supported; cardinalities overflow beyond 20.
+ * Resource limits (`zdd_base::set_limits`) are not supported.
+ */
+class pidd_base {
+public:
+	using node_index = zdd_base::node_index;
+	using permutation_type = std::vector<uint32_t>;
+
+	/* \!brief Creates a new πDD base.
+	 *
+	 * \param num_elements Number of permuted elements `n`
+	 * \param log_num_objs Log number of nodes to pre-allocate (default: 16)
+	 */
+	explicit pidd_base(uint32_t num_elements, uint32_t log_num_objs = 16)
+	    : num_elements_(num_elements)
+	    , zdd_(num_elements * (std::max(num_elements, 1u) - 1u) / 2u, log_num_objs)
+	{
+		assert(num_elements <= 91u);
+		for (auto x = 1u; x < num_elements; ++x) {
+			for (auto y = 0u; y < x; ++y) {
+				var_to_transposition_.emplace_back(x, y);
+			}
+		}
+	}
+
+	pidd_base(pidd_base const&) = delete;
+	pidd_base& operator=(pidd_base const&) = delete;
+
+	~pidd_base()
+	{
+		clear_cache();
+	}
+
+#pragma region πDD base properties
+	/*! \brief Returns the number of permuted elements. */
+	uint32_t num_elements() const
+	{
+		return num_elements_;
+	}
+
+	/*! \brief Returns the number of active nodes. */
+	uint32_t num_nodes() const
+	{
+		return zdd_.num_nodes();
+	}
+
+	/*! \brief Returns the ZDD base holding the nodes. */
+	zdd_base const& zdd() const
+	{
+		return zdd_;
+	}
+
+	/*! \brief Returns the ZDD variable of transposition `(x y)`, with `y < x`. */
+	uint32_t transposition_var(uint32_t x, uint32_t y) const
+	{
+		assert(y < x && x < num_elements_);
+		return x * (x - 1u) / 2u + y;
+	}
+
+	/*! \brief Returns the transposition `(x y)` of a ZDD variable. */
+	std::pair<uint32_t, uint32_t> transposition_of(uint32_t var) const
+	{
+		return var_to_transposition_.at(var);
+	}
+#pragma endregion
+
+#pragma region Constants
+	/*! \brief Returns the node index corresponding to the empty family */
+	node_index bottom() const
+	{
+		return zdd_.bottom();
+	}
+
+	/*! \brief Returns the node index corresponding to the family `{identity}` */
+	node_index top() const
+	{
+		return zdd_.top();
+	}
+
+	/*! \brief Returns the family `{(x y)}` of one transposition (not referenced). */
+	node_index transposition(uint32_t x, uint32_t y)
+	{
+		if (x < y) {
+			std::swap(x, y);
+		}
+		return zdd_.elementary(transposition_var(x, y));
+	}
+
+	/*! \brief Returns the family `{p}` of one permutation. */
+	node_index permutation(permutation_type const& p)
+	{
+		assert(p.size() == num_elements_);
+		/* selection sort from the last position: find the value of `p[x]` among the positions
+		 * up to `x` of the current arrangement and swap it into position `x` */
+		permutation_type current(num_elements_);
+		permutation_type position(num_elements_);
+		for (auto i = 0u; i < num_elements_; ++i) {
+			current.at(i) = i;
+			position.at(i) = i;
+		}
+		std::vector<uint32_t> vars;
+		for (auto x = num_elements_; x-- > 1u;) {
+			auto const y = position.at(p.at(x));
+			assert(y <= x);
+			if (y == x) {
+				continue;
+			}
+			vars.emplace_back(transposition_var(x, y));
+			std::swap(current.at(x), current.at(y));
+			position.at(current.at(x)) = x;
+			position.at(current.at(y)) = y;
+		}
+		/* the largest variable lies at the bottom */
+		node_index result = zdd_.ref(top());
+		for (auto const var : vars) {
+			result = zdd_.unique(var, zdd_.ref(bottom()), result);
+		}
+		return result;
+	}
+
+	/*! \brief Returns the family of all `n!` permutations. */
+	node_index symmetric_group()
+	{
+		node_index result = zdd_.ref(top());
+		for (auto x = num_elements_; x-- > 1u;) {
+			/* t(x) is the identity or any (x y) */
+			zdd_.ref(result, x);
+			node_index choice = result;
+			for (auto y = x; y-- > 0u;) {
+				choice = zdd_.unique(transposition_var(x, y), choice, result);
+			}
+			result = choice;
+		}
+		return result;
+	}
+#pragma endregion
+
+#pragma region Family operations
+	/*! \brief Increase the reference count of a node. */
+	node_index ref(node_index index)
+	{
+		return zdd_.ref(index);
+	}
+
+	/*! \brief Decrease the reference count of a node. */
+	void deref(node_index index)
+	{
+		zdd_.deref(index);
+	}
+
+	/*! \brief Computes `f ∪ g`. */
+	node_index union_(node_index index_f, node_index index_g)
+	{
+		return zdd_.union_(index_f, index_g);
+	}
+
+	/*! \brief Computes `f ∩ g`. */
+	node_index intersection(node_index index_f, node_index index_g)
+	{
+		return zdd_.intersection(index_f, index_g);
+	}
+
+	/*! \brief Computes `f \ g`. */
+	node_index difference(node_index index_f, node_index index_g)
+	{
+		return zdd_.difference(index_f, index_g);
+	}
+
+	/*! \brief Computes `{p o (x y) | p ∈ f}`, i.e., swaps the images of `x` and `y`. */
+	node_index swap(node_index index_f, uint32_t x, uint32_t y)
+	{
+		assert(x != y);
+		if (x < y) {
+			std::swap(x, y);
+		}
+		if (index_f == bottom()) {
+			return zdd_.ref(bottom());
+		}
+		auto const var = transposition_var(x, y);
+		if (index_f == top()) {
+			return zdd_.unique(var, zdd_.ref(bottom()), zdd_.ref(top()));
+		}
+		/* the root holds the transposition with the smallest x, (x y) goes on top */
+		auto const [a, b] = transposition_of(zdd_.var(index_f));
+		if (a > x) {
+			return zdd_.unique(var, zdd_.ref(bottom()), zdd_.ref(index_f));
+		}
+
+		// Cache lookup
+		auto const it = swap_table_.find({index_f, var});
+		if (it != swap_table_.end()) {
+			return zdd_.ref(it->second);
+		}
+
+		/* f = f0 ∪ f1 o (a b), move (x y) in front of (a b) */
+		node_index const r_lo = swap(zdd_.lo(index_f), x, y);
+		node_index const index_f1 = zdd_.hi(index_f);
+		node_index r_hi;
+		if (a == x && b == y) {
+			r_hi = zdd_.ref(index_f1);
+		} else if (a == x) {
+			/* (x b) o (x y) = (x y) o (y b) */
+			node_index const temp = zdd_.unique(var, zdd_.ref(bottom()), zdd_.ref(index_f1));
+			r_hi = zdd_.unique(transposition_var(std::max(y, b), std::min(y, b)),
+			                   zdd_.ref(bottom()), temp);
+		} else {
+			node_index temp;
+			if (a == y) {
+				/* (y b) o (x y) = (x b) o (y b) */
+				temp = swap(index_f1, x, b);
+			} else if (b == y) {
+				/* (a y) o (x y) = (x a) o (a y) */
+				temp = swap(index_f1, x, a);
+			} else {
+				/* disjoint transpositions commute */
+				temp = swap(index_f1, x, y);
+			}
+			r_hi = swap(temp, a, b);
+			zdd_.deref(temp);
+		}
+		node_index const result = zdd_.union_(r_lo, r_hi);
+		zdd_.deref(r_lo);
+		zdd_.deref(r_hi);
+		/* entries own a reference to their operand and to their result */
+		swap_table_.emplace(std::make_pair(zdd_.ref(index_f), var), zdd_.ref(result));
+		return result;
+	}
+
+	/*! \brief Computes the composition `f o g = {p o q | p ∈ f, q ∈ g}`. */
+	node_index product(node_index index_f, node_index index_g)
+	{
+		if (index_f == bottom() || index_g == bottom()) {
+			return zdd_.ref(bottom());
+		}
+		if (index_g == top()) {
+			return zdd_.ref(index_f);
+		}
+		if (index_f == top()) {
+			return zdd_.ref(index_g);
+		}
+
+		// Cache lookup
+		auto const it = product_table_.find({index_f, index_g});
+		if (it != product_table_.end()) {
+			return zdd_.ref(it->second);
+		}
+
+		/* f o (g0 ∪ g1 o (a b)) = f o g0 ∪ (f o g1) o (a b) */
+		auto const [a, b] = transposition_of(zdd_.var(index_g));
+		node_index const r_lo = product(index_f, zdd_.lo(index_g));
+		node_index const temp = product(index_f, zdd_.hi(index_g));
+		node_index const r_hi = swap(temp, a, b);
+		zdd_.deref(temp);
+		node_index const result = zdd_.union_(r_lo, r_hi);
+		zdd_.deref(r_lo);
+		zdd_.deref(r_hi);
+		product_table_.emplace(std::make_pair(zdd_.ref(index_f), zdd_.ref(index_g)),
+		                       zdd_.ref(result));
+		return result;
+	}
+#pragma endregion
+
+#pragma region Properties and iterators
+	/*! \brief Returns the number of permutations of a family. */
+	uint64_t count_permutations(node_index index) const
+	{
+		return zdd_.count_sets(index);
+	}
+
+	/*! \brief Returns the number of nodes of a family. */
+	uint64_t count_nodes(node_index index) const
+	{
+		return zdd_.count_nodes(index);
+	}
+
+	/*! \brief Calls `fn` on each permutation of a family, until it returns false. */
+	template<class Fn>
+	void foreach_permutation(node_index index, Fn&& fn) const
+	{
+		zdd_.foreach_set(index, [&](std::vector<uint32_t> const& vars) {
+			permutation_type p(num_elements_);
+			for (auto i = 0u; i < num_elements_; ++i) {
+				p.at(i) = i;
+			}
+			/* the transpositions with larger x are applied first */
+			for (auto it = vars.rbegin(); it != vars.rend(); ++it) {
+				auto const [x, y] = transposition_of(*it);
+				std::swap(p.at(x), p.at(y));
+			}
+			return fn(p);
+		});
+	}
+#pragma endregion
+
+#pragma region Garbage collection
+	/*! \brief Releases the nodes held by the computed tables of the composition. */
+	void clear_cache()
+	{
+		for (auto const& [key, result] : swap_table_) {
+			zdd_.deref(key.first);
+			zdd_.deref(result);
+		}
+		for (auto const& [key, result] : product_table_) {
+			zdd_.deref(key.first);
+			zdd_.deref(key.second);
+			zdd_.deref(result);
+		}
+		swap_table_.clear();
+		product_table_.clear();
+	}
+
+	/*! \brief Clears the computed tables and recycles all the dead nodes. */
+	void collect_garbage()
+	{
+		clear_cache();
+		zdd_.collect_garbage();
+	}
+#pragma endregion
+
+private:
+	uint32_t num_elements_;
+	zdd_base zdd_;
+	std::vector<std::pair<uint32_t, uint32_t>> var_to_transposition_;
+	std::unordered_map<std::pair<uint32_t, uint32_t>, node_index> swap_table_;
+	std::unordered_map<std::pair<uint32_t, uint32_t>, node_index> product_table_;
+};
+
+} // namespace bill
@@ -0,0 +1,234 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "cudd_zdd.hpp"
+#include "zdd.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Draws random sets of a ZDD family.
+ *
+ * The family is copied into a flat array of nodes, together with the number of sets (or the
+ * total weight) below each node, in one pass over the ZDD.  Afterwards the ZDD may change or be
+ * garbage collected, and each sample walks down from the root in O(depth).
+ *
+ * Without weights, sets are drawn uniformly.  Counts are exact 64-bit integers unless the
+ * family has more than 2^64 - 1 sets, in which case they are kept as floating point numbers.
+ *
+ * With weights, a set `S` is drawn with probability proportional to the product of `w[v]` over
+ * the variables `v` of `S`; variables outside `S` contribute 1.  For instance, `w[v] = p / (1 -
+ * p)` draws from the family as if each variable was included with probability `p`, conditioned
+ * on the result being a set of the family.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      zdd_sampler sampler(zdd, family);
+      std::mt19937 rng(42);
+      auto const set = sampler.sample(rng);
+      auto const sets = sampler.sample(rng, 1000u);
+   \endverbatim
+ */
+class zdd_sampler {
+	struct node_type {
+		uint32_t var;
+		uint32_t lo;
+		uint32_t hi;
+	};
+
+public:
+	/*! \brief Prepares the sampling of a family of a `zdd_base`.
+	 *
+	 * \param zdd ZDD base
+	 * \param root Root of the family
+	 * \param weights Weight of each variable (empty for uniform sampling)
+	 */
+	zdd_sampler(zdd_base const& zdd, zdd_base::node_index root,
+	            std::vector<double> const& weights = {})
+	    : weights_(weights)
+	{
+		root_ = flatten(root, zdd.bottom(), zdd.top(), [&](zdd_base::node_index index) {
+			return std::make_tuple(zdd.var(index), zdd.lo(index), zdd.hi(index));
+		});
+		compute_counts();
+	}
+
+	/*! \brief Prepares the sampling of a family of a CUDD ZDD manager.
+	 *
+	 * \param zdd CUDD ZDD manager
+	 * \param root Root of the family
+	 * \param weights Weight of each variable (empty for uniform sampling)
+	 */
+	zdd_sampler(cudd::cudd_zdd& zdd, ZDD const& root, std::vector<double> const& weights = {})
+	    : weights_(weights)
+	{
+		root_ = flatten(root.getNode(), zdd.bottom().getNode(), zdd.top().getNode(),
+		                [&](DdNode* node) {
+			                return std::make_tuple(uint32_t(Cudd_NodeReadIndex(node)), cuddE(node),
+			                                       cuddT(node));
+		                });
+		compute_counts();
+	}
+
+#pragma region Properties
+	/*! \brief Returns true if the family has no set (or only sets of weight 0). */
+	bool empty() const
+	{
+		return exact_ ? counts_.at(root_) == 0u : weights_of_nodes_.at(root_) == 0.0;
+	}
+
+	/*! \brief Returns the number of sets, or the total weight, of the family. */
+	double total() const
+	{
+		return exact_ ? double(counts_.at(root_)) : weights_of_nodes_.at(root_);
+	}
+
+	/*! \brief Returns the number of nodes of the flattened family. */
+	uint32_t num_nodes() const
+	{
+		return nodes_.size() - 2u;
+	}
+#pragma endregion
+
+#pragma region Sampling
+	/*! \brief Draws one set into `set`, whose previous contents are discarded.
+	 *
+	 * The variables of the set are in the order of the levels.  The family must not be empty.
+	 */
+	template<class RNG>
+	void sample_into(RNG& rng, std::vector<uint32_t>& set) const
+	{
+		assert(!empty());
+		set.clear();
+		auto index = root_;
+		if (exact_) {
+			/* one draw, then follow the interval of the drawn rank */
+			auto rank = std::uniform_int_distribution<uint64_t>(0u, counts_.at(index) - 1u)(rng);
+			while (index > 1u) {
+				auto const& node = nodes_.at(index);
+				if (rank < counts_.at(node.lo)) {
+					index = node.lo;
+				} else {
+					rank -= counts_.at(node.lo);
+					set.emplace_back(node.var);
+					index = node.hi;
+				}
+			}
+		} else {
+			std::uniform_real_distribution<double> dist(0.0, 1.0);
+			while (index > 1u) {
+				auto const& node = nodes_.at(index);
+				if (dist(rng) * weights_of_nodes_.at(index) < weights_of_nodes_.at(node.lo)) {
+					index = node.lo;
+				} else {
+					set.emplace_back(node.var);
+					index = node.hi;
+				}
+			}
+		}
+		assert(index == 1u);
+	}
+
+	/*! \brief Draws one set. */
+	template<class RNG>
+	std::vector<uint32_t> sample(RNG& rng) const
+	{
+		std::vector<uint32_t> set;
+		sample_into(rng, set);
+		return set;
+	}
+
+	/*! \brief Draws `num_samples` independent sets. */
+	template<class RNG>
+	std::vector<std::vector<uint32_t>> sample(RNG& rng, uint32_t num_samples) const
+	{
+		std::vector<std::vector<uint32_t>> sets(num_samples);
+		for (auto& set : sets) {
+			sample_into(rng, set);
+		}
+		return sets;
+	}
+#pragma endregion
+
+private:
+	/* Copies the ZDD below `root` in post order, index 0 is bottom and index 1 is top */
+	template<class Node, class Expand>
+	uint32_t flatten(Node root, Node bottom, Node top, Expand&& expand)
+	{
+		nodes_.assign(2u, node_type{0u, 0u, 0u});
+		std::unordered_map<Node, uint32_t> visited;
+		auto rec = [&](auto& self, Node node) -> uint32_t {
+			if (node == bottom || node == top) {
+				return node == top ? 1u : 0u;
+			}
+			if (auto const it = visited.find(node); it != visited.end()) {
+				return it->second;
+			}
+			auto const [var, lo, hi] = expand(node);
+			node_type const flat{var, self(self, lo), self(self, hi)};
+			auto const index = static_cast<uint32_t>(nodes_.size());
+			nodes_.push_back(flat);
+			visited.emplace(node, index);
+			return index;
+		};
+		return rec(rec, root);
+	}
+
+	/* Children precede their parents in `nodes_` */
+	void compute_counts()
+	{
+		exact_ = weights_.empty();
+		if (exact_) {
+			counts_.assign(nodes_.size(), 0u);
+			counts_.at(1u) = 1u;
+			for (auto index = 2u; index < nodes_.size(); ++index) {
+				auto const& node = nodes_.at(index);
+				auto const lo = counts_.at(node.lo);
+				auto const hi = counts_.at(node.hi);
+				if (lo > std::numeric_limits<uint64_t>::max() - hi) {
+					/* too many sets, fall back to floating point */
+					exact_ = false;
+					counts_.clear();
+					break;
+				}
+				counts_.at(index) = lo + hi;
+			}
+		}
+		if (exact_) {
+			return;
+		}
+		weights_of_nodes_.assign(nodes_.size(), 0.0);
+		weights_of_nodes_.at(1u) = 1.0;
+		for (auto index = 2u; index < nodes_.size(); ++index) {
+			auto const& node = nodes_.at(index);
+			auto const weight = weights_.empty() ? 1.0 : weights_.at(node.var);
+			assert(weight >= 0.0);
+			weights_of_nodes_.at(index) = weights_of_nodes_.at(node.lo) +
+			                              weight * weights_of_nodes_.at(node.hi);
+		}
+	}
+
+private:
+	std::vector<double> weights_;
+	std::vector<node_type> nodes_;
+	uint32_t root_ = 0u;
+	bool exact_ = true;
+	std::vector<uint64_t> counts_;
+	std::vector<double> weights_of_nodes_;
+};
+
+} // namespace bill
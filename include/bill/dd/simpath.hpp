@@ -0,0 +1,351 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "frontier.hpp"
+#include "zdd.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Frontier-based (SIMPATH-like) graph enumeration into ZDDs.
+ *
+ * All functions take an undirected (multi-)graph given as an edge list over the vertices `0`
+ * to `num_vertices - 1`.  Edge `i` corresponds to ZDD variable `i`, hence the ZDD base must
+ * have at least as many variables as there are edges.  The size of the intermediate states is
+ * bounded by the frontier width of the edge order, e.g., for grid graphs a row-by-row order
+ * is a good choice.
+ *
+ * The returned nodes are referenced and can be combined with the usual ZDD operators, e.g.,
+ * `choose` to restrict the path lengths, or `intersection` to add further constraints.
+ */
+using graph_edge = std::pair<uint32_t, uint32_t>;
+
+namespace detail {
+
+/* Knuth's mate array: `x` is isolated, `num_vertices` is saturated (degree 2), and any other
+ * value `y` means that `x` is the end of a path fragment whose other end is `y`. */
+class mate_spec {
+public:
+	mate_spec(graph_frontier const& frontier, uint32_t s, uint32_t t)
+	    : frontier_(frontier)
+	    , s_(s)
+	    , t_(t)
+	    , sat_(frontier.num_vertices())
+	    , mate_(frontier.num_vertices())
+	{}
+
+	frontier_result operator()(frontier_state& state, uint32_t var, bool take)
+	{
+		frontier_.load(state, var, mate_);
+		for (auto const x : frontier_.entering(var)) {
+			mate_.at(x) = x;
+		}
+
+		if (take) {
+			auto const [u, v] = frontier_.edge(var);
+			if (u == v || mate_.at(u) == sat_ || mate_.at(v) == sat_) {
+				return frontier_result::reject;
+			}
+			if (is_terminal(u) && mate_.at(u) != u) {
+				return frontier_result::reject;
+			}
+			if (is_terminal(v) && mate_.at(v) != v) {
+				return frontier_result::reject;
+			}
+
+			auto const a = mate_.at(u);
+			auto const b = mate_.at(v);
+			auto const closes_cycle = (a == v);
+			if (a != u) {
+				mate_.at(u) = sat_;
+			}
+			if (b != v) {
+				mate_.at(v) = sat_;
+			}
+			if (!closes_cycle) {
+				mate_.at(a) = b;
+				mate_.at(b) = a;
+			}
+
+			/* cycles: closing a fragment, paths: connecting `s` and `t` */
+			auto const completes = is_path() ? ((a == s_ && b == t_) || (a == t_ && b == s_)) :
+			                                   closes_cycle;
+			if (closes_cycle && is_path()) {
+				return frontier_result::reject;
+			}
+			if (completes) {
+				return no_dangling_ends(var) ? frontier_result::accept :
+				                               frontier_result::reject;
+			}
+		}
+
+		for (auto const x : frontier_.leaving(var)) {
+			if (is_terminal(x)) {
+				if (mate_.at(x) == x) {
+					return frontier_result::reject;
+				}
+			} else if (mate_.at(x) != x && mate_.at(x) != sat_) {
+				return frontier_result::reject;
+			}
+		}
+		frontier_.store(state, var, mate_);
+		return frontier_result::proceed;
+	}
+
+private:
+	bool is_path() const
+	{
+		return s_ != sat_;
+	}
+
+	bool is_terminal(uint32_t x) const
+	{
+		return is_path() && (x == s_ || x == t_);
+	}
+
+	bool no_dangling_ends(uint32_t var) const
+	{
+		auto const check = [&](uint32_t x) {
+			return is_terminal(x) || mate_.at(x) == x || mate_.at(x) == sat_;
+		};
+		for (auto const x : frontier_.frontier(var)) {
+			if (!check(x)) {
+				return false;
+			}
+		}
+		for (auto const x : frontier_.entering(var)) {
+			if (!check(x)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+private:
+	graph_frontier const& frontier_;
+	uint32_t s_;
+	uint32_t t_;
+	uint32_t sat_;
+	std::vector<uint32_t> mate_;
+};
+
+/* Component labels of the frontier vertices, relabeled in order of first appearance. */
+class component_spec {
+public:
+	component_spec(graph_frontier const& frontier, bool connected)
+	    : frontier_(frontier)
+	    , connected_(connected)
+	    , component_(frontier.num_vertices())
+	    , relabel_(2u * frontier.num_vertices(), unassigned)
+	{}
+
+	frontier_result operator()(frontier_state& state, uint32_t var, bool take)
+	{
+		auto const n = frontier_.num_vertices();
+		frontier_.load(state, var, component_);
+		for (auto const x : frontier_.entering(var)) {
+			component_.at(x) = n + x;
+		}
+
+		if (take) {
+			auto const [u, v] = frontier_.edge(var);
+			auto const cu = component_.at(u);
+			auto const cv = component_.at(v);
+			if (cu == cv) {
+				return frontier_result::reject;
+			}
+			auto const merge = [&](std::vector<uint32_t> const& vertices) {
+				for (auto const x : vertices) {
+					if (component_.at(x) == cv) {
+						component_.at(x) = cu;
+					}
+				}
+			};
+			merge(frontier_.frontier(var));
+			merge(frontier_.entering(var));
+		}
+
+		auto const is_last = frontier_.is_last(var);
+		if (connected_) {
+			/* a component that leaves the frontier is finished; it must be the only one */
+			auto const& next = frontier_.next_frontier(var);
+			std::vector<uint32_t> closed;
+			for (auto const x : frontier_.leaving(var)) {
+				auto const c = component_.at(x);
+				auto const open = std::any_of(next.begin(), next.end(), [&](auto y) {
+					return component_.at(y) == c;
+				});
+				if (!open && std::find(closed.begin(), closed.end(), c) == closed.end()) {
+					closed.emplace_back(c);
+				}
+			}
+			if (!closed.empty()) {
+				return (is_last && closed.size() == 1u) ? frontier_result::accept :
+				                                          frontier_result::reject;
+			}
+		}
+		if (is_last) {
+			return frontier_result::accept;
+		}
+
+		frontier_.store(state, var, component_);
+		uint32_t label = 0u;
+		for (auto& c : state) {
+			if (relabel_.at(c) == unassigned) {
+				relabel_.at(c) = label++;
+			}
+			c = relabel_.at(c);
+		}
+		for (auto const x : frontier_.next_frontier(var)) {
+			relabel_.at(component_.at(x)) = unassigned;
+		}
+		return frontier_result::proceed;
+	}
+
+private:
+	static constexpr uint32_t unassigned = 0xffffffff;
+
+	graph_frontier const& frontier_;
+	bool connected_;
+	std::vector<uint32_t> component_;
+	std::vector<uint32_t> relabel_;
+};
+
+/* One bit per frontier vertex, telling whether it is already matched. */
+class matching_spec {
+public:
+	matching_spec(graph_frontier const& frontier, bool perfect)
+	    : frontier_(frontier)
+	    , perfect_(perfect)
+	    , matched_(frontier.num_vertices())
+	{}
+
+	frontier_result operator()(frontier_state& state, uint32_t var, bool take)
+	{
+		frontier_.load(state, var, matched_);
+		for (auto const x : frontier_.entering(var)) {
+			matched_.at(x) = 0u;
+		}
+
+		if (take) {
+			auto const [u, v] = frontier_.edge(var);
+			if (u == v || matched_.at(u) || matched_.at(v)) {
+				return frontier_result::reject;
+			}
+			matched_.at(u) = matched_.at(v) = 1u;
+		}
+
+		if (perfect_) {
+			for (auto const x : frontier_.leaving(var)) {
+				if (!matched_.at(x)) {
+					return frontier_result::reject;
+				}
+			}
+		}
+		if (frontier_.is_last(var)) {
+			return frontier_result::accept;
+		}
+		frontier_.store(state, var, matched_);
+		return frontier_result::proceed;
+	}
+
+private:
+	graph_frontier const& frontier_;
+	bool perfect_;
+	std::vector<uint32_t> matched_;
+};
+
+} // namespace detail
+
+/*! \brief Computes the family of all simple paths between `s` and `t`.
+ *
+ * \param zdd ZDD base with at least `edges.size()` variables
+ * \param num_vertices Number of vertices
+ * \param edges Edge list, edge `i` is variable `i`
+ * \param s Source vertex
+ * \param t Target vertex (must be different from `s`)
+ */
+inline zdd_base::node_index simple_paths(zdd_base& zdd, uint32_t num_vertices,
+                                         std::vector<graph_edge> const& edges, uint32_t s,
+                                         uint32_t t)
+{
+	assert(s != t && s < num_vertices && t < num_vertices);
+	graph_frontier const frontier(num_vertices, edges, decision_order(zdd, edges.size()));
+	if (!frontier.is_covered(s) || !frontier.is_covered(t)) {
+		return zdd.ref(zdd.bottom());
+	}
+	return frontier_construct(zdd, edges.size(), {}, detail::mate_spec(frontier, s, t));
+}
+
+/*! \brief Computes the family of all simple cycles. */
+inline zdd_base::node_index simple_cycles(zdd_base& zdd, uint32_t num_vertices,
+                                          std::vector<graph_edge> const& edges)
+{
+	graph_frontier const frontier(num_vertices, edges, decision_order(zdd, edges.size()));
+	return frontier_construct(zdd, edges.size(), {},
+	                          detail::mate_spec(frontier, num_vertices, num_vertices));
+}
+
+/*! \brief Computes the family of all spanning forests, i.e., all acyclic edge sets. */
+inline zdd_base::node_index spanning_forests(zdd_base& zdd, uint32_t num_vertices,
+                                             std::vector<graph_edge> const& edges)
+{
+	if (edges.empty()) {
+		return zdd.ref(zdd.top());
+	}
+	graph_frontier const frontier(num_vertices, edges, decision_order(zdd, edges.size()));
+	return frontier_construct(zdd, edges.size(), {}, detail::component_spec(frontier, false));
+}
+
+/*! \brief Computes the family of all spanning trees. */
+inline zdd_base::node_index spanning_trees(zdd_base& zdd, uint32_t num_vertices,
+                                           std::vector<graph_edge> const& edges)
+{
+	if (edges.empty()) {
+		return zdd.ref(num_vertices == 1u ? zdd.top() : zdd.bottom());
+	}
+	graph_frontier const frontier(num_vertices, edges, decision_order(zdd, edges.size()));
+	for (auto v = 0u; v < num_vertices; ++v) {
+		if (!frontier.is_covered(v)) {
+			return zdd.ref(zdd.bottom());
+		}
+	}
+	return frontier_construct(zdd, edges.size(), {}, detail::component_spec(frontier, true));
+}
+
+/*! \brief Computes the family of all matchings. */
+inline zdd_base::node_index matchings(zdd_base& zdd, uint32_t num_vertices,
+                                      std::vector<graph_edge> const& edges)
+{
+	if (edges.empty()) {
+		return zdd.ref(zdd.top());
+	}
+	graph_frontier const frontier(num_vertices, edges, decision_order(zdd, edges.size()));
+	return frontier_construct(zdd, edges.size(), {}, detail::matching_spec(frontier, false));
+}
+
+/*! \brief Computes the family of all perfect matchings. */
+inline zdd_base::node_index perfect_matchings(zdd_base& zdd, uint32_t num_vertices,
+                                              std::vector<graph_edge> const& edges)
+{
+	if (edges.empty()) {
+		return zdd.ref(num_vertices == 0u ? zdd.top() : zdd.bottom());
+	}
+	graph_frontier const frontier(num_vertices, edges, decision_order(zdd, edges.size()));
+	for (auto v = 0u; v < num_vertices; ++v) {
+		if (!frontier.is_covered(v)) {
+			return zdd.ref(zdd.bottom());
+		}
+	}
+	return frontier_construct(zdd, edges.size(), {}, detail::matching_spec(frontier, true));
+}
+
+} // namespace bill
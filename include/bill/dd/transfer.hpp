@@ -0,0 +1,145 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "cudd_zdd.hpp"
+#include "zdd.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace bill {
+
+namespace detail {
+
+/* Whether the variables of `from` appear in the same relative order in `to`, so that each node can
+ * be copied as is.  Otherwise, each node is rebuilt with a union and a join. */
+template<class From, class To>
+bool same_relative_order(From const& from, To const& to)
+{
+	for (auto level = 1u; level < from.num_variables(); ++level) {
+		if (to.level(from.var_at_level(level - 1u)) > to.level(from.var_at_level(level))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace detail
+
+/*! \brief Copies ZDDs from a `zdd_base` into a CUDD ZDD manager.
+ *
+ * The node graph is copied bottom-up, once per node, hence the copies share nodes as the
+ * originals do.  Both managers must have the same variables.  When the target orders the
+ * variables differently, each node is rebuilt from its children instead of being copied.
+ *
+ * \param from Source ZDD base
+ * \param roots Root nodes in `from`
+ * \param to Target CUDD ZDD manager
+ * \return The copies of `roots`
+ */
+inline std::vector<ZDD> transfer(zdd_base const& from, std::vector<zdd_base::node_index> const& roots,
+                                 cudd::cudd_zdd& to)
+{
+	assert(from.num_variables() <= to.num_variables());
+	bool const same_order = detail::same_relative_order(from, to);
+	std::unordered_map<zdd_base::node_index, ZDD> visited;
+	auto const copy = [&](auto const& self, zdd_base::node_index index) -> ZDD {
+		if (index == from.bottom()) {
+			return to.bottom();
+		}
+		if (index == from.top()) {
+			return to.top();
+		}
+		if (auto const it = visited.find(index); it != visited.end()) {
+			return it->second;
+		}
+		auto const lo = self(self, from.lo(index));
+		auto const hi = self(self, from.hi(index));
+		auto const var = from.var(index);
+		auto node = same_order ? to.unique(var, lo, hi)
+		                       : to.union_(lo, to.join(hi, to.elementary(var)));
+		return visited.emplace(index, node).first->second;
+	};
+
+	std::vector<ZDD> copies;
+	copies.reserve(roots.size());
+	for (auto const root : roots) {
+		copies.emplace_back(copy(copy, root));
+	}
+	return copies;
+}
+
+/*! \brief Copies a ZDD from a `zdd_base` into a CUDD ZDD manager. */
+inline ZDD transfer(zdd_base const& from, zdd_base::node_index root, cudd::cudd_zdd& to)
+{
+	return transfer(from, std::vector<zdd_base::node_index>{root}, to).front();
+}
+
+/*! \brief Copies ZDDs from a CUDD ZDD manager into a `zdd_base`.
+ *
+ * The node graph is copied bottom-up, once per node, hence the copies share nodes as the
+ * originals do.  Both managers must have the same variables.  When the target orders the
+ * variables differently, each node is rebuilt from its children instead of being copied.
+ *
+ * \param from Source CUDD ZDD manager
+ * \param roots Root nodes in `from`
+ * \param to Target ZDD base
+ * \return The copies of `roots`, each one owning a reference
+ */
+inline std::vector<zdd_base::node_index> transfer(cudd::cudd_zdd& from,
+                                                  std::vector<ZDD> const& roots, zdd_base& to)
+{
+	assert(from.num_variables() <= to.num_variables());
+	bool const same_order = detail::same_relative_order(from, to);
+	DdNode* const empty = from.bottom().getNode();
+	DdNode* const base = from.top().getNode();
+
+	/* every visited node keeps one reference until the end */
+	std::unordered_map<DdNode*, zdd_base::node_index> visited;
+	auto const copy = [&](auto const& self, DdNode* node) -> zdd_base::node_index {
+		if (node == empty) {
+			return to.bottom();
+		}
+		if (node == base) {
+			return to.top();
+		}
+		if (auto const it = visited.find(node); it != visited.end()) {
+			return it->second;
+		}
+		auto const lo = self(self, cuddE(node));
+		auto const hi = self(self, cuddT(node));
+		auto const var = Cudd_NodeReadIndex(node);
+		zdd_base::node_index index;
+		if (same_order) {
+			index = to.unique(var, to.ref(lo), to.ref(hi));
+		} else {
+			auto const temp = to.join(hi, to.elementary(var));
+			index = to.union_(lo, temp);
+			to.deref(temp);
+		}
+		visited.emplace(node, index);
+		return index;
+	};
+
+	std::vector<zdd_base::node_index> copies;
+	copies.reserve(roots.size());
+	for (auto const& root : roots) {
+		copies.emplace_back(to.ref(copy(copy, root.getNode())));
+	}
+	for (auto const& [_, index] : visited) {
+		to.deref(index);
+	}
+	return copies;
+}
+
+/*! \brief Copies a ZDD from a CUDD ZDD manager into a `zdd_base` (the result owns a reference). */
+inline zdd_base::node_index transfer(cudd::cudd_zdd& from, ZDD const& root, zdd_base& to)
+{
+	return transfer(from, std::vector<ZDD>{root}, to).front();
+}
+
+} // namespace bill
@@ -0,0 +1,323 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "../sat/interface/types.hpp"
+#include "frontier.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Static variable order heuristics.
+ *
+ * All heuristics return an *order*, i.e., a vector that contains the variable placed at each
+ * level (from top to bottom).  This is the format expected by the `zdd_base` and
+ * `cudd::cudd_zdd` constructors.  The input is the structure of the problem about to be built:
+ * a hypergraph whose hyperedges are sets of variables that interact (e.g., the sets of a
+ * family or the clauses of a CNF), or the edge list of a graph for frontier-based
+ * constructions.  Variables that are connected should be close to each other in the order.
+ */
+using hypergraph = std::vector<std::vector<uint32_t>>;
+
+/*! \brief Returns the hypergraph of a CNF, one hyperedge (of variables) per clause. */
+inline hypergraph clause_hypergraph(std::vector<std::vector<lit_type>> const& clauses)
+{
+	hypergraph hyperedges;
+	hyperedges.reserve(clauses.size());
+	for (auto const& clause : clauses) {
+		auto& hyperedge = hyperedges.emplace_back();
+		for (auto const lit : clause) {
+			hyperedge.emplace_back(lit.variable());
+		}
+	}
+	return hyperedges;
+}
+
+/*! \brief Returns the sum of the spans of all hyperedges with respect to `order`.
+ *
+ * The span of a hyperedge is the distance between its top-most and bottom-most variable.
+ */
+inline uint64_t total_span(std::vector<uint32_t> const& order, hypergraph const& hyperedges)
+{
+	std::vector<uint32_t> level(order.size());
+	for (auto i = 0u; i < order.size(); ++i) {
+		level.at(order.at(i)) = i;
+	}
+	uint64_t span = 0u;
+	for (auto const& hyperedge : hyperedges) {
+		if (hyperedge.empty()) {
+			continue;
+		}
+		auto [min, max] = std::make_pair(level.at(hyperedge.front()), level.at(hyperedge.front()));
+		for (auto const var : hyperedge) {
+			min = std::min(min, level.at(var));
+			max = std::max(max, level.at(var));
+		}
+		span += max - min;
+	}
+	return span;
+}
+
+/*! \brief Computes an order with the FORCE heuristic (Aloul, Markov, and Sakallah).
+ *
+ * Each iteration places every hyperedge at the center of gravity of its variables, and then
+ * moves each variable to the average of the centers of its hyperedges.  The iterations stop
+ * when the total span does not decrease anymore.
+ *
+ * \param num_vars Number of variables
+ * \param hyperedges Sets of interacting variables
+ * \param initial_order Initial order (default: identity)
+ * \param max_iterations Maximum number of iterations (default: 20)
+ */
+inline std::vector<uint32_t> force_order(uint32_t num_vars, hypergraph const& hyperedges,
+                                         std::vector<uint32_t> initial_order = {},
+                                         uint32_t max_iterations = 20u)
+{
+	std::vector<uint32_t> order = std::move(initial_order);
+	if (order.empty()) {
+		order.resize(num_vars);
+		std::iota(order.begin(), order.end(), 0u);
+	}
+	assert(order.size() == num_vars);
+
+	std::vector<std::vector<uint32_t>> incidence(num_vars);
+	for (auto i = 0u; i < hyperedges.size(); ++i) {
+		for (auto const var : hyperedges.at(i)) {
+			incidence.at(var).emplace_back(i);
+		}
+	}
+
+	auto best_order = order;
+	auto best_span = total_span(order, hyperedges);
+	std::vector<double> position(num_vars);
+	std::vector<double> center(hyperedges.size());
+	for (auto iteration = 0u; iteration < max_iterations; ++iteration) {
+		for (auto i = 0u; i < num_vars; ++i) {
+			position.at(order.at(i)) = i;
+		}
+		for (auto i = 0u; i < hyperedges.size(); ++i) {
+			double sum = 0.0;
+			for (auto const var : hyperedges.at(i)) {
+				sum += position.at(var);
+			}
+			center.at(i) = hyperedges.at(i).empty() ? 0.0 : sum / hyperedges.at(i).size();
+		}
+
+		std::vector<double> tentative(num_vars);
+		for (auto var = 0u; var < num_vars; ++var) {
+			if (incidence.at(var).empty()) {
+				tentative.at(var) = position.at(var);
+				continue;
+			}
+			double sum = 0.0;
+			for (auto const i : incidence.at(var)) {
+				sum += center.at(i);
+			}
+			tentative.at(var) = sum / incidence.at(var).size();
+		}
+		std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+			return tentative.at(a) < tentative.at(b);
+		});
+
+		auto const span = total_span(order, hyperedges);
+		if (span >= best_span) {
+			break;
+		}
+		best_span = span;
+		best_order = order;
+	}
+	return best_order;
+}
+
+/*! \brief Computes an order with the (reverse) Cuthill-McKee bandwidth heuristic.
+ *
+ * Two variables are adjacent if they share a hyperedge.  Each connected component is
+ * traversed in breadth-first order starting from a pseudo-peripheral variable, visiting
+ * neighbors by increasing degree.  This keeps adjacent variables close and reduces the
+ * bandwidth of the interaction matrix.
+ *
+ * \param num_vars Number of variables
+ * \param hyperedges Sets of interacting variables
+ * \param reverse Reverse the resulting order (default: true)
+ */
+inline std::vector<uint32_t> cuthill_mckee_order(uint32_t num_vars, hypergraph const& hyperedges,
+                                                 bool reverse = true)
+{
+	std::vector<std::vector<uint32_t>> adjacency(num_vars);
+	for (auto const& hyperedge : hyperedges) {
+		for (auto const a : hyperedge) {
+			for (auto const b : hyperedge) {
+				if (a != b) {
+					adjacency.at(a).emplace_back(b);
+				}
+			}
+		}
+	}
+	for (auto& neighbors : adjacency) {
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+	}
+	for (auto& neighbors : adjacency) {
+		std::stable_sort(neighbors.begin(), neighbors.end(), [&](auto a, auto b) {
+			return adjacency.at(a).size() < adjacency.at(b).size();
+		});
+	}
+
+	/* breadth-first traversal, returns the visited variables in order and the depth */
+	std::vector<uint32_t> mark(num_vars, 0u);
+	std::vector<uint32_t> depth(num_vars, 0u);
+	uint32_t current_mark = 0u;
+	auto const bfs = [&](uint32_t root) {
+		++current_mark;
+		std::vector<uint32_t> visited = {root};
+		mark.at(root) = current_mark;
+		depth.at(root) = 0u;
+		for (auto i = 0u; i < visited.size(); ++i) {
+			for (auto const next : adjacency.at(visited.at(i))) {
+				if (mark.at(next) != current_mark) {
+					mark.at(next) = current_mark;
+					depth.at(next) = depth.at(visited.at(i)) + 1u;
+					visited.emplace_back(next);
+				}
+			}
+		}
+		return std::make_pair(visited, depth.at(visited.back()));
+	};
+
+	std::vector<uint32_t> order;
+	std::vector<bool> placed(num_vars, false);
+	std::vector<uint32_t> by_degree(num_vars);
+	std::iota(by_degree.begin(), by_degree.end(), 0u);
+	std::stable_sort(by_degree.begin(), by_degree.end(), [&](auto a, auto b) {
+		return adjacency.at(a).size() < adjacency.at(b).size();
+	});
+	for (auto const candidate : by_degree) {
+		if (placed.at(candidate)) {
+			continue;
+		}
+		/* find a pseudo-peripheral variable: move to the farthest variable as long as the
+		 * eccentricity increases */
+		auto [visited, eccentricity] = bfs(candidate);
+		for (auto i = 0u; i < 8u; ++i) {
+			auto [next_visited, next_eccentricity] = bfs(visited.back());
+			if (next_eccentricity <= eccentricity) {
+				break;
+			}
+			visited = std::move(next_visited);
+			eccentricity = next_eccentricity;
+		}
+		for (auto const var : visited) {
+			placed.at(var) = true;
+			order.emplace_back(var);
+		}
+	}
+	if (reverse) {
+		std::reverse(order.begin(), order.end());
+	}
+	return order;
+}
+
+/*! \brief Computes an order of the hypergraph variables.
+ *
+ * Runs Cuthill-McKee followed by FORCE and returns the best order found.
+ */
+inline std::vector<uint32_t> hypergraph_order(uint32_t num_vars, hypergraph const& hyperedges)
+{
+	auto order = cuthill_mckee_order(num_vars, hyperedges);
+	auto refined = force_order(num_vars, hyperedges, order);
+	if (total_span(refined, hyperedges) < total_span(order, hyperedges)) {
+		return refined;
+	}
+	return order;
+}
+
+/*! \brief Computes a variable order for a CNF given in bill's clause form. */
+inline std::vector<uint32_t> clause_order(uint32_t num_vars,
+                                          std::vector<std::vector<lit_type>> const& clauses)
+{
+	return hypergraph_order(num_vars, clause_hypergraph(clauses));
+}
+
+/*! \brief Returns the frontier width of an edge order, i.e., the maximum frontier size.
+ *
+ * \param num_vertices Number of vertices
+ * \param edges Edge list
+ * \param order Edge at each position
+ */
+inline uint32_t frontier_width(uint32_t num_vertices,
+                               std::vector<graph_frontier::edge_type> const& edges,
+                               std::vector<uint32_t> const& order)
+{
+	std::vector<graph_frontier::edge_type> ordered;
+	ordered.reserve(order.size());
+	for (auto const index : order) {
+		ordered.emplace_back(edges.at(index));
+	}
+	return graph_frontier(num_vertices, ordered).width();
+}
+
+/*! \brief Computes an edge order with a small frontier width.
+ *
+ * Frontier-based constructions (see `bill/dd/simpath.hpp`) store per-vertex information for
+ * all vertices on the frontier, hence the number of states grows exponentially with the
+ * frontier width.  This heuristic derives several vertex orders (identity, Cuthill-McKee in
+ * both directions, and FORCE), sorts the edges lexicographically by the positions of their
+ * endpoints, and returns the edge order with the smallest frontier width.
+ *
+ * \param num_vertices Number of vertices
+ * \param edges Edge list
+ * \return Index (into `edges`) of the edge at each position
+ */
+inline std::vector<uint32_t> frontier_order(uint32_t num_vertices,
+                                            std::vector<graph_frontier::edge_type> const& edges)
+{
+	hypergraph hyperedges;
+	hyperedges.reserve(edges.size());
+	for (auto const& [u, v] : edges) {
+		hyperedges.push_back({u, v});
+	}
+
+	std::vector<std::vector<uint32_t>> vertex_orders;
+	auto& identity = vertex_orders.emplace_back(num_vertices);
+	std::iota(identity.begin(), identity.end(), 0u);
+	vertex_orders.emplace_back(cuthill_mckee_order(num_vertices, hyperedges, false));
+	vertex_orders.emplace_back(cuthill_mckee_order(num_vertices, hyperedges, true));
+	vertex_orders.emplace_back(force_order(num_vertices, hyperedges, vertex_orders.back()));
+
+	std::vector<uint32_t> best_order;
+	auto best_width = std::numeric_limits<uint32_t>::max();
+	for (auto const& vertex_order : vertex_orders) {
+		std::vector<uint32_t> position(num_vertices);
+		for (auto i = 0u; i < num_vertices; ++i) {
+			position.at(vertex_order.at(i)) = i;
+		}
+		auto const key = [&](uint32_t index) {
+			auto const a = position.at(edges.at(index).first);
+			auto const b = position.at(edges.at(index).second);
+			return std::make_pair(std::min(a, b), std::max(a, b));
+		};
+		std::vector<uint32_t> order(edges.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&](auto a, auto b) {
+			return key(a) < key(b);
+		});
+
+		auto const width = frontier_width(num_vertices, edges, order);
+		if (width < best_width) {
+			best_width = width;
+			best_order = std::move(order);
+		}
+	}
+	return best_order;
+}
+
+} // namespace bill
@@ -5,13 +5,16 @@
 #pragma once
 
 #include "../utils/hash.hpp"
+#include "zdd_stats.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <fmt/format.h>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stack>
 #include <unordered_map>
@@ -20,6 +23,32 @@
 
 namespace bill {
 
+/*! \brief Resource limits of the ZDD operations of a `zdd_base` (see `zdd_base::set_limits`).
+ *
+ * A value of zero means unlimited.  Nodes and memory are limits on the whole ZDD base, while
+ * steps and time are a budget given to each top-level operation.  A step is a recursive call
+ * whose result is not in the computed table.
+ */
+struct zdd_limits {
+	/*! \brief Maximum number of live nodes */
+	uint32_t max_nodes = 0u;
+	/*! \brief Maximum memory, in bytes, as estimated by `zdd_stats::memory_in_use` */
+	uint64_t max_memory = 0u;
+	/*! \brief Maximum number of steps per operation */
+	uint64_t max_steps = 0u;
+	/*! \brief Maximum time per operation */
+	std::chrono::milliseconds time_limit{0};
+};
+
+/*! \brief Outcome of the last ZDD operation of a `zdd_base`. */
+enum class zdd_status : uint8_t {
+	ok,
+	node_limit,
+	memory_limit,
+	step_limit,
+	timeout,
+};
+
 /*! \brief A zero-suppressed decision diagram (ZDD).
  *
  *  NOTE: This is a simple implementation. I would advise against its use when high-performance
@@ -33,7 +62,6 @@ namespace bill {
 
 // TODO: Implement complemented edges
 // TODO: Implement variable reordering
-// TODO: Implement Variable order heuristics
 // TODO: Implement Chain reduction
 // TODO: Implement subsets operator
 // TODO: Implement supersets operator
@@ -50,12 +78,13 @@ private:
 		{}
 
 		uint32_t marked : 1;
-		uint32_t var : 31;
+		uint32_t var : 31; // Level of the variable in the variable order
 		int32_t  refs; // Number of references - 1
 		uint32_t lo;
 		uint32_t hi;
 	};
 
+	/* Same order as `zdd_operation` */
 	enum operations : uint32_t {
 		zdd_choose,
 		zdd_difference,
@@ -69,6 +98,7 @@ private:
 		zdd_union,
 		num_operations
 	};
+	static_assert(uint32_t(zdd_operation::num_operations) == num_operations);
 
 public:
 	using node_index = uint32_t;
@@ -79,15 +109,32 @@ public:
 	 * \param log_num_objs Log number of nodes to pre-allocate (default: 16)
 	 */
 	explicit zdd_base(uint32_t num_vars, uint32_t log_num_objs = 16)
-	    : unique_tables_(num_vars)
+	    : zdd_base(identity_order(num_vars), log_num_objs)
+	{}
+
+	/* \!brief Creates a new ZDD base with a given variable order.
+	 * 
+	 * \param order Variable at each level, from top to bottom (a permutation of `0` to `N - 1`)
+	 * \param log_num_objs Log number of nodes to pre-allocate (default: 16)
+	 *
+	 * The order can be computed with the heuristics in `bill/dd/variable_order.hpp`.  All
+	 * operations work on variables, the order only affects the shape (and size) of the ZDDs.
+	 * Sets are enumerated with their elements in the order of the levels.
+	 */
+	explicit zdd_base(std::vector<uint32_t> const& order, uint32_t log_num_objs = 16)
+	    : unique_tables_(order.size())
+	    , level_to_var_(order)
+	    , var_to_level_(order.size())
 	    , num_dead_nodes_(0u)
-	    , num_cache_lookups_(0u)
-	    , num_cache_misses_(0u)
 	{
 		assert(num_variables() <= 4095);
+		for (auto level = 0u; level < order.size(); ++level) {
+			assert(order.at(level) < order.size());
+			var_to_level_.at(order.at(level)) = level;
+		}
 		nodes_.reserve(1u << log_num_objs);
-		nodes_.emplace_back(num_vars, 0, 0);
-		nodes_.emplace_back(num_vars, 1, 1);
+		nodes_.emplace_back(num_variables(), 0, 0);
+		nodes_.emplace_back(num_variables(), 1, 1);
 		build_elementary();
 		build_tautologies();
 	}
@@ -111,64 +158,6 @@ public:
 #pragma region ZDD base operations
 private:
 
-	/* \!brief Returns an unique node for the tuple (var, lo, hi)
-	 *
-	 * Given a variable `var` and node indexes lo and hi, we want to see if the ZDD base
-	 * contains a node (var, lo, hi). If no such node exists, we create it. This function 
-	 * returns a index to this _unique_ node. One crucial technicality should be noted:
-	 * 
-	 * /!\ This operation can potentially invalidate pointers, iterators and references /!\
-	 * 
-	 * Indexes are not invalidated.
-	 */ 
-	node_index unique(uint32_t var, node_index lo, node_index hi)
-	{
-		assert(var < num_variables());
-		/* ZDD reduction rule */
-		if (hi == bottom()) {
-			--nodes_.at(hi).refs;
-			return lo;
-		}
-		assert(nodes_.at(lo).var > var);
-		assert(nodes_.at(hi).var > var);
-
-		/* Unique table lookup */
-		const auto it = unique_tables_.at(var).find({lo, hi});
-		if (it != unique_tables_.at(var).end()) {
-			if (nodes_.at(it->second).refs < 0) {
-				--num_dead_nodes_;
-				nodes_.at(it->second).refs = 0;
-				return it->second;
-			} else {
-				--nodes_.at(lo).refs;
-				--nodes_.at(hi).refs;
-			}
-			return ref(it->second);
-		}
-
-		/* Create new node */
-		node_index new_node_index;
-	restart:
-		if (!free_nodes_.empty()) {
-			new_node_index = free_nodes_.top();
-			free_nodes_.pop();
-			nodes_.at(new_node_index).marked = 0;
-			nodes_.at(new_node_index).var = var;
-			nodes_.at(new_node_index).refs = 0;
-			nodes_.at(new_node_index).lo = lo;
-			nodes_.at(new_node_index).hi = hi;
-		} else {
-			if (num_dead_nodes_ > num_nodes() / 8) {
-				collect_garbage();
-				goto restart;
-			}
-			new_node_index = nodes_.size();
-			nodes_.emplace_back(var, lo, hi);
-		} 
-		unique_tables_.at(var)[{lo, hi}] = new_node_index;
-		return new_node_index;
-	}
-
 	/* \! brief Recursively revives a dead, but unrecycled node
 	 *
 	 * When we discover that a node exists, but it is dead, i.e. all links to it have gone
@@ -221,6 +210,15 @@ private:
 		--nodes_.at(node.hi).refs;
 	}
 
+	static std::vector<uint32_t> identity_order(uint32_t num_vars)
+	{
+		std::vector<uint32_t> order(num_vars);
+		for (auto var = 0u; var < num_vars; ++var) {
+			order.at(var) = var;
+		}
+		return order;
+	}
+
 	/* \!brief Return the tautology function */
 	node_index tautology(uint32_t var)
 	{
@@ -278,7 +276,7 @@ private:
 		node_index last = top();
 		for (int var = num_variables() - 1; var >= 0; --var) {
 			ref(last, 2);
-			last = unique(var, last, last);
+			last = unique_level(var, last, last);
 			assert(last == (2 * num_variables()) + 1u - var);
 			if (var != 0) {
 				--nodes_.at(last).refs;
@@ -290,7 +288,7 @@ private:
 	void build_elementary()
 	{
 		for (auto var = 0u; var < num_variables(); ++var) {
-			unique(var, bottom(), top());
+			unique_level(var, bottom(), top());
 			ref(bottom());
 			ref(top());
 		};
@@ -315,9 +313,167 @@ public:
 	node_index elementary(uint32_t var)
 	{
 		assert(var < num_variables());
-		return var + 2u;
+		return var_to_level_.at(var) + 2u;
+	}
+
+	/* \!brief Returns an unique node for the tuple (var, lo, hi)
+	 *
+	 * Given a variable `var` and node indexes lo and hi, we want to see if the ZDD base
+	 * contains a node (var, lo, hi). If no such node exists, we create it. This function 
+	 * returns a index to this _unique_ node. One crucial technicality should be noted:
+	 * 
+	 * /!\ This operation can potentially invalidate pointers, iterators and references /!\
+	 * 
+	 * Indexes are not invalidated.
+	 *
+	 * The operation takes over one reference of both `lo` and `hi`, i.e., the caller must `ref`
+	 * them beforehand, and returns a node whose reference belongs to the caller.  It is meant
+	 * for algorithms that build ZDDs bottom-up, e.g., frontier-based constructions.
+	 *
+	 * Both children must lie strictly below `var` in the variable order.
+	 *
+	 * Returns `aborted()` if the node would exceed the node or memory limit (see
+	 * `set_limits`).  In this case, the references of `lo` and `hi` are released.
+	 */
+	node_index unique(uint32_t var, node_index lo, node_index hi)
+	{
+		assert(var < num_variables());
+		status_ = zdd_status::ok;
+		return unique_level(var_to_level_.at(var), lo, hi);
+	}
+
+	/*! \brief Returns the level of variable `var` in the variable order. */
+	uint32_t level(uint32_t var) const
+	{
+		return var_to_level_.at(var);
+	}
+
+	/*! \brief Returns the variable at level `level` of the variable order. */
+	uint32_t var_at_level(uint32_t level) const
+	{
+		return level_to_var_.at(level);
+	}
+
+	/*! \brief Returns the variable order, i.e., the variable at each level (top to bottom). */
+	std::vector<uint32_t> const& variable_order() const
+	{
+		return level_to_var_;
+	}
+
+	/*! \brief Returns the variable of a non-terminal node. */
+	uint32_t var(node_index index) const
+	{
+		assert(index > top() && index < nodes_.size());
+		return level_to_var_.at(nodes_.at(index).var);
+	}
+
+	/*! \brief Returns the LO child of a non-terminal node (the sets without its variable). */
+	node_index lo(node_index index) const
+	{
+		assert(index > top() && index < nodes_.size());
+		return nodes_.at(index).lo;
+	}
+
+	/*! \brief Returns the HI child of a non-terminal node (the sets with its variable). */
+	node_index hi(node_index index) const
+	{
+		assert(index > top() && index < nodes_.size());
+		return nodes_.at(index).hi;
+	}
+
+private:
+	/* \!brief Returns an unique node for the tuple (level, lo, hi), see `unique`. */
+	node_index unique_level(uint32_t var, node_index lo, node_index hi)
+	{
+		assert(var < num_variables());
+		/* ZDD reduction rule */
+		if (hi == bottom()) {
+			--nodes_.at(hi).refs;
+			return lo;
+		}
+		assert(nodes_.at(lo).var > var);
+		assert(nodes_.at(hi).var > var);
+
+		/* Unique table lookup */
+		const auto it = unique_tables_.at(var).find({lo, hi});
+		if (it != unique_tables_.at(var).end()) {
+			if (nodes_.at(it->second).refs < 0) {
+				--num_dead_nodes_;
+				nodes_.at(it->second).refs = 0;
+				return it->second;
+			} else {
+				--nodes_.at(lo).refs;
+				--nodes_.at(hi).refs;
+			}
+			return ref(it->second);
+		}
+
+		/* Create new node */
+		if (!can_create_node()) {
+			deref(lo);
+			deref(hi);
+			return aborted();
+		}
+		node_index new_node_index;
+	restart:
+		if (!free_nodes_.empty()) {
+			new_node_index = free_nodes_.top();
+			free_nodes_.pop();
+			nodes_.at(new_node_index).marked = 0;
+			nodes_.at(new_node_index).var = var;
+			nodes_.at(new_node_index).refs = 0;
+			nodes_.at(new_node_index).lo = lo;
+			nodes_.at(new_node_index).hi = hi;
+		} else {
+			if (num_dead_nodes_ > num_nodes() / 8) {
+				collect_garbage();
+				goto restart;
+			}
+			new_node_index = nodes_.size();
+			if (nodes_.size() == nodes_.capacity()) {
+				nodes_.emplace_back(var, lo, hi);
+				peak_memory_ = std::max(peak_memory_, memory_in_use());
+			} else {
+				nodes_.emplace_back(var, lo, hi);
+			}
+		} 
+		peak_nodes_ = std::max(peak_nodes_, num_nodes());
+		++num_created_nodes_;
+		unique_tables_.at(var)[{lo, hi}] = new_node_index;
+		return new_node_index;
 	}
 
+	/* \!brief Checks the node and memory limits before a new node is created. */
+	bool can_create_node()
+	{
+		if (depth_ > 0u && status_ != zdd_status::ok) {
+			return false;
+		}
+		if (limits_.max_nodes != 0u && num_nodes() >= limits_.max_nodes) {
+			status_ = zdd_status::node_limit;
+			return false;
+		}
+		if (limits_.max_memory == 0u) {
+			return true;
+		}
+		/* The node vector is about to grow: first try to recycle dead nodes */
+		bool const must_grow = free_nodes_.empty() && nodes_.size() == nodes_.capacity();
+		if (must_grow && num_dead_nodes_ > 0u) {
+			collect_garbage();
+			return can_create_node();
+		}
+		/* Hash tables grow along with the nodes, estimate the memory every 1024 nodes */
+		if (must_grow || (num_created_nodes_ & 1023u) == 0u) {
+			uint64_t const growth = must_grow ? nodes_.capacity() * sizeof(node_type) : 0u;
+			if (memory_in_use() + growth > limits_.max_memory) {
+				status_ = zdd_status::memory_limit;
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
 	/*! \brief Increase the reference count of a node. */
 	node_index ref(node_index index, int32_t i = 1)
 	{
@@ -338,12 +494,194 @@ public:
 		--nodes_.at(index).refs;
 	}
 
+	/*! \brief Returns the number of references to a node (0 for a dead node). */
+	uint32_t num_references(node_index index) const
+	{
+		return nodes_.at(index).refs + 1;
+	}
+
 	/*! \brief Recycle all the dead nodes */
 	void collect_garbage()
 	{
+		auto const start = std::chrono::steady_clock::now();
+		peak_memory_ = std::max(peak_memory_, memory_in_use());
 		cache_cleanup();
 		tables_cleanup();
 		num_dead_nodes_ = 0;
+		++num_garbage_collections_;
+		garbage_collection_time_ += std::chrono::duration<double, std::milli>(
+		                                std::chrono::steady_clock::now() - start)
+		                                .count();
+	}
+#pragma endregion
+
+#pragma region Statistics
+public:
+	/*! \brief Returns the statistics of the ZDD base (see `zdd_stats`).
+	 *
+	 * The memory is an estimate of the size of the node vector and of the hash tables.
+	 */
+	zdd_stats stats() const
+	{
+		zdd_stats st;
+		st.operations = operation_stats_;
+		for (auto const& op : operation_stats_) {
+			st.cache_lookups += op.cache_lookups;
+			st.cache_misses += op.cache_misses;
+		}
+		for (auto const& table : computed_tables_) {
+			st.cache_entries += table.size();
+			st.cache_slots += table.bucket_count();
+		}
+		for (auto const& table : unique_tables_) {
+			st.unique_entries += table.size();
+			st.unique_slots += table.bucket_count();
+		}
+		st.num_nodes = num_nodes();
+		st.num_dead_nodes = num_dead_nodes_;
+		st.peak_nodes = std::max(peak_nodes_, num_nodes());
+		st.num_garbage_collections = num_garbage_collections_;
+		st.garbage_collection_time = garbage_collection_time_;
+		st.memory_in_use = memory_in_use();
+		st.peak_memory = std::max(peak_memory_, st.memory_in_use);
+		return st;
+	}
+
+	/*! \brief Resets the counters; peaks restart from the current values. */
+	void reset_stats()
+	{
+		operation_stats_ = {};
+		num_garbage_collections_ = 0u;
+		garbage_collection_time_ = 0.0;
+		peak_nodes_ = num_nodes();
+		peak_memory_ = memory_in_use();
+	}
+
+private:
+	uint64_t memory_in_use() const
+	{
+		auto const table_bytes = [](unique_table_type const& table) -> uint64_t {
+			return table.bucket_count() * sizeof(void*)
+			       + table.size() * (sizeof(unique_table_type::value_type) + sizeof(void*));
+		};
+		uint64_t bytes = nodes_.capacity() * sizeof(node_type)
+		                 + free_nodes_.size() * sizeof(node_index);
+		for (auto const& table : unique_tables_) {
+			bytes += table_bytes(table);
+		}
+		for (auto const& table : computed_tables_) {
+			bytes += table_bytes(table);
+		}
+		return bytes;
+	}
+#pragma endregion
+
+#pragma region Limits
+public:
+	/*! \brief Sets the resource limits of the ZDD operations (see `zdd_limits`).
+	 *
+	 * An operation that exceeds a limit stops, releases all its intermediate results, and
+	 * returns `aborted()`.  Results of completed sub-operations remain in the computed table,
+	 * hence the ZDD base stays consistent, and repeating the operation with larger limits
+	 * resumes from them.  Use `status()` to find out which limit was exceeded.
+	 */
+	void set_limits(zdd_limits const& limits)
+	{
+		limits_ = limits;
+	}
+
+	/*! \brief Returns the resource limits of the ZDD operations. */
+	zdd_limits const& limits() const
+	{
+		return limits_;
+	}
+
+	/*! \brief Returns the outcome of the last operation. */
+	zdd_status status() const
+	{
+		return status_;
+	}
+
+	/*! \brief Returns the index returned by operations that exceeded a limit.
+	 *
+	 * It is not a node: it must neither be referenced nor passed to other operations.
+	 */
+	node_index aborted() const
+	{
+		return std::numeric_limits<node_index>::max();
+	}
+
+private:
+	/* Counts a call of an operation, and starts the budget of top-level operations */
+	class operation_scope {
+	public:
+		operation_scope(zdd_base& zdd, operations op)
+		    : zdd_(zdd)
+		{
+			++zdd.operation_stats_.at(op).calls;
+			if (zdd.depth_++ > 0u) {
+				return;
+			}
+			zdd.status_ = zdd_status::ok;
+			zdd.num_steps_ = 0u;
+			if (zdd.limits_.time_limit.count() > 0) {
+				zdd.deadline_ = std::chrono::steady_clock::now() + zdd.limits_.time_limit;
+			}
+		}
+
+		~operation_scope()
+		{
+			--zdd_.depth_;
+		}
+
+	private:
+		zdd_base& zdd_;
+	};
+
+	/* \!brief Counts a step of the current operation and checks its budget. */
+	bool within_budget()
+	{
+		if (status_ != zdd_status::ok) {
+			return false;
+		}
+		++num_steps_;
+		if (limits_.max_steps != 0u && num_steps_ > limits_.max_steps) {
+			status_ = zdd_status::step_limit;
+			return false;
+		}
+		if (limits_.time_limit.count() > 0 && (num_steps_ & 255u) == 0u
+		    && std::chrono::steady_clock::now() > deadline_) {
+			status_ = zdd_status::timeout;
+			return false;
+		}
+		return true;
+	}
+
+	/* \!brief Releases a reference, unless the index is `aborted()`. */
+	void release(node_index index)
+	{
+		if (index != aborted()) {
+			deref(index);
+		}
+	}
+
+	/* \!brief Creates the result node of an operation and stores it in the computed table.
+	 *
+	 * Takes over the references of `r_lo` and `r_hi`, which can be `aborted()`.
+	 */
+	node_index make_result(operations op, node_index index_f, node_index index_g, uint32_t var,
+	                       node_index r_lo, node_index r_hi)
+	{
+		if (r_lo == aborted() || r_hi == aborted()) {
+			release(r_lo);
+			release(r_hi);
+			return aborted();
+		}
+		node_index const index_new = unique_level(var, r_lo, r_hi);
+		if (index_new != aborted()) {
+			computed_tables_.at(op)[{index_f, index_g}] = index_new;
+		}
+		return index_new;
 	}
 #pragma endregion
 
@@ -353,15 +691,19 @@ public:
 	node_index choose(node_index index_f, uint32_t k)
 	{
 		constexpr operations op = operations::zdd_choose;
+		operation_scope const scope(*this, op);
 		if (index_f <= top()) {
-			return k > 0 ? bottom() : top();
+			return ref(k > 0 ? bottom() : top());
+		}
+		if (k == 0) {
+			return ref(top());
 		}
 		if (k == 1) {
 			return ref(index_f);
 		}
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, k});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -370,19 +712,15 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_type node_f = nodes_.at(index_f);
-		node_index index_new = choose(node_f.lo, k);
-		if (k > 0) {
-			node_index temp = choose(node_f.lo, k - 1);
-			ref(index_new);
-			index_new = unique(node_f.var, index_new, temp);
-		} else {
-			deref(index_new);
-		}
-		computed_tables_.at(op)[{index_f, k}] = index_new;
-		return index_new;
+		node_index const r_lo = choose(node_f.lo, k);
+		node_index const r_hi = choose(node_f.lo, k - 1);
+		return make_result(op, index_f, k, node_f.var, r_lo, r_hi);
 	}
 
 	/* \!brief Computes the difference of two ZDDs (`f - g`)
@@ -391,11 +729,12 @@ public:
 	node_index difference(node_index index_f, node_index index_g)
 	{
 		constexpr operations op = operations::zdd_difference;
+		operation_scope const scope(*this, op);
 		if (index_f == bottom()) {
 			return ref(bottom());
 		}
-		node_type& node_f = nodes_.at(index_f);
-	
+		node_type const node_f = nodes_.at(index_f);
+
 	restart:
 		if (index_f == index_g) {
 			return ref(bottom());
@@ -403,14 +742,14 @@ public:
 		if (index_g == bottom()) {
 			return ref(index_f);
 		}
-		node_type& node_g = nodes_.at(index_g);
+		node_type const node_g = nodes_.at(index_g);
 		if (node_g.var < node_f.var) {
 			index_g = node_g.lo;
 			goto restart;
 		} 
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, index_g});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -419,7 +758,10 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_index r_lo;
 		node_index r_hi;
@@ -430,15 +772,14 @@ public:
 			r_lo = difference(node_f.lo, index_g);
 			r_hi = ref(node_f.hi);
 		}
-		node_index index_new = unique(node_f.var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, index_g}] = index_new;
-		return index_new;
+		return make_result(op, index_f, index_g, node_f.var, r_lo, r_hi);
 	}
 
 	/* \!brief Computes the intersection of two ZDDs */
 	node_index intersection(node_index index_f, node_index index_g)
 	{
 		constexpr operations op = operations::zdd_intersection;
+		operation_scope const scope(*this, op);
 		if (index_f == tautology()) {
 			return ref(index_g); 
 		}
@@ -474,7 +815,7 @@ public:
 		assert(node_f.var == node_g.var);
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, index_g});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -483,19 +824,21 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_index r_lo = intersection(node_f.lo, node_g.lo);
 		node_index r_hi = intersection(node_f.hi, node_g.hi);
-		node_index index_new = unique(node_f.var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, index_g}] = index_new;
-		return index_new;
+		return make_result(op, index_f, index_g, node_f.var, r_lo, r_hi);
 	}
 
 	/* \!brief Computes the join of two ZDDs */
 	node_index join(node_index index_f, node_index index_g)
 	{
 		constexpr operations op = operations::zdd_join;
+		operation_scope const scope(*this, op);
 		if (index_f > index_g) {
 			std::swap(index_f, index_g);
 		}
@@ -507,7 +850,7 @@ public:
 		}
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, index_g});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -516,7 +859,10 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_type node_f = nodes_.at(index_f);
 		node_type node_g = nodes_.at(index_g);
@@ -533,16 +879,88 @@ public:
 		} else {
 			// In this case node_f.var == node_g.var
 			r_lo = union_(node_g.lo, node_g.hi);
+			if (r_lo == aborted()) {
+				return aborted();
+			}
 			node_index const r_hl = join(node_f.hi, r_lo);
 			deref(r_lo);
 			node_index const r_lh = join(node_f.lo, node_g.hi);
+			if (r_hl == aborted() || r_lh == aborted()) {
+				release(r_hl);
+				release(r_lh);
+				return aborted();
+			}
 			r_hi = union_(r_hl, r_lh);
 			deref(r_hl);
 			deref(r_lh);
 			r_lo = join(node_f.lo, node_g.lo);
 		}
-		node_index index_new = unique(var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, index_g}] = index_new;
+		return make_result(op, index_f, index_g, var, r_lo, r_hi);
+	}
+
+	/* \!brief Computes the weak division of two ZDDs
+	 *
+	 * The result contains every set A that is disjoint with every set B of g and such that
+	 * A \cup B is in f.
+	 */
+	node_index edivide(node_index index_f, node_index index_g)
+	{
+		constexpr operations op = operations::zdd_edivide;
+		operation_scope const scope(*this, op);
+		if (index_g == top()) {
+			return ref(index_f);
+		}
+		if (index_g == bottom() || index_f <= top()) {
+			return ref(bottom());
+		}
+		if (index_f == index_g) {
+			return ref(top());
+		}
+		// The top variable of g is in some set of g, but in no set of f
+		if (nodes_.at(index_f).var > nodes_.at(index_g).var) {
+			return ref(bottom());
+		}
+
+		// Cache lookup
+		++operation_stats_.at(op).cache_lookups;
+		const auto it = computed_tables_.at(op).find({index_f, index_g});
+		if (it != computed_tables_.at(op).end()) {
+			if (nodes_.at(it->second).refs < 0) {
+				revive_node(it->second);
+				return it->second;
+			}
+			return ref(it->second);
+		}
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
+
+		node_type node_f = nodes_.at(index_f);
+		node_type node_g = nodes_.at(index_g);
+		node_index index_new;
+		if (node_f.var < node_g.var) {
+			node_index const r_lo = edivide(node_f.lo, index_g);
+			node_index const r_hi = edivide(node_f.hi, index_g);
+			return make_result(op, index_f, index_g, node_f.var, r_lo, r_hi);
+		} else {
+			// In this case node_f.var == node_g.var, the quotient does not contain var
+			index_new = edivide(node_f.hi, node_g.hi);
+			if (node_g.lo != bottom() && index_new != bottom() && index_new != aborted()) {
+				node_index const temp = edivide(node_f.lo, node_g.lo);
+				if (temp == aborted()) {
+					deref(index_new);
+					return aborted();
+				}
+				node_index const result = intersection(index_new, temp);
+				deref(temp);
+				deref(index_new);
+				index_new = result;
+			}
+		}
+		if (index_new != aborted()) {
+			computed_tables_.at(op)[{index_f, index_g}] = index_new;
+		}
 		return index_new;
 	}
 
@@ -550,11 +968,12 @@ public:
 	node_index maximal(node_index index_f)
 	{
 		constexpr operations op = operations::zdd_maximal;
+		operation_scope const scope(*this, op);
 		if (index_f <= top()) {
 			return ref(index_f);
 		}
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, 0});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -563,22 +982,29 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_type node_f = nodes_.at(index_f);
 		node_index r_hi = maximal(node_f.hi);
 		node_index temp = maximal(node_f.lo);
+		if (r_hi == aborted() || temp == aborted()) {
+			release(r_hi);
+			release(temp);
+			return aborted();
+		}
 		node_index r_lo = nonsubsets(temp, r_hi);
 		deref(temp);
-		node_index index_new = unique(node_f.var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, 0}] = index_new;
-		return index_new;;
+		return make_result(op, index_f, 0, node_f.var, r_lo, r_hi);
 	}
 
 	/* \!brief Computes the meet of two ZDDs */
 	node_index meet(node_index index_f, node_index index_g)
 	{
 		constexpr operations op = operations::zdd_meet;
+		operation_scope const scope(*this, op);
 		if (index_f > index_g) {
 			std::swap(index_f, index_g);
 		}
@@ -587,7 +1013,7 @@ public:
 		}
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, index_g});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -596,7 +1022,10 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_type node_f = nodes_.at(index_f);
 		node_type node_g = nodes_.at(index_g);
@@ -604,34 +1033,47 @@ public:
 		node_index r_hi;
 		if (node_f.var < node_g.var) {
 			r_lo = union_(node_f.lo, node_f.hi);
+			if (r_lo == aborted()) {
+				return aborted();
+			}
 			r_hi = meet(r_lo, index_g);
 			deref(r_lo);
 			return r_hi;
 		} else if (node_f.var > node_g.var) {
 			r_lo = union_(node_g.lo, node_g.hi);
+			if (r_lo == aborted()) {
+				return aborted();
+			}
 			r_hi = meet(r_lo, index_f);
 			deref(r_lo);
 			return r_hi;
 		} else { 
 			// In this case node_f.var == node_g.var
 			r_hi = union_(node_f.lo, node_f.hi);
+			if (r_hi == aborted()) {
+				return aborted();
+			}
 			node_index r_hl = meet(r_hi, node_g.lo);
 			deref(r_hi);
 			node_index r_lh = meet(node_f.lo, node_g.hi);
+			if (r_hl == aborted() || r_lh == aborted()) {
+				release(r_hl);
+				release(r_lh);
+				return aborted();
+			}
 			r_lo = union_(r_hl, r_lh);
 			deref(r_hl);
 			deref(r_lh);
 			r_hi = meet(node_f.hi, node_g.hi);
 		}
-		node_index index_new = unique(node_f.var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, index_g}] = index_new;
-		return index_new;
+		return make_result(op, index_f, index_g, node_f.var, r_lo, r_hi);
 	}
 
 	/* \!brief Computes the nonsubsets of two ZDDs */
 	node_index nonsubsets(node_index index_f, node_index index_g)
 	{
 		constexpr operations op = operations::zdd_nonsubsets;
+		operation_scope const scope(*this, op);
 		if (index_g == bottom()) {
 			return ref(index_f);
 		}
@@ -643,11 +1085,19 @@ public:
 		}
 
 		if (nodes_.at(index_f).var > nodes_.at(index_g).var) {
-			return nonsubsets(index_f, nodes_.at(index_g).lo);
+			// The top variable of g is in no set of f
+			node_type const node_g = nodes_.at(index_g);
+			node_index const temp = union_(node_g.lo, node_g.hi);
+			if (temp == aborted()) {
+				return aborted();
+			}
+			node_index const result = nonsubsets(index_f, temp);
+			deref(temp);
+			return result;
 		}
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, index_g});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -656,7 +1106,10 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_type node_f = nodes_.at(index_f);
 		node_type node_g = nodes_.at(index_g);
@@ -668,20 +1121,24 @@ public:
 		} else {
 			node_index const temp = nonsubsets(node_f.lo, node_g.hi);
 			r_hi = nonsubsets(node_f.lo, node_g.lo);
+			if (temp == aborted() || r_hi == aborted()) {
+				release(temp);
+				release(r_hi);
+				return aborted();
+			}
 			r_lo = intersection(temp, r_hi);
 			deref(temp);
 			deref(r_hi);
 			r_hi = nonsubsets(node_f.hi, node_g.hi);
 		}
-		node_index index_new = unique(node_f.var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, index_g}] = index_new;
-		return index_new;
+		return make_result(op, index_f, index_g, node_f.var, r_lo, r_hi);
 	}
 
 	/* \!brief Computes the nonsupersets of two ZDDs */
 	node_index nonsupersets(node_index index_f, node_index index_g)
 	{
 		constexpr operations op = operations::zdd_nonsupersets;
+		operation_scope const scope(*this, op);
 		if (index_g == bottom()) {
 			return ref(index_f);
 		}
@@ -702,7 +1159,7 @@ public:
 		}
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, index_g});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -711,7 +1168,10 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_type node_f = nodes_.at(index_f);
 		node_type node_g = nodes_.at(index_g);
@@ -724,14 +1184,17 @@ public:
 		} else {
 			r_lo = nonsupersets(node_f.hi, node_g.hi);
 			node_index temp = nonsupersets(node_f.hi, node_g.lo);
+			if (r_lo == aborted() || temp == aborted()) {
+				release(r_lo);
+				release(temp);
+				return aborted();
+			}
 			r_hi = intersection(temp, r_lo);
 			deref(temp);
 			deref(r_lo);
 			r_lo = nonsupersets(node_f.lo, node_g.lo);
 		}
-		node_index index_new = unique(var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, index_g}] = index_new;
-		return index_new;
+		return make_result(op, index_f, index_g, var, r_lo, r_hi);
 	}
 
 	/* \!brief Return the tautology function */
@@ -744,6 +1207,7 @@ public:
 	node_index union_(node_index index_f, node_index index_g)
 	{
 		constexpr operations op = operations::zdd_union;
+		operation_scope const scope(*this, op);
 		if (index_f == index_g) {
 			return ref(index_f);
 		}
@@ -755,7 +1219,7 @@ public:
 		}
 
 		// Cache lookup
-		++num_cache_lookups_;
+		++operation_stats_.at(op).cache_lookups;
 		const auto it = computed_tables_.at(op).find({index_f, index_g});
 		if (it != computed_tables_.at(op).end()) {
 			if (nodes_.at(it->second).refs < 0) {
@@ -764,7 +1228,10 @@ public:
 			}
 			return ref(it->second);
 		}
-		++num_cache_misses_;;
+		++operation_stats_.at(op).cache_misses;
+		if (!within_budget()) {
+			return aborted();
+		}
 
 		node_type node_f = nodes_.at(index_f);
 		node_type node_g = nodes_.at(index_g);
@@ -792,9 +1259,7 @@ public:
 			r_lo = union_(node_f.lo, node_g.lo);
 			r_hi = union_(node_f.hi, node_g.hi);
 		}
-		node_index index_new = unique(var, r_lo, r_hi);
-		computed_tables_.at(op)[{index_f, index_g}] = index_new;
-		return index_new;
+		return make_result(op, index_f, index_g, var, r_lo, r_hi);
 	}
 #pragma endregion
 
@@ -811,7 +1276,7 @@ private:
 				return false;
 			}
 			auto new_set = set;
-			new_set.push_back(nodes_.at(index).var);
+			new_set.push_back(level_to_var_.at(nodes_.at(index).var));
 			if (!foreach_set_rec(nodes_.at(index).hi, new_set, fn)) {
 				return false;
 			}
@@ -917,12 +1382,25 @@ private:
 	std::vector<node_type> nodes_;
 	std::stack<node_index> free_nodes_;
 	std::vector<unique_table_type> unique_tables_;
+	std::vector<uint32_t> level_to_var_;
+	std::vector<uint32_t> var_to_level_;
 	std::array<unique_table_type, operations::num_operations> computed_tables_;
 
 	// Stats
 	uint32_t num_dead_nodes_;
-	uint32_t num_cache_lookups_;
-	uint32_t num_cache_misses_;
+	std::array<zdd_operation_stats, operations::num_operations> operation_stats_;
+	uint64_t num_garbage_collections_ = 0u;
+	double garbage_collection_time_ = 0.0;
+	uint32_t peak_nodes_ = 0u;
+	uint64_t peak_memory_ = 0u;
+	uint64_t num_created_nodes_ = 0u;
+
+	// Limits
+	zdd_limits limits_;
+	zdd_status status_ = zdd_status::ok;
+	uint32_t depth_ = 0u;
+	uint64_t num_steps_ = 0u;
+	std::chrono::steady_clock::time_point deadline_;
 };
 
 } // namespace bill
@@ -0,0 +1,252 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "../sat/interface/types.hpp"
+#include "../sat/tseytin.hpp"
+#include "cudd_zdd.hpp"
+#include "zdd.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+namespace detail {
+
+/* Tseytin encoding of the characteristic function of a ZDD.  Every node gets a literal that is
+ * true iff the variables from the level of the node downwards form a set of its family.  Edges
+ * that skip levels are encoded through chains of `and` gates which force the skipped
+ * variables to false.  Constants are folded, hence no literal is created for terminals. */
+template<class Solver, class Node, class Expand>
+class zdd_cnf_encoder {
+	/* A literal or a constant */
+	struct term {
+		enum class kinds : uint8_t { false_, true_, literal } kind;
+		lit_type lit;
+
+		bool operator==(term const& other) const
+		{
+			return kind == other.kind && (kind != kinds::literal || lit == other.lit);
+		}
+	};
+
+	struct key_hash {
+		std::size_t operator()(std::pair<uint32_t, Node> const& key) const
+		{
+			return std::hash<Node>()(key.second) * 4099u + key.first;
+		}
+	};
+
+public:
+	zdd_cnf_encoder(Solver& solver, Node bottom, Node top, std::vector<lit_type> level_lits,
+	                Expand&& expand)
+	    : solver_(solver)
+	    , bottom_(bottom)
+	    , top_(top)
+	    , level_lits_(std::move(level_lits))
+	    , expand_(expand)
+	{}
+
+	lit_type run(Node root)
+	{
+		auto const result = chain(0u, root, level_of(root));
+		if (result.kind == term::kinds::literal) {
+			return result.lit;
+		}
+		/* constant family: a fresh literal fixed by a unit clause */
+		auto const r = lit_type(solver_.add_variable(), lit_type::polarities::positive);
+		solver_.add_clause(result.kind == term::kinds::true_ ? r : ~r);
+		return r;
+	}
+
+private:
+	uint32_t num_levels() const
+	{
+		return level_lits_.size();
+	}
+
+	uint32_t level_of(Node node)
+	{
+		if (node == bottom_ || node == top_) {
+			return num_levels();
+		}
+		return std::get<0>(expand_(node));
+	}
+
+	static term constant(bool value)
+	{
+		return {value ? term::kinds::true_ : term::kinds::false_, lit_type()};
+	}
+
+	static term literal(lit_type lit)
+	{
+		return {term::kinds::literal, lit};
+	}
+
+	/* `node` holds and all variables from `level` to the level of `node` are false */
+	term chain(uint32_t level, Node node, uint32_t node_level)
+	{
+		if (level == node_level) {
+			return encode(node);
+		}
+		auto const key = std::make_pair(level, node);
+		if (auto const it = chains_.find(key); it != chains_.end()) {
+			return it->second;
+		}
+		auto const next = chain(level + 1u, node, node_level);
+		auto const x = level_lits_.at(level);
+		term result;
+		if (next.kind == term::kinds::false_) {
+			result = constant(false);
+		} else if (next.kind == term::kinds::true_) {
+			result = literal(~x);
+		} else {
+			result = literal(add_tseytin_and(solver_, ~x, next.lit));
+		}
+		chains_.emplace(key, result);
+		return result;
+	}
+
+	/* `node` holds, starting from its own level */
+	term encode(Node node)
+	{
+		if (node == bottom_) {
+			return constant(false);
+		}
+		if (node == top_) {
+			return constant(true);
+		}
+		if (auto const it = nodes_.find(node); it != nodes_.end()) {
+			return it->second;
+		}
+		auto const [level, lo, hi] = expand_(node);
+		auto const t = chain(level + 1u, hi, level_of(hi));
+		auto const e = chain(level + 1u, lo, level_of(lo));
+		auto const result = ite(level_lits_.at(level), t, e);
+		nodes_.emplace(node, result);
+		return result;
+	}
+
+	/* `x ? t : e`, with constant folding */
+	term ite(lit_type x, term const& t, term const& e)
+	{
+		using kinds = typename term::kinds;
+		if (t == e) {
+			return t;
+		}
+		if (t.kind != kinds::literal && e.kind != kinds::literal) {
+			return literal(t.kind == kinds::true_ ? x : ~x);
+		}
+		if (t.kind == kinds::false_) {
+			return literal(add_tseytin_and(solver_, ~x, e.lit));
+		}
+		if (e.kind == kinds::false_) {
+			return literal(add_tseytin_and(solver_, x, t.lit));
+		}
+		if (t.kind == kinds::true_) {
+			return literal(add_tseytin_or(solver_, x, e.lit));
+		}
+		if (e.kind == kinds::true_) {
+			return literal(add_tseytin_or(solver_, ~x, t.lit));
+		}
+
+		/* the two redundant clauses make the encoding propagation complete */
+		auto const y = lit_type(solver_.add_variable(), lit_type::polarities::positive);
+		solver_.add_clause({~x, ~t.lit, y});
+		solver_.add_clause({x, ~e.lit, y});
+		solver_.add_clause({~x, t.lit, ~y});
+		solver_.add_clause({x, e.lit, ~y});
+		solver_.add_clause({~t.lit, ~e.lit, y});
+		solver_.add_clause({t.lit, e.lit, ~y});
+		return literal(y);
+	}
+
+private:
+	Solver& solver_;
+	Node bottom_;
+	Node top_;
+	std::vector<lit_type> level_lits_;
+	Expand expand_;
+	std::unordered_map<Node, term> nodes_;
+	std::unordered_map<std::pair<uint32_t, Node>, term, key_hash> chains_;
+};
+
+template<class Solver, class Node, class Expand>
+lit_type add_zdd_constraint(Solver& solver, Node root, Node bottom, Node top,
+                            std::vector<lit_type> level_lits, Expand&& expand)
+{
+	zdd_cnf_encoder<Solver, Node, Expand> encoder(solver, bottom, top, std::move(level_lits),
+	                                              std::forward<Expand>(expand));
+	return encoder.run(root);
+}
+
+} // namespace detail
+
+/*! \brief Adds CNF clauses for `y = (the assignment is a set of the family)` to the solver.
+ *
+ * The set of an assignment contains ZDD variable `i` iff `vars[i]` is true.  Each ZDD node
+ * gets one auxiliary literal, defined by Tseytin-style clauses; edges that skip variables add
+ * `and` gates that force the skipped variables to false.  Unit propagation on the clauses is
+ * complete: any literal of `vars` implied by `y` and the current assignment is propagated.
+ *
+ * The family constraint is only enforced when `y` is asserted, e.g., with a unit clause or
+ * as an assumption.
+ *
+ * \param solver Solver
+ * \param zdd ZDD base
+ * \param root Root of the family
+ * \param vars Literal of each ZDD variable
+ * \return Literal y
+ */
+template<typename Solver>
+lit_type add_zdd_constraint(Solver& solver, zdd_base const& zdd, zdd_base::node_index root,
+                            std::vector<lit_type> const& vars)
+{
+	assert(vars.size() == zdd.num_variables());
+	std::vector<lit_type> level_lits;
+	level_lits.reserve(vars.size());
+	for (auto level = 0u; level < vars.size(); ++level) {
+		level_lits.emplace_back(vars.at(zdd.var_at_level(level)));
+	}
+	return detail::add_zdd_constraint(solver, root, zdd.bottom(), zdd.top(),
+	                                  std::move(level_lits), [&](zdd_base::node_index index) {
+		                                  return std::make_tuple(zdd.level(zdd.var(index)),
+		                                                         zdd.lo(index), zdd.hi(index));
+	                                  });
+}
+
+/*! \brief Adds CNF clauses for `y = (the assignment is a set of the family)` to the solver.
+ *
+ * \param solver Solver
+ * \param zdd CUDD ZDD manager
+ * \param root Root of the family
+ * \param vars Literal of each ZDD variable
+ * \return Literal y
+ */
+template<typename Solver>
+lit_type add_zdd_constraint(Solver& solver, cudd::cudd_zdd& zdd, ZDD const& root,
+                            std::vector<lit_type> const& vars)
+{
+	assert(vars.size() == zdd.num_variables());
+	std::vector<lit_type> level_lits;
+	level_lits.reserve(vars.size());
+	for (auto level = 0u; level < vars.size(); ++level) {
+		level_lits.emplace_back(vars.at(zdd.var_at_level(level)));
+	}
+	return detail::add_zdd_constraint(solver, root.getNode(), zdd.bottom().getNode(),
+	                                  zdd.top().getNode(), std::move(level_lits),
+	                                  [&](DdNode* node) {
+		                                  return std::make_tuple(
+		                                      zdd.level(Cudd_NodeReadIndex(node)), cuddE(node),
+		                                      cuddT(node));
+	                                  });
+}
+
+} // namespace bill
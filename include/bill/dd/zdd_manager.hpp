@@ -0,0 +1,561 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "cudd_zdd.hpp"
+#include "zdd.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Adaptor of a ZDD package to the common front end.
+ *
+ * A ZDD package can be used through `zdd_manager` and `zdd_family` once `zdd_traits` is
+ * specialized for it.  The specialization provides:
+ *
+ * - `node_type`, the native type of a node (or node handle);
+ * - `acquire(m, n)`, which returns a copy of `n` owning one reference;
+ * - `release(m, n)`, which gives up a reference obtained from `acquire` or an operation;
+ * - `num_variables(m)`, `bottom(m)`, `top(m)`, `elementary(m, var)` and `tautology(m)`, which
+ *   return nodes *without* giving a reference to the caller;
+ * - the operations `union_`, `intersection`, `difference`, `join`, `meet`, `nonsubsets`,
+ *   `nonsupersets`, `maximal`, `edivide` and `choose`, which return nodes owning a reference;
+ * - `count_nodes(m, n)`, `count_sets(m, n)` and `foreach_set(m, n, fn)`.
+ *
+ * Specializations are provided for `zdd_base` and `cudd::cudd_zdd`.
+ */
+template<class Manager>
+struct zdd_traits;
+
+template<>
+struct zdd_traits<zdd_base> {
+	using node_type = zdd_base::node_index;
+
+	/* Terminals are counted like the other nodes, since operations return them referenced.
+	 * `aborted()` is not a node and owns no reference. */
+	static node_type acquire(zdd_base& m, node_type n)
+	{
+		return n == m.aborted() ? n : m.ref(n);
+	}
+
+	static void release(zdd_base& m, node_type n)
+	{
+		if (n != m.aborted()) {
+			m.deref(n);
+		}
+	}
+
+	static uint32_t num_variables(zdd_base const& m)
+	{
+		return m.num_variables();
+	}
+
+	static node_type bottom(zdd_base& m)
+	{
+		return m.bottom();
+	}
+
+	static node_type top(zdd_base& m)
+	{
+		return m.top();
+	}
+
+	static node_type elementary(zdd_base& m, uint32_t var)
+	{
+		return m.elementary(var);
+	}
+
+	static node_type tautology(zdd_base& m)
+	{
+		return m.tautology();
+	}
+
+	static node_type union_(zdd_base& m, node_type f, node_type g)
+	{
+		return m.union_(f, g);
+	}
+
+	static node_type intersection(zdd_base& m, node_type f, node_type g)
+	{
+		return m.intersection(f, g);
+	}
+
+	static node_type difference(zdd_base& m, node_type f, node_type g)
+	{
+		return m.difference(f, g);
+	}
+
+	static node_type join(zdd_base& m, node_type f, node_type g)
+	{
+		return m.join(f, g);
+	}
+
+	static node_type meet(zdd_base& m, node_type f, node_type g)
+	{
+		return m.meet(f, g);
+	}
+
+	static node_type nonsubsets(zdd_base& m, node_type f, node_type g)
+	{
+		return m.nonsubsets(f, g);
+	}
+
+	static node_type nonsupersets(zdd_base& m, node_type f, node_type g)
+	{
+		return m.nonsupersets(f, g);
+	}
+
+	static node_type maximal(zdd_base& m, node_type f)
+	{
+		return m.maximal(f);
+	}
+
+	static node_type edivide(zdd_base& m, node_type f, node_type g)
+	{
+		return m.edivide(f, g);
+	}
+
+	static node_type choose(zdd_base& m, node_type f, uint32_t k)
+	{
+		return m.choose(f, k);
+	}
+
+	static uint64_t count_nodes(zdd_base const& m, node_type f)
+	{
+		return m.count_nodes(f);
+	}
+
+	static uint64_t count_sets(zdd_base const& m, node_type f)
+	{
+		return m.count_sets(f);
+	}
+
+	template<class Fn>
+	static void foreach_set(zdd_base const& m, node_type f, Fn&& fn)
+	{
+		m.foreach_set(f, std::forward<Fn>(fn));
+	}
+};
+
+template<>
+struct zdd_traits<cudd::cudd_zdd> {
+	/* `ZDD` objects manage their reference counts themselves */
+	using node_type = ZDD;
+
+	static node_type acquire(cudd::cudd_zdd&, node_type const& n)
+	{
+		return n;
+	}
+
+	static void release(cudd::cudd_zdd&, node_type const&)
+	{}
+
+	static uint32_t num_variables(cudd::cudd_zdd const& m)
+	{
+		return m.num_variables();
+	}
+
+	static node_type bottom(cudd::cudd_zdd& m)
+	{
+		return m.bottom();
+	}
+
+	static node_type top(cudd::cudd_zdd& m)
+	{
+		return m.top();
+	}
+
+	static node_type elementary(cudd::cudd_zdd& m, uint32_t var)
+	{
+		return m.elementary(var);
+	}
+
+	static node_type tautology(cudd::cudd_zdd& m)
+	{
+		return m.tautology();
+	}
+
+	static node_type union_(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.union_(f, g);
+	}
+
+	static node_type intersection(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.intersection(f, g);
+	}
+
+	static node_type difference(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.difference(f, g);
+	}
+
+	static node_type join(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.join(f, g);
+	}
+
+	static node_type meet(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.meet(f, g);
+	}
+
+	static node_type nonsubsets(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.nonsubsets(f, g);
+	}
+
+	static node_type nonsupersets(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.nonsupersets(f, g);
+	}
+
+	static node_type maximal(cudd::cudd_zdd& m, node_type const& f)
+	{
+		return m.maximal(f);
+	}
+
+	static node_type edivide(cudd::cudd_zdd& m, node_type const& f, node_type const& g)
+	{
+		return m.edivide(f, g);
+	}
+
+	static node_type choose(cudd::cudd_zdd& m, node_type const& f, uint32_t k)
+	{
+		return m.choose(f, k);
+	}
+
+	static uint64_t count_nodes(cudd::cudd_zdd const& m, node_type const& f)
+	{
+		return m.count_nodes(f.getNode());
+	}
+
+	static uint64_t count_sets(cudd::cudd_zdd const& m, node_type const& f)
+	{
+		return m.count_sets(f);
+	}
+
+	template<class Fn>
+	static void foreach_set(cudd::cudd_zdd const& m, node_type const& f, Fn&& fn)
+	{
+		m.foreach_set(f, std::forward<Fn>(fn));
+	}
+};
+
+/*! \brief A family of sets, i.e., a reference-owning handle to a ZDD node.
+ *
+ * Copying a family shares the node and destroying it gives up its reference, hence no manual
+ * reference counting is needed.  Families must be destroyed before their manager.
+ */
+template<class Manager>
+class zdd_family {
+public:
+	using traits = zdd_traits<Manager>;
+	using node_type = typename traits::node_type;
+
+	/*! \brief Wraps `node`, taking over one of its references. */
+	zdd_family(Manager& manager, node_type node)
+	    : manager_(&manager)
+	    , node_(std::move(node))
+	{}
+
+	zdd_family(zdd_family const& other)
+	    : manager_(other.manager_)
+	    , node_(traits::acquire(*other.manager_, other.node_))
+	{}
+
+	zdd_family(zdd_family&& other) noexcept
+	    : manager_(other.manager_)
+	    , node_(traits::acquire(*other.manager_, traits::bottom(*other.manager_)))
+	{
+		std::swap(node_, other.node_);
+	}
+
+	zdd_family& operator=(zdd_family other) noexcept
+	{
+		std::swap(manager_, other.manager_);
+		std::swap(node_, other.node_);
+		return *this;
+	}
+
+	~zdd_family()
+	{
+		traits::release(*manager_, node_);
+	}
+
+	/*! \brief Returns the native node (the handle keeps the reference). */
+	node_type const& node() const
+	{
+		return node_;
+	}
+
+	Manager& manager() const
+	{
+		return *manager_;
+	}
+
+	bool operator==(zdd_family const& other) const
+	{
+		return node_ == other.node_;
+	}
+
+	bool operator!=(zdd_family const& other) const
+	{
+		return !(node_ == other.node_);
+	}
+
+	/*! \brief Returns the number of sets in the family. */
+	uint64_t count_sets() const
+	{
+		return traits::count_sets(*manager_, node_);
+	}
+
+	/*! \brief Returns the number of nodes of the ZDD. */
+	uint64_t count_nodes() const
+	{
+		return traits::count_nodes(*manager_, node_);
+	}
+
+	/*! \brief Calls `fn` on each set (as a `std::vector<uint32_t>`) until it returns `false`. */
+	template<class Fn>
+	void foreach_set(Fn&& fn) const
+	{
+		traits::foreach_set(*manager_, node_, std::forward<Fn>(fn));
+	}
+
+	std::vector<std::vector<uint32_t>> sets_as_vectors() const
+	{
+		std::vector<std::vector<uint32_t>> sets;
+		foreach_set([&](auto const& set) {
+			sets.emplace_back(set);
+			return true;
+		});
+		return sets;
+	}
+
+private:
+	Manager* manager_;
+	node_type node_;
+};
+
+/*! \brief Backend-agnostic ZDD manager.
+ *
+ * Owns a ZDD package (`zdd_base` or `cudd::cudd_zdd`) and exposes its operations on
+ * `zdd_family` handles.  Code written against `zdd_manager<Manager>` runs on any backend:
+ *
+ * \verbatim embed:rst
+   .. code-block:: c++
+
+      template<class Manager>
+      uint64_t count_pairs(zdd_manager<Manager>& zdd)
+      {
+      	auto universe = zdd.bottom();
+      	for (auto var = 0u; var < zdd.num_variables(); ++var) {
+      		universe = universe | zdd.elementary(var);
+      	}
+      	return zdd.choose(universe, 2).count_sets();
+      }
+   \endverbatim
+ */
+template<class Manager>
+class zdd_manager {
+public:
+	using backend_type = Manager;
+	using traits = zdd_traits<Manager>;
+	using family_type = zdd_family<Manager>;
+
+	/*! \brief Constructs the backend with `args` (e.g., the number of variables or an order). */
+	template<class... Args>
+	explicit zdd_manager(Args&&... args)
+	    : backend_(std::forward<Args>(args)...)
+	{}
+
+	zdd_manager(zdd_manager const&) = delete;
+	zdd_manager& operator=(zdd_manager const&) = delete;
+
+	/*! \brief Returns the underlying ZDD package. */
+	backend_type& backend()
+	{
+		return backend_;
+	}
+
+	uint32_t num_variables() const
+	{
+		return traits::num_variables(backend_);
+	}
+
+#pragma region Families
+	/*! \brief Returns the empty family. */
+	family_type bottom()
+	{
+		return borrowed(traits::bottom(backend_));
+	}
+
+	/*! \brief Returns the unit family `{{}}`. */
+	family_type top()
+	{
+		return borrowed(traits::top(backend_));
+	}
+
+	/*! \brief Returns the elementary family `{{var}}`. */
+	family_type elementary(uint32_t var)
+	{
+		return borrowed(traits::elementary(backend_, var));
+	}
+
+	/*! \brief Returns the family of all subsets of the variables. */
+	family_type tautology()
+	{
+		return borrowed(traits::tautology(backend_));
+	}
+
+	/*! \brief Returns the family that contains exactly `sets`. */
+	family_type family(std::vector<std::vector<uint32_t>> const& sets)
+	{
+		auto result = bottom();
+		for (auto const& set : sets) {
+			auto product = top();
+			for (auto const var : set) {
+				product = join(product, elementary(var));
+			}
+			result = union_(result, product);
+		}
+		return result;
+	}
+#pragma endregion
+
+#pragma region Operations
+	family_type union_(family_type const& f, family_type const& g)
+	{
+		return owned(traits::union_(backend_, f.node(), g.node()));
+	}
+
+	family_type intersection(family_type const& f, family_type const& g)
+	{
+		return owned(traits::intersection(backend_, f.node(), g.node()));
+	}
+
+	family_type difference(family_type const& f, family_type const& g)
+	{
+		return owned(traits::difference(backend_, f.node(), g.node()));
+	}
+
+	family_type join(family_type const& f, family_type const& g)
+	{
+		return owned(traits::join(backend_, f.node(), g.node()));
+	}
+
+	family_type meet(family_type const& f, family_type const& g)
+	{
+		return owned(traits::meet(backend_, f.node(), g.node()));
+	}
+
+	family_type nonsubsets(family_type const& f, family_type const& g)
+	{
+		return owned(traits::nonsubsets(backend_, f.node(), g.node()));
+	}
+
+	family_type nonsupersets(family_type const& f, family_type const& g)
+	{
+		return owned(traits::nonsupersets(backend_, f.node(), g.node()));
+	}
+
+	family_type maximal(family_type const& f)
+	{
+		return owned(traits::maximal(backend_, f.node()));
+	}
+
+	family_type edivide(family_type const& f, family_type const& g)
+	{
+		return owned(traits::edivide(backend_, f.node(), g.node()));
+	}
+
+	/*! \brief All `k`-combinations of the elements of `f`, a union of elementary families. */
+	family_type choose(family_type const& f, uint32_t k)
+	{
+		return owned(traits::choose(backend_, f.node(), k));
+	}
+#pragma endregion
+
+private:
+	family_type borrowed(typename traits::node_type const& node)
+	{
+		return family_type(backend_, traits::acquire(backend_, node));
+	}
+
+	family_type owned(typename traits::node_type node)
+	{
+		return family_type(backend_, std::move(node));
+	}
+
+private:
+	backend_type backend_;
+};
+
+#pragma region Operators
+template<class Manager>
+zdd_family<Manager> operator|(zdd_family<Manager> const& f, zdd_family<Manager> const& g)
+{
+	using traits = zdd_traits<Manager>;
+	return zdd_family<Manager>(f.manager(), traits::union_(f.manager(), f.node(), g.node()));
+}
+
+template<class Manager>
+zdd_family<Manager> operator&(zdd_family<Manager> const& f, zdd_family<Manager> const& g)
+{
+	using traits = zdd_traits<Manager>;
+	return zdd_family<Manager>(f.manager(), traits::intersection(f.manager(), f.node(), g.node()));
+}
+
+template<class Manager>
+zdd_family<Manager> operator-(zdd_family<Manager> const& f, zdd_family<Manager> const& g)
+{
+	using traits = zdd_traits<Manager>;
+	return zdd_family<Manager>(f.manager(), traits::difference(f.manager(), f.node(), g.node()));
+}
+
+template<class Manager>
+zdd_family<Manager> operator*(zdd_family<Manager> const& f, zdd_family<Manager> const& g)
+{
+	using traits = zdd_traits<Manager>;
+	return zdd_family<Manager>(f.manager(), traits::join(f.manager(), f.node(), g.node()));
+}
+#pragma endregion
+
+/*! \brief ZDD packages that can be selected at run time. */
+enum class zdd_backend {
+	bill,
+	cudd,
+};
+
+/*! \brief Runs `fn` on a fresh `zdd_manager` of the selected backend.
+ *
+ * `fn` is a generic callable, e.g., a lambda taking `auto& zdd`, and is instantiated for
+ * every backend; hence it must return the same type for all of them.
+ *
+ * \param backend ZDD package to use
+ * \param num_vars Number of variables
+ * \param fn Workload, called with a `zdd_manager<Manager>&`
+ */
+template<class Fn>
+auto with_zdd_manager(zdd_backend backend, uint32_t num_vars, Fn&& fn)
+{
+	switch (backend) {
+	case zdd_backend::cudd: {
+		zdd_manager<cudd::cudd_zdd> manager(num_vars);
+		return fn(manager);
+	}
+	case zdd_backend::bill:
+	default: {
+		zdd_manager<zdd_base> manager(num_vars);
+		return fn(manager);
+	}
+	}
+}
+
+} // namespace bill
@@ -0,0 +1,116 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace bill {
+
+/*! \brief Operations of the ZDD family algebra, as counted in `zdd_stats`. */
+enum class zdd_operation : uint32_t {
+	choose,
+	difference,
+	edivide,
+	intersection,
+	join,
+	maximal,
+	meet,
+	nonsubsets,
+	nonsupersets,
+	union_,
+	num_operations
+};
+
+inline char const* zdd_operation_name(zdd_operation op)
+{
+	constexpr std::array<char const*, uint32_t(zdd_operation::num_operations)> names = {
+	    "choose", "difference",   "edivide",    "intersection", "join",
+	    "maximal", "meet",        "nonsubsets", "nonsupersets", "union"};
+	return names.at(uint32_t(op));
+}
+
+/*! \brief Counters of one operation. */
+struct zdd_operation_stats {
+	/*! \brief Number of calls, including recursive ones */
+	uint64_t calls = 0u;
+	/*! \brief Number of computed table lookups */
+	uint64_t cache_lookups = 0u;
+	/*! \brief Number of computed table lookups that did not find the result */
+	uint64_t cache_misses = 0u;
+
+	double hit_rate() const
+	{
+		return cache_lookups == 0u ? 0.0 : double(cache_lookups - cache_misses) / cache_lookups;
+	}
+};
+
+/*! \brief Statistics of a ZDD manager.
+ *
+ * Returned by `zdd_base::stats()` and `cudd::cudd_zdd::stats()`.  Counters accumulate since
+ * the construction of the manager or the last call to `reset_stats()`.  Values a manager does
+ * not track are zero.
+ */
+struct zdd_stats {
+	/*! \brief Counters per operation, indexed by `zdd_operation` */
+	std::array<zdd_operation_stats, uint32_t(zdd_operation::num_operations)> operations;
+
+	/*! \brief Total number of computed table lookups */
+	uint64_t cache_lookups = 0u;
+	/*! \brief Total number of computed table lookups that did not find the result */
+	uint64_t cache_misses = 0u;
+	/*! \brief Number of results stored in the computed table */
+	uint64_t cache_entries = 0u;
+	/*! \brief Number of slots (buckets) of the computed table */
+	uint64_t cache_slots = 0u;
+
+	/*! \brief Number of live nodes */
+	uint64_t num_nodes = 0u;
+	/*! \brief Number of dead nodes, not recycled yet */
+	uint64_t num_dead_nodes = 0u;
+	/*! \brief Peak number of nodes */
+	uint64_t peak_nodes = 0u;
+	/*! \brief Number of nodes in the unique table */
+	uint64_t unique_entries = 0u;
+	/*! \brief Number of slots (buckets) of the unique table */
+	uint64_t unique_slots = 0u;
+
+	/*! \brief Number of garbage collections */
+	uint64_t num_garbage_collections = 0u;
+	/*! \brief Time spent in garbage collection, in milliseconds */
+	double garbage_collection_time = 0.0;
+
+	/*! \brief Number of variable reorderings */
+	uint64_t num_reorderings = 0u;
+	/*! \brief Time spent reordering, in milliseconds */
+	double reordering_time = 0.0;
+
+	/*! \brief Memory in use, in bytes */
+	uint64_t memory_in_use = 0u;
+	/*! \brief Peak memory, in bytes */
+	uint64_t peak_memory = 0u;
+
+	zdd_operation_stats const& operation(zdd_operation op) const
+	{
+		return operations.at(uint32_t(op));
+	}
+
+	double hit_rate() const
+	{
+		return cache_lookups == 0u ? 0.0 : double(cache_lookups - cache_misses) / cache_lookups;
+	}
+
+	double unique_load_factor() const
+	{
+		return unique_slots == 0u ? 0.0 : double(unique_entries) / unique_slots;
+	}
+
+	double cache_load_factor() const
+	{
+		return cache_slots == 0u ? 0.0 : double(cache_entries) / cache_slots;
+	}
+};
+
+} // namespace bill
@@ -0,0 +1,369 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "interface/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Parameters of a `clause_exchange` */
+struct clause_exchange_params {
+	/*! \brief Longest clause that is shared */
+	uint32_t max_size = 16u;
+
+	/*! \brief Highest LBD of a shared clause (units have LBD 1) */
+	uint32_t max_lbd = 4u;
+
+	/*! \brief Clauses buffered per participant, rounded up to a power of two (at least 4) */
+	uint32_t capacity = 4096u;
+
+	/*! \brief Makes the imported clauses independent of thread timing */
+	bool deterministic = false;
+};
+
+/*! \brief Exchange of learnt clauses between solvers that run in parallel.
+ *
+ * Every participant owns a ring buffer which only it writes, hence exporting a clause never
+ * waits and never locks.  Importers keep one read position per ring; when a writer laps a slow
+ * reader, the overwritten clauses are lost to that reader (the read is validated like a
+ * seqlock).  Only clauses with at most `max_size` literals and an LBD of at most `max_lbd` are
+ * shared.
+ *
+ * Solvers attach with `share_clauses` (`glucose_41`, `ghack` and `maple`), export clauses when
+ * they learn them, and import at restarts.  All participants must solve the same formula over
+ * the same variables, since learnt clauses are implied by the formula of their solver.
+ *
+ * In deterministic mode, imports are synchronized: the i-th import of a participant reads the
+ * clauses that every other participant exported before its own i-th import, and waits for the
+ * slower ones.  A solver thus imports the same clauses at the same restarts in every run, as
+ * long as no participant is interrupted.  This requires that every participant takes part in
+ * every call to `solve`, that these calls run concurrently, and that each call ends before any
+ * participant starts the next one (as in `portfolio_solver`).  A participant exports at most
+ * `capacity / 2 - 1` clauses between two imports.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      clause_exchange exchange(2u);
+      solver<solvers::glucose_41> first;
+      solver<solvers::maple> second;
+      first.share_clauses(exchange);
+      second.share_clauses(exchange);
+      // add the same clauses to both, then solve them on two threads
+   \endverbatim
+ */
+class clause_exchange {
+	struct participant {
+		participant(uint64_t num_words, uint32_t num_participants)
+		    : slots(num_words)
+		    , cursors(num_participants, 0u)
+		{}
+
+		/* ring of clauses: size, LBD and `max_size` literals per slot */
+		std::vector<std::atomic<uint32_t>> slots;
+		/* number of clauses written so far */
+		alignas(64) std::atomic<uint64_t> head{0u};
+
+		/* deterministic mode: rounds (calls to solve) entered and left, imports in this
+		 * round, and the head at each import and at the end of the round */
+		std::atomic<uint64_t> rounds_entered{0u};
+		std::atomic<uint64_t> rounds_left{0u};
+		std::atomic<uint64_t> epoch{0u};
+		std::atomic<uint64_t> marks[4] = {};
+		std::atomic<uint64_t> final_head{0u};
+
+		/* owned by the thread of the participant */
+		alignas(64) std::vector<uint64_t> cursors;
+		std::vector<lit_type> clause;
+		uint64_t num_epoch_exports = 0u;
+		uint64_t num_exported = 0u;
+		uint64_t num_imported = 0u;
+	};
+
+public:
+	/*! \brief Enters a round of `exchange` during its lifetime; does nothing for `nullptr` */
+	class scoped_round {
+	public:
+		scoped_round(clause_exchange* exchange, uint32_t id)
+		    : exchange_(exchange)
+		    , id_(id)
+		{
+			if (exchange_) {
+				exchange_->enter_round(id_);
+			}
+		}
+
+		~scoped_round()
+		{
+			if (exchange_) {
+				exchange_->leave_round(id_);
+			}
+		}
+
+		scoped_round(scoped_round const&) = delete;
+		scoped_round& operator=(scoped_round const&) = delete;
+
+	private:
+		clause_exchange* exchange_;
+		uint32_t id_;
+	};
+
+#pragma region Constructors
+	explicit clause_exchange(uint32_t num_participants,
+	                         clause_exchange_params const& params = {})
+	    : params_(params)
+	    , stride_(params.max_size + 2u)
+	{
+		assert(num_participants > 0u);
+		capacity_ = 4u;
+		while (capacity_ < params_.capacity) {
+			capacity_ <<= 1;
+		}
+		for (auto i = 0u; i < num_participants; ++i) {
+			participants_.emplace_back(
+			    std::make_unique<participant>(uint64_t(capacity_) * stride_, num_participants));
+		}
+	}
+
+	/* disallow copying */
+	clause_exchange(clause_exchange const&) = delete;
+	clause_exchange& operator=(clause_exchange const&) = delete;
+#pragma endregion
+
+#pragma region Participants
+	/*! \brief Takes a participant slot and returns its identifier. */
+	uint32_t join()
+	{
+		auto const id = num_joined_.fetch_add(1u);
+		assert(id < participants_.size());
+		return id;
+	}
+
+	/*! \brief Makes participant `id` ignore the clauses exported so far.
+	 *
+	 * Solvers call it when their formula is replaced (`restart`), since these clauses may not
+	 * be implied by the new formula.  The other participants must restart as well.
+	 */
+	void restart(uint32_t id)
+	{
+		auto& self = *participants_.at(id);
+		for (auto j = 0u; j < participants_.size(); ++j) {
+			self.cursors[j] = participants_[j]->head.load(std::memory_order_acquire);
+		}
+	}
+
+	/*! \brief Starts a call to `solve` of participant `id`. */
+	void enter_round(uint32_t id)
+	{
+		auto& self = *participants_.at(id);
+		if (!params_.deterministic) {
+			return;
+		}
+		/* rounds do not overlap, hence the clauses of earlier rounds that were not imported are
+		 * skipped by all participants alike */
+		for (auto j = 0u; j < participants_.size(); ++j) {
+			self.cursors[j] = participants_[j]->final_head.load(std::memory_order_acquire);
+		}
+		self.epoch.store(0u, std::memory_order_relaxed);
+		self.num_epoch_exports = 0u;
+		self.rounds_entered.fetch_add(1u, std::memory_order_release);
+	}
+
+	/*! \brief Ends a call to `solve` of participant `id`. */
+	void leave_round(uint32_t id)
+	{
+		auto& self = *participants_.at(id);
+		if (!params_.deterministic) {
+			return;
+		}
+		self.final_head.store(self.head.load(std::memory_order_relaxed),
+		                      std::memory_order_release);
+		self.rounds_left.fetch_add(1u, std::memory_order_release);
+	}
+#pragma endregion
+
+#pragma region Exchange
+	/*! \brief Returns whether a clause of `size` literals and LBD `lbd` is shared. */
+	bool accepts(uint32_t size, uint32_t lbd) const
+	{
+		return size <= params_.max_size && lbd <= params_.max_lbd;
+	}
+
+	/*! \brief Publishes a learnt clause of participant `id`, if it is accepted. */
+	bool export_clause(uint32_t id, lit_type const* begin, lit_type const* end, uint32_t lbd)
+	{
+		auto const size = static_cast<uint32_t>(end - begin);
+		if (!accepts(size, lbd)) {
+			return false;
+		}
+		auto& self = *participants_.at(id);
+		if (params_.deterministic) {
+			/* a reader may lag one import behind, two batches must fit into the ring (which
+			 * keeps `capacity - 1` clauses safe from the next write) */
+			if (self.num_epoch_exports == capacity_ / 2u - 1u) {
+				return false;
+			}
+			++self.num_epoch_exports;
+		}
+		auto const head = self.head.load(std::memory_order_relaxed);
+		/* a reader that sees one of the writes below also sees that `head` reached the
+		 * overwritten clause */
+		std::atomic_thread_fence(std::memory_order_release);
+		auto* const slot = &self.slots[(head & (capacity_ - 1u)) * stride_];
+		slot[0].store(size, std::memory_order_relaxed);
+		slot[1].store(lbd, std::memory_order_relaxed);
+		for (auto i = 0u; i < size; ++i) {
+			uint32_t word;
+			std::memcpy(&word, begin + i, sizeof(word));
+			slot[2u + i].store(word, std::memory_order_relaxed);
+		}
+		self.head.store(head + 1u, std::memory_order_release);
+		++self.num_exported;
+		return true;
+	}
+
+	/*! \brief Passes the clauses exported by the other participants to `fn`.
+	 *
+	 * `fn(begin, end, lbd)` returns false to stop, e.g., when a clause is falsified.  In
+	 * deterministic mode, `stop()` is polled while waiting for slower participants.
+	 *
+	 * \return false if `fn` returned false
+	 */
+	template<typename Fn, typename Stop>
+	bool import_clauses(uint32_t id, Fn&& fn, Stop&& stop)
+	{
+		auto& self = *participants_.at(id);
+		uint64_t epoch = 0u;
+		if (params_.deterministic) {
+			epoch = self.epoch.load(std::memory_order_relaxed) + 1u;
+			self.marks[epoch % 4u].store(self.head.load(std::memory_order_relaxed),
+			                             std::memory_order_relaxed);
+			self.epoch.store(epoch, std::memory_order_release);
+			self.num_epoch_exports = 0u;
+		}
+		for (auto j = 0u; j < participants_.size(); ++j) {
+			if (j == id) {
+				continue;
+			}
+			uint64_t limit;
+			if (!params_.deterministic) {
+				limit = participants_[j]->head.load(std::memory_order_acquire);
+			} else if (!wait_for(self, *participants_[j], epoch, limit, stop)) {
+				return true;
+			}
+			if (!read(self, j, limit, fn)) {
+				return false;
+			}
+		}
+		return true;
+	}
+#pragma endregion
+
+#pragma region Properties
+	uint32_t num_participants() const
+	{
+		return participants_.size();
+	}
+
+	clause_exchange_params const& params() const
+	{
+		return params_;
+	}
+
+	/*! \brief Clauses exported by participant `id` (read it while no solver runs) */
+	uint64_t num_exported(uint32_t id) const
+	{
+		return participants_.at(id)->num_exported;
+	}
+
+	/*! \brief Clauses imported by participant `id` (read it while no solver runs) */
+	uint64_t num_imported(uint32_t id) const
+	{
+		return participants_.at(id)->num_imported;
+	}
+#pragma endregion
+
+private:
+	/* Finds the end of the clauses of `other` that `self` imports at `epoch` */
+	template<typename Stop>
+	bool wait_for(participant const& self, participant const& other, uint64_t epoch,
+	              uint64_t& limit, Stop&& stop) const
+	{
+		auto const round = self.rounds_entered.load(std::memory_order_relaxed);
+		for (;;) {
+			/* the epoch of a participant that left the round does not change anymore */
+			if (other.rounds_left.load(std::memory_order_acquire) >= round) {
+				limit = other.epoch.load(std::memory_order_relaxed) >= epoch ?
+				            other.marks[epoch % 4u].load(std::memory_order_relaxed) :
+				            other.final_head.load(std::memory_order_relaxed);
+				return true;
+			}
+			if (other.rounds_entered.load(std::memory_order_acquire) >= round
+			    && other.epoch.load(std::memory_order_acquire) >= epoch) {
+				limit = other.marks[epoch % 4u].load(std::memory_order_relaxed);
+				return true;
+			}
+			if (stop()) {
+				return false;
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	/* Reads the ring of participant `j` up to `limit`; false if `fn` returned false */
+	template<typename Fn>
+	bool read(participant& self, uint32_t j, uint64_t limit, Fn&& fn)
+	{
+		auto& other = *participants_[j];
+		auto cursor = self.cursors[j];
+		if (limit >= cursor + capacity_) {
+			cursor = limit - capacity_ + 1u;
+		}
+		auto falsified = false;
+		while (cursor < limit && !falsified) {
+			auto const* const slot = &other.slots[(cursor & (capacity_ - 1u)) * stride_];
+			auto const size = std::min(slot[0].load(std::memory_order_relaxed), params_.max_size);
+			auto const lbd = slot[1].load(std::memory_order_relaxed);
+			self.clause.resize(size);
+			for (auto i = 0u; i < size; ++i) {
+				self.clause[i] = lit_type::from_raw(slot[2u + i].load(std::memory_order_relaxed));
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			auto const head = other.head.load(std::memory_order_relaxed);
+			if (head - cursor >= capacity_) {
+				/* the writer lapped us while reading, skip what it may overwrite */
+				assert(!params_.deterministic);
+				cursor = head - capacity_ + 1u;
+				continue;
+			}
+			++self.num_imported;
+			++cursor;
+			falsified = !fn(self.clause.data(), self.clause.data() + size, lbd);
+		}
+		self.cursors[j] = cursor;
+		return !falsified;
+	}
+
+private:
+	clause_exchange_params params_;
+	uint32_t stride_;
+	uint32_t capacity_;
+	std::atomic<uint32_t> num_joined_{0u};
+	std::vector<std::unique_ptr<participant>> participants_;
+};
+
+} // namespace bill
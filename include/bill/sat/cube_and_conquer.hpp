@@ -0,0 +1,679 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Parameters of `cube_and_conquer_solver` */
+struct cube_and_conquer_params {
+	/*! \brief Number of conquer threads (0: one per hardware thread) */
+	uint32_t num_threads = 0u;
+
+	/*! \brief Number of decisions per cube (0: log2 of the number of threads, plus 4) */
+	uint32_t cube_depth = 0u;
+
+	/*! \brief Variables probed per lookahead node, the most frequent free ones */
+	uint32_t num_candidates = 32u;
+
+	/*! \brief Conflict limit per cube (0 for no limit) */
+	uint32_t conflict_limit = 0u;
+};
+
+namespace detail {
+
+/* Unit propagation with two watched literals, for lookahead */
+class lookahead_propagator {
+public:
+	lookahead_propagator(clause_batch const& clauses, uint32_t num_variables)
+	    : values_(num_variables, lbool_type::undefined)
+	    , watches_(2u * num_variables)
+	    , occurrences_(num_variables, 0u)
+	{
+		/* a copy, since propagation reorders the literals of the clauses */
+		literals_.reserve(clauses.num_literals());
+		offsets_.reserve(clauses.num_clauses() + 1u);
+		offsets_.emplace_back(0u);
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			literals_.insert(literals_.end(), clauses.begin(i), clauses.end(i));
+			offsets_.emplace_back(literals_.size());
+			for (auto it = clauses.begin(i); it != clauses.end(i); ++it) {
+				++occurrences_[it->variable()];
+			}
+			auto const size = clauses.end(i) - clauses.begin(i);
+			if (size == 0) {
+				ok_ = false;
+			} else if (size == 1) {
+				units_.emplace_back(*clauses.begin(i));
+			} else {
+				watches_[index(*clauses.begin(i))].emplace_back(i);
+				watches_[index(*(clauses.begin(i) + 1))].emplace_back(i);
+			}
+		}
+	}
+
+	/*! \brief Assigns the unit clauses; false if the clauses are refuted this way */
+	bool initialize()
+	{
+		for (auto const unit : units_) {
+			if (!assign(unit)) {
+				ok_ = false;
+			}
+		}
+		return ok_ && propagate();
+	}
+
+	lbool_type value(lit_type lit) const
+	{
+		auto const value = values_[lit.variable()];
+		if (value == lbool_type::undefined || !lit.is_complemented()) {
+			return value;
+		}
+		return value == lbool_type::true_ ? lbool_type::false_ : lbool_type::true_;
+	}
+
+	/*! \brief Makes `lit` true; false if it is false */
+	bool assign(lit_type lit)
+	{
+		auto const current = value(lit);
+		if (current != lbool_type::undefined) {
+			return current == lbool_type::true_;
+		}
+		values_[lit.variable()] = lit.is_complemented() ? lbool_type::false_ : lbool_type::true_;
+		trail_.emplace_back(lit);
+		return true;
+	}
+
+	/*! \brief Propagates the assignments of the trail; false on a conflict */
+	bool propagate()
+	{
+		while (head_ < trail_.size()) {
+			auto const falsified = ~trail_[head_++];
+			auto& watches = watches_[index(falsified)];
+			auto kept = 0u;
+			auto conflict = false;
+			for (auto w = 0u; w < watches.size(); ++w) {
+				auto const clause = watches[w];
+				if (conflict) {
+					watches[kept++] = clause;
+					continue;
+				}
+				/* the watched literals are the first two, `falsified` goes second */
+				auto* const lits = &literals_[offsets_[clause]];
+				auto const size = offsets_[clause + 1u] - offsets_[clause];
+				if (lits[0] == falsified) {
+					std::swap(lits[0], lits[1]);
+				}
+				if (value(lits[0]) == lbool_type::true_) {
+					watches[kept++] = clause;
+					continue;
+				}
+				auto moved = false;
+				for (auto k = 2u; k < size; ++k) {
+					if (value(lits[k]) != lbool_type::false_) {
+						std::swap(lits[1], lits[k]);
+						watches_[index(lits[1])].emplace_back(clause);
+						moved = true;
+						break;
+					}
+				}
+				if (moved) {
+					continue;
+				}
+				watches[kept++] = clause;
+				if (!assign(lits[0])) {
+					conflict = true;
+				}
+			}
+			watches.resize(kept);
+			if (conflict) {
+				head_ = trail_.size();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/*! \brief Undoes the assignments after the first `size` ones of the trail */
+	void backtrack(uint64_t size)
+	{
+		while (trail_.size() > size) {
+			values_[trail_.back().variable()] = lbool_type::undefined;
+			trail_.pop_back();
+		}
+		head_ = std::min<uint64_t>(head_, size);
+	}
+
+	uint64_t trail_size() const
+	{
+		return trail_.size();
+	}
+
+	uint32_t num_variables() const
+	{
+		return values_.size();
+	}
+
+	/*! \brief Number of clauses in which a variable occurs */
+	uint32_t occurrences(uint32_t var) const
+	{
+		return occurrences_[var];
+	}
+
+private:
+	static uint32_t index(lit_type lit)
+	{
+		return 2u * lit.variable() + (lit.is_complemented() ? 1u : 0u);
+	}
+
+private:
+	std::vector<lit_type> literals_;
+	std::vector<uint64_t> offsets_;
+	std::vector<lbool_type> values_;
+	std::vector<std::vector<uint32_t>> watches_;
+	std::vector<uint32_t> occurrences_;
+	std::vector<lit_type> units_;
+	std::vector<lit_type> trail_;
+	uint64_t head_ = 0u;
+	bool ok_ = true;
+};
+
+} // namespace detail
+
+/*! \brief Cube-and-conquer parallel solving over any `solver<>` backend.
+ *
+ * The problem is split into cubes, i.e., conjunctions of literals, by lookahead: at each node,
+ * the most frequent free variables are probed in both polarities with unit propagation, the
+ * variable with the largest product of implied assignments is branched on, and failed literals
+ * are fixed on the way.  Cubes that propagation refutes are dropped.
+ *
+ * The cubes are then solved as `solve(assumptions)` calls on one backend instance per thread.
+ * Each thread works off its own share of the cubes, in the order of the split, and steals from
+ * the end of the other shares when it runs out.  The core of an unsatisfiable cube prunes all
+ * later cubes that contain it, and is added to the formula of the thread that found it.  For
+ * backends without cores (see `get_core`), the whole cube is used.  The first satisfiable cube
+ * stops the other threads through their interrupt flags.
+ *
+ * The backends keep their state between calls to `solve`; clauses added in between are passed
+ * to them at the next call.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      cube_and_conquer_params params;
+      params.num_threads = 8u;
+      cube_and_conquer_solver<solver<solvers::glucose_41>> solver(params);
+      solver.add_variables(n);
+      solver.add_clauses(clauses);
+      if (solver.solve() == result::states::satisfiable) {
+        auto const model = solver.get_model().model();
+      }
+   \endverbatim
+ */
+template<typename Solver = solver<>>
+class cube_and_conquer_solver {
+	/* Cubes of one thread: the owner takes from the front, thieves from the back */
+	struct cube_queue {
+		std::mutex mutex;
+		std::deque<std::vector<lit_type>> cubes;
+	};
+
+public:
+#pragma region Constructors
+	explicit cube_and_conquer_solver(cube_and_conquer_params const& params = {})
+	    : params_(params)
+	{
+		if (params_.num_threads == 0u) {
+			params_.num_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		if (params_.cube_depth == 0u) {
+			auto log2 = 0u;
+			while ((1u << log2) < params_.num_threads) {
+				++log2;
+			}
+			params_.cube_depth = log2 + 4u;
+		}
+		for (auto i = 0u; i < params_.num_threads; ++i) {
+			solvers_.emplace_back(std::make_unique<Solver>());
+			queues_.emplace_back(std::make_unique<cube_queue>());
+		}
+		num_ingested_.resize(params_.num_threads, 0u);
+		num_ingested_variables_.resize(params_.num_threads, 0u);
+	}
+
+	/* disallow copying */
+	cube_and_conquer_solver(cube_and_conquer_solver const&) = delete;
+	cube_and_conquer_solver& operator=(cube_and_conquer_solver const&) = delete;
+#pragma endregion
+
+#pragma region Modifiers
+	void restart()
+	{
+		for (auto& solver : solvers_) {
+			solver->restart();
+		}
+		std::fill(num_ingested_.begin(), num_ingested_.end(), 0u);
+		std::fill(num_ingested_variables_.begin(), num_ingested_variables_.end(), 0u);
+		clauses_.clear();
+		num_variables_ = 0u;
+		winner_ = -1;
+		state_ = result::states::undefined;
+	}
+
+	var_type add_variable()
+	{
+		return num_variables_++;
+	}
+
+	void add_variables(uint32_t num_variables = 1)
+	{
+		num_variables_ += num_variables;
+	}
+
+	template<typename Iterator>
+	bool add_clause(Iterator it, Iterator ie)
+	{
+		clauses_.add_clause(it, ie);
+		state_ = result::states::dirty;
+		return true;
+	}
+
+	bool add_clause(std::vector<lit_type> const& clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clause(std::initializer_list<lit_type> clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clause(lit_type lit)
+	{
+		lit_type const* const begin = &lit;
+		return add_clause(begin, begin + 1);
+	}
+
+	bool add_clauses(clause_batch const& clauses)
+	{
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			add_clause(clauses.begin(i), clauses.end(i));
+		}
+		return true;
+	}
+
+	bool add_clauses(std::vector<std::vector<lit_type>> const& clauses)
+	{
+		for (auto const& clause : clauses) {
+			add_clause(clause);
+		}
+		return true;
+	}
+
+	result get_model() const
+	{
+		assert(state_ == result::states::satisfiable);
+		return solvers_.at(winner_)->get_model();
+	}
+
+	result get_result() const
+	{
+		assert(state_ != result::states::dirty);
+		if (state_ == result::states::satisfiable) {
+			return get_model();
+		}
+		return result(state_);
+	}
+
+	/*! \brief Splits the problem into cubes and solves them in parallel.
+	 *
+	 * \param assumptions Assumptions of this call, added to every cube
+	 * \return `undefined` if no cube is satisfiable but some reached the conflict limit
+	 */
+	result::states solve(std::vector<lit_type> const& assumptions = {})
+	{
+		winner_ = -1;
+		num_cubes_ = num_refuted_cubes_ = 0u;
+		num_pruned_cubes_ = 0u;
+		if (!split(assumptions)) {
+			return state_ = result::states::unsatisfiable;
+		}
+		cores_.clear();
+		for (auto& solver : solvers_) {
+			solver->clear_interrupt();
+		}
+
+		std::atomic<int32_t> winner{-1};
+		std::atomic<bool> refuted{false};
+		std::atomic<bool> incomplete{false};
+		std::atomic<uint32_t> num_pruned{0u};
+		auto run = [&](uint32_t index) {
+			auto& solver = *solvers_.at(index);
+			ingest(index);
+			std::vector<lit_type> cube;
+			std::vector<lit_type> literals;
+			while (winner.load() < 0 && !refuted.load() && take(index, cube)) {
+				literals = assumptions;
+				literals.insert(literals.end(), cube.begin(), cube.end());
+				if (is_pruned(literals)) {
+					++num_pruned;
+					continue;
+				}
+				auto const state = solver.solve(literals, params_.conflict_limit);
+				if (state == result::states::satisfiable) {
+					int32_t expected = -1;
+					if (winner.compare_exchange_strong(expected, static_cast<int32_t>(index))) {
+						interrupt_others(index);
+					}
+				} else if (state == result::states::unsatisfiable) {
+					if (!learn_core(solver, literals)) {
+						refuted = true;
+						interrupt_others(index);
+					}
+				} else if (winner.load() < 0 && !refuted.load()) {
+					incomplete = true;
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(solvers_.size() - 1u);
+		for (auto i = 1u; i < solvers_.size(); ++i) {
+			threads.emplace_back(run, i);
+		}
+		run(0u);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		for (auto& queue : queues_) {
+			queue->cubes.clear();
+		}
+		num_pruned_cubes_ = num_pruned.load();
+
+		winner_ = winner.load();
+		if (winner_ >= 0) {
+			state_ = result::states::satisfiable;
+		} else if (refuted.load() || !incomplete.load()) {
+			state_ = result::states::unsatisfiable;
+		} else {
+			state_ = result::states::undefined;
+		}
+		return state_;
+	}
+#pragma endregion
+
+#pragma region Properties
+	uint32_t num_variables() const
+	{
+		return num_variables_;
+	}
+
+	uint32_t num_clauses() const
+	{
+		return clauses_.num_clauses();
+	}
+
+	uint32_t num_threads() const
+	{
+		return params_.num_threads;
+	}
+
+	/*! \brief Cubes of the last call to `solve`, without those refuted by lookahead */
+	uint32_t num_cubes() const
+	{
+		return num_cubes_;
+	}
+
+	/*! \brief Cubes of the last call to `solve` that lookahead refuted */
+	uint32_t num_refuted_cubes() const
+	{
+		return num_refuted_cubes_;
+	}
+
+	/*! \brief Cubes of the last call to `solve` that the cores of other cubes pruned */
+	uint32_t num_pruned_cubes() const
+	{
+		return num_pruned_cubes_;
+	}
+#pragma endregion
+
+private:
+	/* Splits the problem by lookahead and distributes the cubes; false if it is refuted */
+	bool split(std::vector<lit_type> const& assumptions)
+	{
+		detail::lookahead_propagator propagator(clauses_, num_variables_);
+		if (!propagator.initialize()) {
+			return false;
+		}
+		for (auto const lit : assumptions) {
+			if (!propagator.assign(lit)) {
+				return false;
+			}
+		}
+		if (!propagator.propagate()) {
+			return false;
+		}
+
+		candidates_.resize(num_variables_);
+		for (auto i = 0u; i < num_variables_; ++i) {
+			candidates_[i] = i;
+		}
+		std::stable_sort(candidates_.begin(), candidates_.end(), [&](uint32_t a, uint32_t b) {
+			return propagator.occurrences(a) > propagator.occurrences(b);
+		});
+
+		std::vector<std::vector<lit_type>> cubes;
+		std::vector<lit_type> cube;
+		split(propagator, cube, 0u, cubes);
+		num_cubes_ = cubes.size();
+		if (cubes.empty()) {
+			return false;
+		}
+
+		/* contiguous shares keep similar cubes on the same thread */
+		auto const share = (cubes.size() + queues_.size() - 1u) / queues_.size();
+		for (auto i = 0u; i < cubes.size(); ++i) {
+			queues_.at(i / share)->cubes.emplace_back(std::move(cubes[i]));
+		}
+		return true;
+	}
+
+	void split(detail::lookahead_propagator& propagator, std::vector<lit_type>& cube,
+	           uint32_t depth, std::vector<std::vector<lit_type>>& cubes)
+	{
+		auto const trail_size = propagator.trail_size();
+		auto const cube_size = cube.size();
+		auto restore = [&]() {
+			propagator.backtrack(trail_size);
+			cube.resize(cube_size);
+		};
+		auto probe = [&](lit_type lit, uint64_t& num_implied) {
+			auto const before = propagator.trail_size();
+			propagator.assign(lit);
+			auto const ok = propagator.propagate();
+			num_implied = propagator.trail_size() - before;
+			propagator.backtrack(before);
+			return ok;
+		};
+		auto fix = [&](lit_type lit) {
+			cube.emplace_back(lit);
+			propagator.assign(lit);
+			return propagator.propagate();
+		};
+
+		int64_t best = -1;
+		uint64_t best_score = 0u;
+		if (depth < params_.cube_depth) {
+			auto num_probed = 0u;
+			for (auto const var : candidates_) {
+				if (num_probed == params_.num_candidates) {
+					break;
+				}
+				if (propagator.value(lit_type(var)) != lbool_type::undefined) {
+					continue;
+				}
+				++num_probed;
+				uint64_t positive = 0u, negative = 0u;
+				auto const positive_ok = probe(lit_type(var, positive_polarity), positive);
+				auto const negative_ok = probe(lit_type(var, negative_polarity), negative);
+				if (!positive_ok || !negative_ok) {
+					/* failed literal */
+					if ((!positive_ok && !negative_ok)
+					    || !fix(lit_type(var, positive_ok ? positive_polarity :
+					                                        negative_polarity))) {
+						++num_refuted_cubes_;
+						restore();
+						return;
+					}
+					continue;
+				}
+				auto const score = (positive + 1u) * (negative + 1u);
+				if (score > best_score) {
+					best = var;
+					best_score = score;
+				}
+			}
+		}
+		if (best < 0) {
+			cubes.emplace_back(cube);
+			restore();
+			return;
+		}
+		for (auto const polarity : {positive_polarity, negative_polarity}) {
+			auto const mark = propagator.trail_size();
+			if (fix(lit_type(static_cast<uint32_t>(best), polarity))) {
+				split(propagator, cube, depth + 1u, cubes);
+			} else {
+				++num_refuted_cubes_;
+			}
+			propagator.backtrack(mark);
+			cube.pop_back();
+		}
+		restore();
+	}
+
+	/* Passes the new variables and clauses to a backend */
+	void ingest(uint32_t index)
+	{
+		auto& solver = *solvers_.at(index);
+		if (num_ingested_variables_[index] < num_variables_) {
+			solver.add_variables(num_variables_ - num_ingested_variables_[index]);
+			num_ingested_variables_[index] = num_variables_;
+		}
+		for (auto i = num_ingested_[index]; i < clauses_.num_clauses(); ++i) {
+			solver.add_clause(clauses_.begin(i), clauses_.end(i));
+		}
+		num_ingested_[index] = clauses_.num_clauses();
+	}
+
+	/* Takes a cube of the thread's own share, or steals one */
+	bool take(uint32_t index, std::vector<lit_type>& cube)
+	{
+		{
+			auto& own = *queues_.at(index);
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.cubes.empty()) {
+				cube = std::move(own.cubes.front());
+				own.cubes.pop_front();
+				return true;
+			}
+		}
+		for (auto i = 1u; i < queues_.size(); ++i) {
+			auto& other = *queues_.at((index + i) % queues_.size());
+			std::lock_guard<std::mutex> lock(other.mutex);
+			if (!other.cubes.empty()) {
+				cube = std::move(other.cubes.back());
+				other.cubes.pop_back();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool is_pruned(std::vector<lit_type> literals) const
+	{
+		std::sort(literals.begin(), literals.end());
+		std::lock_guard<std::mutex> lock(cores_mutex_);
+		return std::any_of(cores_.begin(), cores_.end(), [&](auto const& core) {
+			return std::includes(literals.begin(), literals.end(), core.begin(), core.end());
+		});
+	}
+
+	/* Records the core of an unsatisfiable cube; false if the core is empty */
+	bool learn_core(Solver& solver, std::vector<lit_type> const& literals)
+	{
+		/* the backends return the clause that refutes the assumptions, i.e., the negated core */
+		std::vector<lit_type> clause;
+		if constexpr (detail::has_get_core<Solver>::value) {
+			clause = solver.get_core().core();
+		} else {
+			for (auto const lit : literals) {
+				clause.emplace_back(~lit);
+			}
+		}
+		if (clause.empty()) {
+			return false;
+		}
+		solver.add_clause(clause);
+		std::vector<lit_type> core;
+		for (auto const lit : clause) {
+			core.emplace_back(~lit);
+		}
+		std::sort(core.begin(), core.end());
+		std::lock_guard<std::mutex> lock(cores_mutex_);
+		cores_.emplace_back(std::move(core));
+		return true;
+	}
+
+	void interrupt_others(uint32_t index)
+	{
+		for (auto i = 0u; i < solvers_.size(); ++i) {
+			if (i != index) {
+				solvers_.at(i)->interrupt();
+			}
+		}
+	}
+
+private:
+	cube_and_conquer_params params_;
+	std::vector<std::unique_ptr<Solver>> solvers_;
+	std::vector<std::unique_ptr<cube_queue>> queues_;
+
+	/*! \brief All clauses, and how many each backend has received */
+	clause_batch clauses_;
+	std::vector<uint64_t> num_ingested_;
+	std::vector<uint32_t> num_ingested_variables_;
+	uint32_t num_variables_ = 0u;
+
+	/*! \brief Variables by decreasing number of occurrences */
+	std::vector<uint32_t> candidates_;
+
+	/*! \brief Sorted cores of the unsatisfiable cubes of this call */
+	std::vector<std::vector<lit_type>> cores_;
+	mutable std::mutex cores_mutex_;
+
+	uint32_t num_cubes_ = 0u;
+	uint32_t num_refuted_cubes_ = 0u;
+	uint32_t num_pruned_cubes_ = 0u;
+	int32_t winner_ = -1;
+	result::states state_ = result::states::undefined;
+};
+
+} // namespace bill
@@ -0,0 +1,622 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "../utils/platforms.hpp"
+#include "interface/types.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(BILL_WINDOWS_PLATFORM)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bill {
+
+namespace detail {
+
+/* Read-only view of a whole file, mapped into memory where possible */
+class mapped_file {
+public:
+	mapped_file() = default;
+
+	explicit mapped_file(std::string const& filename)
+	{
+#if defined(BILL_WINDOWS_PLATFORM)
+		std::ifstream in(filename, std::ios::binary);
+		if (!in) {
+			return;
+		}
+		buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		data_ = buffer_.data();
+		size_ = buffer_.size();
+		is_open_ = true;
+#else
+		int const fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return;
+		}
+		struct stat info;
+		if (::fstat(fd, &info) == 0) {
+			size_ = static_cast<std::size_t>(info.st_size);
+			is_open_ = true;
+			if (size_ > 0u) {
+				void* const addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (addr == MAP_FAILED) {
+					size_ = 0u;
+					is_open_ = false;
+				} else {
+					::madvise(addr, size_, MADV_SEQUENTIAL);
+					data_ = static_cast<char const*>(addr);
+					is_mapped_ = true;
+				}
+			}
+		}
+		::close(fd);
+#endif
+	}
+
+	mapped_file(mapped_file const&) = delete;
+	mapped_file& operator=(mapped_file const&) = delete;
+
+	~mapped_file()
+	{
+#if !defined(BILL_WINDOWS_PLATFORM)
+		if (is_mapped_) {
+			::munmap(const_cast<char*>(data_), size_);
+		}
+#endif
+	}
+
+	bool is_open() const
+	{
+		return is_open_;
+	}
+
+	char const* data() const
+	{
+		return data_;
+	}
+
+	std::size_t size() const
+	{
+		return size_;
+	}
+
+private:
+	char const* data_ = nullptr;
+	std::size_t size_ = 0u;
+	bool is_open_ = false;
+	bool is_mapped_ = false;
+#if defined(BILL_WINDOWS_PLATFORM)
+	std::vector<char> buffer_;
+#endif
+};
+
+} // namespace detail
+
+enum class dimacs_status : uint8_t {
+	success,
+	cannot_open,
+	syntax_error,
+};
+
+/*! \brief Reads CNF formulas in DIMACS format and incremental queries in iCNF format.
+ *
+ * The file is mapped into memory (on POSIX systems; it is read into a buffer on Windows) and
+ * scanned once.  Clauses are collected into a `clause_batch`, which is passed to the solver with
+ * `add_clauses` whenever it holds `batch_size` literals, hence reading a formula allocates a
+ * constant amount of memory besides the solver's.
+ *
+ * DIMACS variable `v` is the variable `v - 1`.  The header `p cnf <vars> <clauses>` is
+ * optional, variables are added to the solver as they appear.  In iCNF files (header
+ * `p inccnf`), a line `a <lits> 0` is a query under assumptions: the clauses read so far are
+ * added to the solver, and the assumptions are passed to a callback, which typically calls
+ * `solve`.  Comment lines start with `c`, and `%` ends the formula (as in the SATLIB
+ * benchmarks).  A last clause without the terminating `0` is accepted.
+ *
+ * Empty clauses are passed on to the solver; not all solvers accept them.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      solver<solvers::glucose_41> solver;
+      dimacs_reader reader("problem.cnf");
+      if (reader.read(solver) == dimacs_status::success) {
+        solver.solve();
+      }
+
+      dimacs_reader queries("problem.icnf");
+      queries.read(solver, [&](std::vector<lit_type> const& assumptions) {
+        std::cout << (solver.solve(assumptions) == result::states::satisfiable) << '\n';
+        return true; // continue reading
+      });
+   \endverbatim
+ */
+class dimacs_reader {
+public:
+	/*! \brief Opens a file for reading.
+	 *
+	 * \param filename Name of the file
+	 * \param batch_size Number of literals passed to the solver at once
+	 */
+	explicit dimacs_reader(std::string const& filename, uint64_t batch_size = 1u << 20)
+	    : file_(filename)
+	    , begin_(file_.data())
+	    , end_(file_.data() + file_.size())
+	    , batch_size_(batch_size)
+	{}
+
+	/*! \brief Reads from a buffer, which must outlive the reader.
+	 *
+	 * \param data First character of the buffer
+	 * \param size Number of characters
+	 * \param batch_size Number of literals passed to the solver at once
+	 */
+	dimacs_reader(char const* data, std::size_t size, uint64_t batch_size = 1u << 20)
+	    : file_()
+	    , begin_(data)
+	    , end_(data + size)
+	    , batch_size_(batch_size)
+	    , is_buffer_(true)
+	{}
+
+#pragma region Properties
+	bool is_open() const
+	{
+		return is_buffer_ || file_.is_open();
+	}
+
+	/*! \brief Returns true if the header is `p inccnf`. */
+	bool is_incremental() const
+	{
+		return is_incremental_;
+	}
+
+	/*! \brief Returns the number of variables of the header, or of the file if larger. */
+	uint32_t num_variables() const
+	{
+		return num_variables_;
+	}
+
+	uint64_t num_clauses() const
+	{
+		return num_clauses_;
+	}
+
+	uint64_t num_queries() const
+	{
+		return num_queries_;
+	}
+
+	/*! \brief Returns the line of the last syntax error (starting from 1). */
+	uint64_t error_line() const
+	{
+		return error_line_;
+	}
+#pragma endregion
+
+#pragma region Reading
+	/*! \brief Adds the clauses of a DIMACS file to a solver.
+	 *
+	 * Assumption lines are ignored.
+	 */
+	template<typename Solver>
+	dimacs_status read(Solver& solver)
+	{
+		return read(solver, [](std::vector<lit_type> const&) { return true; });
+	}
+
+	/*! \brief Adds the clauses of an iCNF file to a solver and answers its queries.
+	 *
+	 * \param solver Solver
+	 * \param on_query Called with the assumptions of each query, after the preceding clauses
+	 *                 were added to the solver; stops reading when it returns false
+	 */
+	template<typename Solver, typename Fn>
+	dimacs_status read(Solver& solver, Fn&& on_query)
+	{
+		auto add_variables = [&](uint32_t num_variables) {
+			if (num_variables > solver.num_variables()) {
+				solver.add_variables(num_variables - solver.num_variables());
+			}
+		};
+		return parse(
+		    [&](clause_batch const& clauses, uint32_t num_variables) {
+			    add_variables(num_variables);
+			    solver.add_clauses(clauses);
+		    },
+		    [&](std::vector<lit_type> const& assumptions, uint32_t num_variables) {
+			    add_variables(num_variables);
+			    return on_query(assumptions);
+		    });
+	}
+
+	/*! \brief Scans the file and passes its contents to callbacks.
+	 *
+	 * \param on_clauses Called with each batch of clauses and the number of variables so far
+	 * \param on_query Called with the assumptions of each query and the number of variables so
+	 *                 far, after the preceding clauses; stops reading when it returns false
+	 */
+	template<typename ClausesFn, typename QueryFn>
+	dimacs_status parse(ClausesFn&& on_clauses, QueryFn&& on_query)
+	{
+		if (!is_open()) {
+			return dimacs_status::cannot_open;
+		}
+		num_variables_ = 0u;
+		num_clauses_ = 0u;
+		num_queries_ = 0u;
+		error_line_ = 0u;
+		is_incremental_ = false;
+
+		clause_batch batch;
+		batch.reserve(std::min<uint64_t>(batch_size_ / 2u, 1u << 16), batch_size_ + 64u);
+		std::vector<lit_type> assumptions;
+		bool in_clause = false;
+		bool in_query = false;
+
+		auto flush = [&]() {
+			if (batch.num_clauses() > 0u) {
+				on_clauses(batch, num_variables_);
+				batch.clear();
+			}
+		};
+		auto error = [&](char const* p) {
+			error_line_ = 1u + std::count(begin_, p, '\n');
+			return dimacs_status::syntax_error;
+		};
+
+		char const* p = begin_;
+		while (true) {
+			/* skip white space */
+			while (p != end_ && is_space(*p)) {
+				++p;
+			}
+			if (p == end_ || *p == '%') {
+				break;
+			}
+			if (!in_clause && !in_query) {
+				if (*p == 'c') {
+					p = skip_line(p);
+					continue;
+				}
+				if (*p == 'p') {
+					char const* const next = parse_header(p);
+					if (next == nullptr) {
+						return error(p);
+					}
+					p = next;
+					continue;
+				}
+				if (*p == 'a') {
+					++p;
+					in_query = true;
+					assumptions.clear();
+					continue;
+				}
+			}
+
+			/* fast path for literals */
+			bool const negative = (*p == '-');
+			if (negative) {
+				++p;
+			}
+			if (p == end_ || !is_digit(*p)) {
+				return error(p);
+			}
+			uint64_t value = 0u;
+			do {
+				value = 10u * value + static_cast<uint64_t>(*p - '0');
+				if (value > max_variable) {
+					return error(p);
+				}
+				++p;
+			} while (p != end_ && is_digit(*p));
+			if (p != end_ && !is_space(*p)) {
+				return error(p);
+			}
+
+			if (value == 0u) {
+				if (negative) {
+					return error(p);
+				}
+				if (in_query) {
+					in_query = false;
+					++num_queries_;
+					flush();
+					if (!on_query(assumptions, num_variables_)) {
+						return dimacs_status::success;
+					}
+				} else {
+					batch.close_clause();
+					++num_clauses_;
+					in_clause = false;
+					if (batch.num_literals() >= batch_size_) {
+						flush();
+					}
+				}
+				continue;
+			}
+			auto const var = static_cast<uint32_t>(value);
+			num_variables_ = std::max(num_variables_, var);
+			lit_type const lit(var - 1u, negative ? negative_polarity : positive_polarity);
+			if (in_query) {
+				assumptions.emplace_back(lit);
+			} else {
+				batch.add_literal(lit);
+				in_clause = true;
+			}
+		}
+
+		if (in_query) {
+			return error(end_);
+		}
+		if (in_clause) {
+			batch.close_clause();
+			++num_clauses_;
+		}
+		flush();
+		return dimacs_status::success;
+	}
+#pragma endregion
+
+private:
+	static bool is_space(char c)
+	{
+		return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	static bool is_digit(char c)
+	{
+		return static_cast<unsigned char>(c - '0') < 10u;
+	}
+
+	char const* skip_line(char const* p) const
+	{
+		auto const* const eol = static_cast<char const*>(std::memchr(p, '\n', end_ - p));
+		return eol == nullptr ? end_ : eol + 1;
+	}
+
+	/* Returns nullptr if the header is malformed */
+	char const* parse_header(char const* p)
+	{
+		char const* const eol = skip_line(p);
+		std::string const line(p, eol);
+		char format[8] = {};
+		unsigned long long num_vars = 0u;
+		unsigned long long num_clauses = 0u;
+		if (std::sscanf(line.c_str(), "p %7s %llu %llu", format, &num_vars, &num_clauses) >= 1) {
+			if (std::strcmp(format, "inccnf") == 0) {
+				is_incremental_ = true;
+				return eol;
+			}
+			if (std::strcmp(format, "cnf") == 0 && num_vars <= max_variable) {
+				num_variables_ = std::max(num_variables_, static_cast<uint32_t>(num_vars));
+				return eol;
+			}
+		}
+		return nullptr;
+	}
+
+private:
+	/* DIMACS variables are 1-based */
+	static constexpr uint64_t max_variable = (std::numeric_limits<uint32_t>::max() >> 1);
+
+	detail::mapped_file file_;
+	char const* begin_;
+	char const* end_;
+	uint64_t batch_size_;
+	bool is_buffer_ = false;
+	bool is_incremental_ = false;
+	uint32_t num_variables_ = 0u;
+	uint64_t num_clauses_ = 0u;
+	uint64_t num_queries_ = 0u;
+	uint64_t error_line_ = 0u;
+};
+
+/*! \brief Writes clauses in DIMACS format, or queries in iCNF format.
+ *
+ * The writer has the clause interface of the solvers (`add_variable(s)`, `add_clause`,
+ * `add_clauses`), hence it can be used in place of a solver, e.g., to dump the clauses of an
+ * encoding or to record everything passed to a solver.  Output is formatted into an internal
+ * buffer and written to the stream in blocks of `buffer_size` characters.
+ *
+ * In DIMACS mode, the numbers of variables and clauses are not known in advance: room for the
+ * header is left at the start, and the header is filled in by `flush`.  The stream must hence
+ * be seekable, as file and string streams are.  The header `p inccnf` of iCNF has no counts.
+ */
+class dimacs_writer {
+public:
+	/*! \brief Starts writing to a stream.
+	 *
+	 * \param os Output stream
+	 * \param incremental Writes an iCNF file, which may contain queries
+	 * \param buffer_size Number of characters written to the stream at once
+	 */
+	explicit dimacs_writer(std::ostream& os, bool incremental = false,
+	                       uint32_t buffer_size = 1u << 16)
+	    : os_(os)
+	    , incremental_(incremental)
+	    , buffer_size_(std::max(buffer_size, 64u))
+	{
+		buffer_.reserve(buffer_size_ + 32u);
+		if (incremental_) {
+			os_ << "p inccnf\n";
+		} else {
+			header_position_ = os_.tellp();
+			assert(header_position_ != std::ostream::pos_type(-1));
+			os_ << std::string(header_width, ' ') << '\n';
+		}
+	}
+
+	dimacs_writer(dimacs_writer const&) = delete;
+	dimacs_writer& operator=(dimacs_writer const&) = delete;
+
+	~dimacs_writer()
+	{
+		flush();
+	}
+
+#pragma region Clauses
+	var_type add_variable()
+	{
+		return num_variables_++;
+	}
+
+	void add_variables(uint32_t num_variables = 1)
+	{
+		num_variables_ += num_variables;
+	}
+
+	template<typename Iterator>
+	bool add_clause(Iterator it, Iterator ie)
+	{
+		for (; it != ie; ++it) {
+			write_literal(*it);
+		}
+		buffer_.append("0\n");
+		++num_clauses_;
+		if (buffer_.size() >= buffer_size_) {
+			write_buffer();
+		}
+		return true;
+	}
+
+	bool add_clause(std::vector<lit_type> const& clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clause(std::initializer_list<lit_type> clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clause(lit_type lit)
+	{
+		lit_type const* const begin = &lit;
+		return add_clause(begin, begin + 1);
+	}
+
+	bool add_clauses(clause_batch const& clauses)
+	{
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			add_clause(clauses.begin(i), clauses.end(i));
+		}
+		return true;
+	}
+
+	bool add_clauses(std::vector<std::vector<lit_type>> const& clauses)
+	{
+		for (auto const& clause : clauses) {
+			add_clause(clause);
+		}
+		return true;
+	}
+
+	/*! \brief Writes a query under assumptions (iCNF only). */
+	void add_query(std::vector<lit_type> const& assumptions = {})
+	{
+		assert(incremental_);
+		buffer_.append("a ");
+		for (auto const& lit : assumptions) {
+			write_literal(lit);
+		}
+		buffer_.append("0\n");
+		if (buffer_.size() >= buffer_size_) {
+			write_buffer();
+		}
+	}
+#pragma endregion
+
+#pragma region Properties
+	uint32_t num_variables() const
+	{
+		return num_variables_;
+	}
+
+	uint64_t num_clauses() const
+	{
+		return num_clauses_;
+	}
+#pragma endregion
+
+	/*! \brief Writes the buffered output and updates the header. */
+	void flush()
+	{
+		write_buffer();
+		if (!incremental_) {
+			auto const position = os_.tellp();
+			std::string const header = "p cnf " + std::to_string(num_variables_) + " "
+			                           + std::to_string(num_clauses_);
+			assert(header.size() <= header_width);
+			os_.seekp(header_position_);
+			os_ << header;
+			os_.seekp(position);
+		}
+		os_.flush();
+	}
+
+private:
+	void write_literal(lit_type lit)
+	{
+		auto const var = static_cast<uint32_t>(lit.variable());
+		num_variables_ = std::max(num_variables_, var + 1u);
+		if (lit.is_complemented()) {
+			buffer_.push_back('-');
+		}
+		/* digits of var + 1, in reverse */
+		char digits[10];
+		auto num_digits = 0u;
+		uint32_t value = var + 1u;
+		do {
+			digits[num_digits++] = static_cast<char>('0' + value % 10u);
+			value /= 10u;
+		} while (value != 0u);
+		while (num_digits > 0u) {
+			buffer_.push_back(digits[--num_digits]);
+		}
+		buffer_.push_back(' ');
+	}
+
+	void write_buffer()
+	{
+		os_.write(buffer_.data(), buffer_.size());
+		buffer_.clear();
+	}
+
+private:
+	/* "p cnf " followed by two 20-digit numbers */
+	static constexpr std::size_t header_width = 47u;
+
+	std::ostream& os_;
+	bool incremental_;
+	uint32_t buffer_size_;
+	std::string buffer_;
+	std::ostream::pos_type header_position_ = 0;
+	uint32_t num_variables_ = 0u;
+	uint64_t num_clauses_ = 0u;
+};
+
+} // namespace bill
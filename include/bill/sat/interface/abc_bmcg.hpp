@@ -7,6 +7,7 @@
 #include "common.hpp"
 #include "types.hpp"
 
+#include <initializer_list>
 #include <memory>
 #include <variant>
 #include <vector>
@@ -14,6 +15,9 @@
 namespace bill {
 
 #if !defined(BILL_WINDOWS_PLATFORM)
+/* Literals are passed to the solver without conversion */
+static_assert(sizeof(pabc::lit) == sizeof(lit_type), "lit_type must have the layout of pabc::lit");
+
 template<>
 class solver<solvers::bmcg> {
 	using solver_type = pabc::bmcg_sat_solver;
@@ -23,6 +27,7 @@ public:
 	solver()
 	{
 		solver_ = pabc::bmcg_sat_solver_start();
+		pabc::bmcg_sat_solver_set_stop(solver_, &stop_);
 	}
 
 	~solver()
@@ -40,6 +45,7 @@ public:
 	void restart()
 	{
 		pabc::bmcg_sat_solver_reset(solver_);
+		pabc::bmcg_sat_solver_set_stop(solver_, &stop_);
 		state_ = result::states::undefined;
 		variable_counter_ = 0u;
 	}
@@ -58,8 +64,8 @@ public:
 		variable_counter_ += num_variables;
 	}
 
-	auto add_clause(std::vector<lit_type>::const_iterator it,
-	                std::vector<lit_type>::const_iterator ie)
+	template<typename Iterator>
+	auto add_clause(Iterator it, Iterator ie)
 	{
 		auto counter = 0u;
 		while (it != ie) {
@@ -72,14 +78,49 @@ public:
 		return result;
 	}
 
+	auto add_clause(lit_type const* begin, lit_type const* end)
+	{
+		/* ABC only reads the literals, which have the same encoding */
+		auto* const lits = reinterpret_cast<pabc::lit*>(const_cast<lit_type*>(begin));
+		auto const result = pabc::bmcg_sat_solver_addclause(solver_, lits, end - begin);
+		state_ = result ? result::states::dirty : result::states::unsatisfiable;
+		return result;
+	}
+
 	auto add_clause(std::vector<lit_type> const& clause)
 	{
-		return add_clause(clause.begin(), clause.end());
+		return add_clause(clause.data(), clause.data() + clause.size());
 	}
 
 	auto add_clause(lit_type lit)
 	{
-		return add_clause(std::vector<lit_type>{lit});
+		lit_type const* const begin = &lit;
+		return add_clause(begin, begin + 1);
+	}
+
+	auto add_clause(std::initializer_list<lit_type> clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clauses(clause_batch const& clauses)
+	{
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			if (!add_clause(clauses.begin(i), clauses.end(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool add_clauses(std::vector<std::vector<lit_type>> const& clauses)
+	{
+		for (auto const& clause : clauses) {
+			if (!add_clause(clause)) {
+				return false;
+			}
+		}
+		return true;
 	}
 
 	result get_model() const
@@ -114,20 +155,15 @@ public:
 		if (num_variables() == 0u)
 			return result::states::undefined;
 
-		if (conflict_limit > 0)
-			pabc::bmcg_sat_solver_set_conflict_budget(solver_, conflict_limit);
+		/* a limit of 0 turns the budget of a previous limited call off */
+		pabc::bmcg_sat_solver_set_conflict_budget(solver_, conflict_limit);
 
 		int result;
 		if (assumptions.size() > 0u) {
-			/* solve with assumptions */
-			uint32_t counter = 0u;
-			auto it = assumptions.begin();
-			while (it != assumptions.end()) {
-				literals[counter++] = pabc::Abc_Var2Lit(it->variable(),
-				                                        it->is_complemented());
-				++it;
-			}
-			result = pabc::bmcg_sat_solver_solve(solver_, literals, counter);
+			/* solve with assumptions, which ABC only reads */
+			auto* const lits = reinterpret_cast<pabc::lit*>(
+			    const_cast<lit_type*>(assumptions.data()));
+			result = pabc::bmcg_sat_solver_solve(solver_, lits, assumptions.size());
 		} else {
 			/* solve without assumptions */
 			result = pabc::bmcg_sat_solver_solve(solver_, 0, 0);
@@ -143,9 +179,30 @@ public:
 
 		return state_;
 	}
+
+	/*! \brief Asks `solve` to stop as soon as possible, it then returns `undefined`.
+	 *
+	 * May be called from another thread while `solve` runs.  The request holds until
+	 * `clear_interrupt`, hence it also stops the calls to `solve` made in between.
+	 */
+	void interrupt()
+	{
+		stop_ = 1;
+	}
+
+	void clear_interrupt()
+	{
+		stop_ = 0;
+	}
 #pragma endregion
 
 #pragma region Properties
+	/*! \brief Returns whether an interrupt is pending. */
+	bool is_interrupted() const
+	{
+		return stop_ != 0;
+	}
+
 	uint32_t num_variables() const
 	{
 		return variable_counter_;
@@ -169,6 +226,9 @@ private:
 
 	/*! \brief Count the number of variables */
 	uint32_t variable_counter_ = 0u;
+
+	/*! \brief Stop flag polled by the backend */
+	int stop_ = 0;
 };
 #endif
 
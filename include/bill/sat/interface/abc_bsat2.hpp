@@ -7,6 +7,7 @@
 #include "common.hpp"
 #include "types.hpp"
 
+#include <initializer_list>
 #include <memory>
 #include <random>
 #include <variant>
@@ -14,6 +15,9 @@
 
 namespace bill {
 
+/* Literals are passed to the solver without conversion */
+static_assert(sizeof(pabc::lit) == sizeof(lit_type), "lit_type must have the layout of pabc::lit");
+
 template<>
 class solver<solvers::bsat2> {
 	using solver_type = pabc::sat_solver;
@@ -64,8 +68,8 @@ public:
 		}
 	}
 
-	auto add_clause(std::vector<lit_type>::const_iterator it,
-	                std::vector<lit_type>::const_iterator ie)
+	template<typename Iterator>
+	auto add_clause(Iterator it, Iterator ie)
 	{
 		literals.resize(ie - it);
 		++clause_counter.back();
@@ -80,15 +84,51 @@ public:
 		return result;
 	}
 
+	auto add_clause(lit_type const* begin, lit_type const* end)
+	{
+		++clause_counter.back();
+		/* ABC only reads the literals, which have the same encoding */
+		auto* const lits = reinterpret_cast<pabc::lit*>(const_cast<lit_type*>(begin));
+		auto const result = pabc::sat_solver_addclause(solver_, lits, lits + (end - begin));
+		state_ = result ? result::states::dirty : result::states::unsatisfiable;
+		return result;
+	}
+
 	auto add_clause(std::vector<lit_type> const& clause)
 	{
-		return add_clause(clause.begin(), clause.end());
+		return add_clause(clause.data(), clause.data() + clause.size());
 	}
 
 	auto add_clause(lit_type lit)
 	{
 		--clause_counter.back(); /* do not count unit clauses */
-		return add_clause(std::vector<lit_type>{lit});
+		lit_type const* const begin = &lit;
+		return add_clause(begin, begin + 1);
+	}
+
+	auto add_clause(std::initializer_list<lit_type> clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clauses(clause_batch const& clauses)
+	{
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			if (!add_clause(clauses.begin(i), clauses.end(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool add_clauses(std::vector<std::vector<lit_type>> const& clauses)
+	{
+		for (auto const& clause : clauses) {
+			if (!add_clause(clause)) {
+				return false;
+			}
+		}
+		return true;
 	}
 
 	result get_model() const
@@ -137,16 +177,10 @@ public:
 
 		int result;
 		if (assumptions.size() > 0u) {
-			/* solve with assumptions */
-			uint32_t counter = 0u;
-			literals.resize(assumptions.size());
-			auto it = assumptions.begin();
-			while (it != assumptions.end()) {
-				literals[counter++] = pabc::Abc_Var2Lit(it->variable(),
-				                                        it->is_complemented());
-				++it;
-			}
-			result = pabc::sat_solver_solve(solver_, literals.data(), literals.data() + counter,
+			/* solve with assumptions, which ABC only reads */
+			auto* const lits = reinterpret_cast<pabc::lit*>(
+			    const_cast<lit_type*>(assumptions.data()));
+			result = pabc::sat_solver_solve(solver_, lits, lits + assumptions.size(),
 			                                conflict_limit, 0, 0, 0);
 		} else {
 			/* solve without assumptions */
@@ -163,9 +197,30 @@ public:
 
 		return state_;
 	}
+
+	/*! \brief Asks `solve` to stop as soon as possible, it then returns `undefined`.
+	 *
+	 * May be called from another thread while `solve` runs; the solver checks its runtime limit,
+	 * which is set to the past, every 64 conflicts.  The request holds until `clear_interrupt`.
+	 */
+	void interrupt()
+	{
+		solver_->nRuntimeLimit = 1;
+	}
+
+	void clear_interrupt()
+	{
+		solver_->nRuntimeLimit = 0;
+	}
 #pragma endregion
 
 #pragma region Properties
+	/*! \brief Returns whether an interrupt is pending. */
+	bool is_interrupted() const
+	{
+		return solver_->nRuntimeLimit != 0;
+	}
+
 	uint32_t num_variables() const
 	{
 		return variable_counter.back();
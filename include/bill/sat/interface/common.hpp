@@ -44,6 +44,8 @@
 #include "types.hpp"
 
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -157,4 +159,16 @@ enum class solvers {
 template<solvers Solver = solvers::ghack>
 class solver;
 
+namespace detail {
+
+/* Whether a solver computes unsatisfiable cores (`get_core`) */
+template<typename Solver, typename = void>
+struct has_get_core : std::false_type {};
+
+template<typename Solver>
+struct has_get_core<Solver, std::void_t<decltype(std::declval<Solver const&>().get_core())>>
+    : std::true_type {};
+
+} // namespace detail
+
 } // namespace bill
@@ -4,19 +4,71 @@
 *------------------------------------------------------------------------------------------------*/
 #pragma once
 
+#include "../clause_exchange.hpp"
 #include "common.hpp"
+#include "sharing_solver.hpp"
 #include "types.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
 #include <memory>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
 namespace bill {
 
 #if !defined(BILL_WINDOWS_PLATFORM)
+/* Literals are passed to the solver by copying their memory */
+static_assert(sizeof(Maple::Lit) == sizeof(lit_type),
+              "lit_type must have the layout of Maple::Lit");
+static_assert(std::is_trivially_copyable_v<Maple::Lit>);
+
+namespace detail {
+
+struct maple_backend {
+	using solver_type = Maple::Solver;
+	using lit = Maple::Lit;
+	using clause = Maple::Clause;
+	using lit_vector = Maple::vec<Maple::Lit>;
+
+	static constexpr auto l_true = Maple::l_True;
+	static constexpr auto l_undef = Maple::l_Undef;
+	static constexpr bool import_once_per_restart = false;
+
+	static lit make_lit(uint32_t var, bool complemented)
+	{
+		return Maple::mkLit(var, complemented);
+	}
+};
+
+template<>
+inline void sharing_solver<maple_backend>::attach_imported(uint32_t lbd)
+{
+	/* the tiers of `search`: core (mark 3), tier 2 (mark 2) and local */
+	auto const cr = ca.alloc(imported_, true);
+	auto const clause_lbd = std::min<uint32_t>(lbd, imported_.size());
+	ca[cr].set_lbd(clause_lbd);
+	if (clause_lbd <= static_cast<uint32_t>(core_lbd_cut)) {
+		learnts_core.push(cr);
+		ca[cr].mark(3u);
+	} else if (clause_lbd <= 6u) {
+		learnts_tier2.push(cr);
+		ca[cr].mark(2u);
+		ca[cr].touched() = conflicts;
+	} else {
+		learnts_local.push(cr);
+		claBumpActivity(ca[cr]);
+	}
+	attachClause(cr);
+}
+
+} // namespace detail
+
 template<>
 class solver<solvers::maple> {
-	using solver_type = Maple::Solver;
+	using solver_type = detail::sharing_solver<detail::maple_backend>;
 
 public:
 #pragma region Constructors
@@ -30,10 +82,17 @@ public:
 #pragma endregion
 
 #pragma region Modifiers
+	/*! \brief Removes all variables and clauses, and resets the parameters.
+	 *
+	 * The solver is emptied in place: its clause arena, watch lists and per-variable arrays keep
+	 * their memory for the next problem.
+	 */
 	void restart()
 	{
-		solver_.reset();
-		solver_ = std::make_unique<solver_type>();
+		solver_->reset();
+		if (exchange_) {
+			exchange_->restart(exchange_id_);
+		}
 		state_ = result::states::undefined;
 	}
 
@@ -49,24 +108,57 @@ public:
 		}
 	}
 
-	auto add_clause(std::vector<lit_type>::const_iterator it,
-	                std::vector<lit_type>::const_iterator ie)
+	template<typename Iterator>
+	auto add_clause(Iterator it, Iterator ie)
 	{
-		Maple::vec<Maple::Lit> literals;
+		literals_.clear();
 		while (it != ie) {
-			literals.push(Maple::mkLit(it->variable(), it->is_complemented()));
+			literals_.push(Maple::mkLit(it->variable(), it->is_complemented()));
 			++it;
 		}
-		auto const result = solver_->addClause_(literals);
+		auto const result = solver_->addClause_(literals_);
+		state_ = result ? result::states::dirty : result::states::unsatisfiable;
+		return result;
+	}
+
+	auto add_clause(lit_type const* begin, lit_type const* end)
+	{
+		copy_literals(begin, end);
+		auto const result = solver_->addClause_(literals_);
 		state_ = result ? result::states::dirty : result::states::unsatisfiable;
 		return result;
 	}
 
 	auto add_clause(std::vector<lit_type> const& clause)
+	{
+		return add_clause(clause.data(), clause.data() + clause.size());
+	}
+
+	auto add_clause(std::initializer_list<lit_type> clause)
 	{
 		return add_clause(clause.begin(), clause.end());
 	}
 
+	bool add_clauses(clause_batch const& clauses)
+	{
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			if (!add_clause(clauses.begin(i), clauses.end(i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool add_clauses(std::vector<std::vector<lit_type>> const& clauses)
+	{
+		for (auto const& clause : clauses) {
+			if (!add_clause(clause)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
 	auto add_clause(lit_type lit)
 	{
 		auto const result = solver_->addClause(
@@ -119,21 +211,25 @@ public:
 	result::states solve(std::vector<lit_type> const& assumptions = {},
 	                     uint32_t conflict_limit = 0)
 	{
-		if (state_ != result::states::dirty && assumptions.empty()) {
+		clause_exchange::scoped_round const round(exchange_, exchange_id_);
+		/* only definite answers are final, an interrupted or limited call may be resumed */
+		if (assumptions.empty()
+		    && (state_ == result::states::satisfiable
+		        || state_ == result::states::unsatisfiable)) {
 			return state_;
 		}
 
 		assert(solver_->okay() == true);
+		/* the budget of a limited call must not carry over to the next calls */
 		if (conflict_limit) {
 			solver_->setConfBudget(conflict_limit);
+		} else {
+			solver_->budgetOff();
 		}
 
-		Maple::vec<Maple::Lit> literals;
-		for (auto lit : assumptions) {
-			literals.push(Maple::mkLit(lit.variable(), lit.is_complemented()));
-		}
+		copy_literals(assumptions.data(), assumptions.data() + assumptions.size());
 
-		Maple::lbool state = solver_->solveLimited(literals);
+		Maple::lbool state = solver_->solveLimited(literals_);
 		if (state == Maple::l_True) {
 			state_ = result::states::satisfiable;
 		} else if (state == Maple::l_False) {
@@ -143,9 +239,51 @@ public:
 		}
 		return state_;
 	}
+
+	/*! \brief Asks `solve` to stop as soon as possible, it then returns `undefined`.
+	 *
+	 * May be called from another thread while `solve` runs.  The request holds until
+	 * `clear_interrupt`, hence it also stops the calls to `solve` made in between.
+	 */
+	void interrupt()
+	{
+		solver_->interrupt();
+	}
+
+	void clear_interrupt()
+	{
+		solver_->clearInterrupt();
+	}
+
+	/*! \brief Randomizes the initial activities of the variables added afterwards and the
+	 * branching polarities, drawing from `seed`. */
+	void set_random_phase(uint32_t seed = 0u)
+	{
+		solver_->rnd_init_act = true;
+		solver_->rnd_pol = true;
+		solver_->random_seed = seed + 1.0; /* must be positive */
+	}
+
+	/*! \brief Exchanges learnt clauses with the other solvers attached to `exchange`.
+	 *
+	 * Takes a participant slot of `exchange`, which the solver keeps after `restart` (the
+	 * clauses exported before are then ignored).  The exchange must outlive the solver.
+	 */
+	void share_clauses(clause_exchange& exchange)
+	{
+		exchange_ = &exchange;
+		exchange_id_ = exchange.join();
+		solver_->connect(exchange, exchange_id_);
+	}
 #pragma endregion
 
 #pragma region Properties
+	/*! \brief Returns whether an interrupt is pending. */
+	bool is_interrupted() const
+	{
+		return solver_->interrupted();
+	}
+
 	uint32_t num_variables() const
 	{
 		return solver_->nVars();
@@ -157,12 +295,30 @@ public:
 	}
 #pragma endregion
 
+private:
+	/* Copies literals into `literals_`, in bulk since the layouts are the same */
+	void copy_literals(lit_type const* begin, lit_type const* end)
+	{
+		literals_.clear();
+		literals_.growTo(end - begin);
+		if (begin != end) {
+			std::memcpy(&literals_[0], begin, (end - begin) * sizeof(lit_type));
+		}
+	}
+
 private:
 	/*! \brief Backend solver */
 	std::unique_ptr<solver_type> solver_;
 
 	/*! \brief Current state of the solver */
 	result::states state_ = result::states::dirty;
+
+	/*! \brief Clause exchange the solver takes part in, if any */
+	clause_exchange* exchange_ = nullptr;
+	uint32_t exchange_id_ = 0u;
+
+	/*! \brief Temporary storage for one clause or the assumptions */
+	Maple::vec<Maple::Lit> literals_;
 };
 #endif
 
@@ -0,0 +1,132 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "../clause_exchange.hpp"
+#include "types.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace bill::detail {
+
+/* A MiniSat-like backend (Glucose, GHack, Maple) with its clause-sharing hooks connected to a
+ * `clause_exchange`.
+ *
+ * `Backend` names the types and constants of the backend:
+ *   - `solver_type`, `lit`, `clause` and `lit_vector`
+ *   - `make_lit(var, complemented)`, `l_true` and `l_undef`
+ *   - `import_once_per_restart`, if the backend calls `parallelImportClauses` more than once
+ *     per restart
+ *
+ * Each backend specializes `attach_imported`, which adds the clause in `imported_` to the
+ * learnt clauses of its tier.
+ */
+template<typename Backend>
+class sharing_solver final : public Backend::solver_type {
+	using base_type = typename Backend::solver_type;
+	using backend_lit = typename Backend::lit;
+
+public:
+	void connect(clause_exchange& exchange, uint32_t id)
+	{
+		exchange_ = &exchange;
+		id_ = id;
+	}
+
+	void reset()
+	{
+		base_type::reset();
+		import_start_ = 0u;
+	}
+
+	bool interrupted() const
+	{
+		return this->asynch_interrupt;
+	}
+
+protected:
+	bool parallelImportClauses() override
+	{
+		if (exchange_ == nullptr) {
+			return false;
+		}
+		if constexpr (Backend::import_once_per_restart) {
+			if (this->starts == import_start_) {
+				return false;
+			}
+			import_start_ = this->starts;
+		}
+		auto const stop = [&]() { return this->asynch_interrupt; };
+		return !exchange_->import_clauses(
+		    id_,
+		    [&](lit_type const* begin, lit_type const* end, uint32_t lbd) {
+			    return import_clause(begin, end, lbd);
+		    },
+		    stop);
+	}
+
+	void parallelExportUnaryClause(backend_lit p) override
+	{
+		if (exchange_) {
+			auto const lit = lit_type::from_raw(p.x);
+			exchange_->export_clause(id_, &lit, &lit + 1, 1u);
+		}
+	}
+
+	void parallelExportClauseDuringSearch(typename Backend::clause& c) override
+	{
+		if (exchange_ == nullptr || !exchange_->accepts(c.size(), c.lbd())) {
+			return;
+		}
+		auto const size = static_cast<uint32_t>(c.size());
+		exported_.clear();
+		for (auto i = 0u; i < size; ++i) {
+			exported_.emplace_back(lit_type::from_raw(c[i].x));
+		}
+		exchange_->export_clause(id_, exported_.data(), exported_.data() + exported_.size(),
+		                         c.lbd());
+	}
+
+private:
+	/* Adds a clause at level 0, without its false literals; false if it is falsified */
+	bool import_clause(lit_type const* begin, lit_type const* end, uint32_t lbd)
+	{
+		imported_.clear();
+		for (auto it = begin; it != end; ++it) {
+			if (it->variable() >= static_cast<uint32_t>(this->nVars())) {
+				return true;
+			}
+			auto const lit = Backend::make_lit(it->variable(), it->is_complemented());
+			if (this->value(lit) == Backend::l_true) {
+				return true;
+			}
+			if (this->value(lit) == Backend::l_undef) {
+				imported_.push(lit);
+			}
+		}
+		if (imported_.size() == 0) {
+			return this->ok = false;
+		}
+		if (imported_.size() == 1) {
+			this->uncheckedEnqueue(imported_[0]);
+			return true;
+		}
+		attach_imported(lbd);
+		return true;
+	}
+
+	/* Adds `imported_`, of at least two literals, as a learnt clause of LBD at most `lbd` */
+	void attach_imported(uint32_t lbd);
+
+private:
+	clause_exchange* exchange_ = nullptr;
+	uint32_t id_ = 0u;
+	uint64_t import_start_ = 0u;
+	std::vector<lit_type> exported_;
+	typename Backend::lit_vector imported_;
+};
+
+} // namespace bill::detail
@@ -6,7 +6,11 @@
 
 #include <cassert>
 #include <cstdint>
+#include <initializer_list>
 #include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace bill {
 
@@ -80,6 +84,12 @@ public:
 	    : data_((var << 1) | ((polarity == polarities::positive) ? 0 : 1))
 	{}
 
+	/*! \brief Returns the literal whose numeral `2 * var + sign` is `raw`. */
+	static constexpr lit_type from_raw(uint32_t raw)
+	{
+		return lit_type(raw >> 1, polarities(raw & 1));
+	}
+
 #pragma region Properties
 	var_type variable() const
 	{
@@ -132,9 +142,123 @@ private:
 	uint32_t data_;
 };
 
+/* The numeral `2 * var + sign` is the whole object, hence arrays of literals can be passed to
+ * solvers that use the same encoding (Glucose, GHack, Maple, ABC) without conversion */
+static_assert(sizeof(lit_type) == sizeof(uint32_t));
+static_assert(std::is_trivially_copyable_v<lit_type> && std::is_standard_layout_v<lit_type>);
+
 constexpr auto positive_polarity = lit_type::polarities::positive;
 constexpr auto negative_polarity = lit_type::polarities::negative;
 
+/*! \brief A sequence of clauses stored in one flat buffer of literals.
+ *
+ * Clause `i` consists of the literals from `offsets()[i]` to `offsets()[i + 1]` (excluded) of
+ * `literals()`.  Adding clauses does not allocate once the buffers are large enough, and
+ * `clear` keeps their capacity, hence one batch can be refilled many times.  Batches are
+ * passed to the solvers with `add_clauses`.
+ */
+class clause_batch {
+public:
+	clause_batch()
+	    : offsets_(1u, 0u)
+	{}
+
+	/*! \brief Creates a batch from a flat buffer of literals and the offsets of the clauses.
+	 *
+	 * \param literals Literals of all clauses
+	 * \param offsets Offset of each clause, followed by the number of literals
+	 */
+	clause_batch(std::vector<lit_type> literals, std::vector<uint64_t> offsets)
+	    : literals_(std::move(literals))
+	    , offsets_(std::move(offsets))
+	{
+		assert(!offsets_.empty() && offsets_.front() == 0u);
+		assert(offsets_.back() == literals_.size());
+	}
+
+#pragma region Modifiers
+	template<typename Iterator>
+	void add_clause(Iterator it, Iterator ie)
+	{
+		literals_.insert(literals_.end(), it, ie);
+		offsets_.emplace_back(literals_.size());
+	}
+
+	void add_clause(std::initializer_list<lit_type> clause)
+	{
+		add_clause(clause.begin(), clause.end());
+	}
+
+	void add_clause(std::vector<lit_type> const& clause)
+	{
+		add_clause(clause.begin(), clause.end());
+	}
+
+	/*! \brief Appends a literal to the clause under construction. */
+	void add_literal(lit_type lit)
+	{
+		literals_.emplace_back(lit);
+	}
+
+	/*! \brief Ends the clause under construction (possibly empty). */
+	void close_clause()
+	{
+		offsets_.emplace_back(literals_.size());
+	}
+
+	void reserve(uint64_t num_clauses, uint64_t num_literals)
+	{
+		offsets_.reserve(num_clauses + 1u);
+		literals_.reserve(num_literals);
+	}
+
+	/*! \brief Removes all clauses, but keeps the memory. */
+	void clear()
+	{
+		literals_.clear();
+		offsets_.resize(1u);
+	}
+#pragma endregion
+
+#pragma region Properties
+	uint64_t num_clauses() const
+	{
+		return offsets_.size() - 1u;
+	}
+
+	uint64_t num_literals() const
+	{
+		return literals_.size();
+	}
+
+	/*! \brief Returns a pointer to the first literal of clause `i`. */
+	lit_type const* begin(uint64_t i) const
+	{
+		return literals_.data() + offsets_[i];
+	}
+
+	/*! \brief Returns a pointer past the last literal of clause `i`. */
+	lit_type const* end(uint64_t i) const
+	{
+		return literals_.data() + offsets_[i + 1u];
+	}
+
+	std::vector<lit_type> const& literals() const
+	{
+		return literals_;
+	}
+
+	std::vector<uint64_t> const& offsets() const
+	{
+		return offsets_;
+	}
+#pragma endregion
+
+private:
+	std::vector<lit_type> literals_;
+	std::vector<uint64_t> offsets_;
+};
+
 /*! \brief Lifted Boolean wrapper class.
  */
 enum class lbool_type : uint8_t {
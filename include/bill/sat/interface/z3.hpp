@@ -9,7 +9,9 @@
 #include "common.hpp"
 #include "types.hpp"
 
+#include <atomic>
 #include <fmt/format.h>
+#include <initializer_list>
 #include <limits>
 #include <vector>
 #include <z3++.h>
@@ -59,8 +61,8 @@ public:
 		}
 	}
 
-	auto add_clause(std::vector<lit_type>::const_iterator it,
-	                std::vector<lit_type>::const_iterator ie)
+	template<typename Iterator>
+	auto add_clause(Iterator it, Iterator ie)
 	{
 		z3::expr_vector vec(ctx_);
 		while (it != ie) {
@@ -84,6 +86,27 @@ public:
 		return result::states::dirty;
 	}
 
+	auto add_clause(std::initializer_list<lit_type> clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	auto add_clauses(clause_batch const& clauses)
+	{
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			add_clause(clauses.begin(i), clauses.end(i));
+		}
+		return result::states::dirty;
+	}
+
+	auto add_clauses(std::vector<std::vector<lit_type>> const& clauses)
+	{
+		for (auto const& clause : clauses) {
+			add_clause(clause.begin(), clause.end());
+		}
+		return result::states::dirty;
+	}
+
 	result get_model() const
 	{
 		assert(state_ == result::states::satisfiable);
@@ -109,6 +132,10 @@ public:
 	result::states solve(std::vector<lit_type> const& assumptions = {},
 	                     uint32_t conflict_limit = 0u)
 	{
+		if (interrupted_) {
+			state_ = result::states::undefined;
+			return state_;
+		}
 		z3::expr_vector vec(ctx_);
 		for (auto const& lit : assumptions)
 			vec.push_back(lit.is_complemented() ? !vars_[lit.variable()] :
@@ -131,9 +158,31 @@ public:
 		z3::reset_params();
 		return state_;
 	}
+
+	/*! \brief Asks `solve` to stop as soon as possible, it then returns `undefined`.
+	 *
+	 * May be called from another thread while `solve` runs.  The request holds until
+	 * `clear_interrupt`, hence it also stops the calls to `solve` made in between.
+	 */
+	void interrupt()
+	{
+		interrupted_ = true;
+		ctx_.interrupt();
+	}
+
+	void clear_interrupt()
+	{
+		interrupted_ = false;
+	}
 #pragma endregion
 
 #pragma region Properties
+	/*! \brief Returns whether an interrupt is pending. */
+	bool is_interrupted() const
+	{
+		return interrupted_;
+	}
+
 	uint32_t num_variables() const
 	{
 		return variable_counter_.back();
@@ -189,6 +238,9 @@ private:
 
 	/*! \brief Stacked counter for number of clauses */
 	std::vector<uint32_t> clause_counter_;
+
+	/*! \brief Whether an interrupt is pending */
+	std::atomic<bool> interrupted_{false};
 };
 
 } // namespace bill
@@ -0,0 +1,476 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "clause_exchange.hpp"
+#include "solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+namespace detail {
+
+/* Type-erased backend of a portfolio */
+class portfolio_member {
+public:
+	virtual ~portfolio_member() = default;
+
+	virtual void add_variables(uint32_t num_variables) = 0;
+	virtual bool add_clauses(clause_batch const& clauses) = 0;
+	virtual result::states solve(std::vector<lit_type> const& assumptions,
+	                             uint32_t conflict_limit) = 0;
+	virtual result get_model() const = 0;
+	virtual result get_core() const = 0;
+	virtual void interrupt() = 0;
+	virtual void clear_interrupt() = 0;
+	virtual void restart() = 0;
+	virtual void set_random_phase(uint32_t seed) = 0;
+	virtual bool can_share_clauses() const = 0;
+	virtual void share_clauses(clause_exchange& exchange) = 0;
+};
+
+template<typename Solver, typename = void>
+struct has_set_random_phase : std::false_type {};
+
+template<typename Solver>
+struct has_set_random_phase<
+    Solver, std::void_t<decltype(std::declval<Solver&>().set_random_phase(0u))>>
+    : std::true_type {};
+
+template<typename Solver, typename = void>
+struct has_share_clauses : std::false_type {};
+
+template<typename Solver>
+struct has_share_clauses<Solver, std::void_t<decltype(std::declval<Solver&>().share_clauses(
+                                     std::declval<clause_exchange&>()))>> : std::true_type {};
+
+template<solvers Backend>
+class portfolio_member_impl final : public portfolio_member {
+public:
+	void add_variables(uint32_t num_variables) override
+	{
+		solver_.add_variables(num_variables);
+	}
+
+	bool add_clauses(clause_batch const& clauses) override
+	{
+		return solver_.add_clauses(clauses);
+	}
+
+	result::states solve(std::vector<lit_type> const& assumptions,
+	                     uint32_t conflict_limit) override
+	{
+		return solver_.solve(assumptions, conflict_limit);
+	}
+
+	result get_model() const override
+	{
+		return solver_.get_model();
+	}
+
+	result get_core() const override
+	{
+		if constexpr (has_get_core<solver<Backend>>::value) {
+			return solver_.get_core();
+		} else {
+			return result(result::states::unsatisfiable);
+		}
+	}
+
+	void interrupt() override
+	{
+		solver_.interrupt();
+	}
+
+	void clear_interrupt() override
+	{
+		solver_.clear_interrupt();
+	}
+
+	void restart() override
+	{
+		solver_.restart();
+	}
+
+	void set_random_phase(uint32_t seed) override
+	{
+		if constexpr (has_set_random_phase<solver<Backend>>::value) {
+			solver_.set_random_phase(seed);
+		} else {
+			(void) seed;
+		}
+	}
+
+	bool can_share_clauses() const override
+	{
+		return has_share_clauses<solver<Backend>>::value;
+	}
+
+	void share_clauses(clause_exchange& exchange) override
+	{
+		if constexpr (has_share_clauses<solver<Backend>>::value) {
+			solver_.share_clauses(exchange);
+		} else {
+			(void) exchange;
+		}
+	}
+
+private:
+	solver<Backend> solver_;
+};
+
+inline std::unique_ptr<portfolio_member> make_portfolio_member(solvers backend)
+{
+	switch (backend) {
+	case solvers::glucose_41:
+		return std::make_unique<portfolio_member_impl<solvers::glucose_41>>();
+	case solvers::ghack:
+		return std::make_unique<portfolio_member_impl<solvers::ghack>>();
+	case solvers::bsat2:
+		return std::make_unique<portfolio_member_impl<solvers::bsat2>>();
+#if !defined(BILL_WINDOWS_PLATFORM)
+	case solvers::maple:
+		return std::make_unique<portfolio_member_impl<solvers::maple>>();
+	case solvers::bmcg:
+		return std::make_unique<portfolio_member_impl<solvers::bmcg>>();
+#endif
+#if defined(BILL_HAS_Z3)
+	case solvers::z3:
+		return std::make_unique<portfolio_member_impl<solvers::z3>>();
+#endif
+	}
+	return nullptr;
+}
+
+} // namespace detail
+
+/*! \brief A parallel portfolio of solvers.
+ *
+ * Every clause is given to all backends, and `solve` runs the backends on one thread each.  The
+ * first definite answer (satisfiable or unsatisfiable) is returned, and the other backends are
+ * stopped through their interrupt flags.  Models and cores are those of the backend that
+ * answered; cores are only available if that backend computes them (see `get_core`).
+ *
+ * The interface is the one of `solver<>`, including incremental solving under assumptions.
+ * Clauses are buffered in a `clause_batch` and passed to the backends at the next `solve`,
+ * before their threads start.  If a backend refuses them (a contradiction at level 0), the
+ * formula is unsatisfiable and no backend runs.  Backends that lost a race keep their learnt
+ * clauses for the next calls.
+ *
+ * A backend may appear several times.  Repeated backends, i.e., all occurrences but the first,
+ * branch on random polarities (`set_random_phase`) with distinct seeds, except for `bmcg` which
+ * has no randomization.
+ *
+ * With `share_clauses`, the backends `glucose_41`, `ghack` and `maple` also exchange short
+ * learnt clauses (see `clause_exchange`).
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      portfolio_solver solver({solvers::glucose_41, solvers::maple, solvers::glucose_41});
+      solver.add_variables(3u);
+      solver.add_clause({lit_type(0u), lit_type(1u)});
+      if (solver.solve({~lit_type(0u)}) == result::states::satisfiable) {
+        auto const model = solver.get_model().model();
+      }
+   \endverbatim
+ */
+class portfolio_solver {
+public:
+#pragma region Constructors
+	/*! \brief Creates a portfolio.
+	 *
+	 * \param backends Backends of the portfolio (default: all in-tree backends)
+	 */
+	explicit portfolio_solver(std::vector<solvers> const& backends = default_backends())
+	    : backends_(backends)
+	{
+		assert(!backends_.empty());
+		for (auto const backend : backends_) {
+			members_.emplace_back(detail::make_portfolio_member(backend));
+		}
+		configure();
+	}
+
+	/* disallow copying */
+	portfolio_solver(portfolio_solver const&) = delete;
+	portfolio_solver& operator=(portfolio_solver const&) = delete;
+
+	/*! \brief Returns all backends that are built without external dependencies. */
+	static std::vector<solvers> default_backends()
+	{
+#if defined(BILL_WINDOWS_PLATFORM)
+		return {solvers::glucose_41, solvers::ghack, solvers::bsat2};
+#else
+		return {solvers::glucose_41, solvers::ghack, solvers::maple, solvers::bsat2,
+		        solvers::bmcg};
+#endif
+	}
+#pragma endregion
+
+#pragma region Modifiers
+	/*! \brief Lets the backends that support it share learnt clauses.
+	 *
+	 * Clauses are shared from the next call to `solve` on, and after `restart`.
+	 */
+	void share_clauses(clause_exchange_params const& params = {})
+	{
+		auto const num_participants = std::count_if(
+		    members_.begin(), members_.end(),
+		    [](auto const& member) { return member->can_share_clauses(); });
+		if (num_participants < 2) {
+			return;
+		}
+		auto exchange = std::make_unique<clause_exchange>(num_participants, params);
+		for (auto& member : members_) {
+			if (member->can_share_clauses()) {
+				member->share_clauses(*exchange);
+			}
+		}
+		exchange_ = std::move(exchange);
+	}
+
+	void restart()
+	{
+		for (auto& member : members_) {
+			member->restart();
+		}
+		configure();
+		pending_.clear();
+		num_pending_variables_ = 0u;
+		num_variables_ = 0u;
+		num_clauses_ = 0u;
+		winner_ = -1;
+		refuted_ = false;
+		state_ = result::states::undefined;
+	}
+
+	var_type add_variable()
+	{
+		++num_pending_variables_;
+		return num_variables_++;
+	}
+
+	void add_variables(uint32_t num_variables = 1)
+	{
+		num_pending_variables_ += num_variables;
+		num_variables_ += num_variables;
+	}
+
+	template<typename Iterator>
+	bool add_clause(Iterator it, Iterator ie)
+	{
+		pending_.add_clause(it, ie);
+		++num_clauses_;
+		state_ = result::states::dirty;
+		return !refuted_;
+	}
+
+	bool add_clause(std::vector<lit_type> const& clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clause(std::initializer_list<lit_type> clause)
+	{
+		return add_clause(clause.begin(), clause.end());
+	}
+
+	bool add_clause(lit_type lit)
+	{
+		lit_type const* const begin = &lit;
+		return add_clause(begin, begin + 1);
+	}
+
+	bool add_clauses(clause_batch const& clauses)
+	{
+		for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+			add_clause(clauses.begin(i), clauses.end(i));
+		}
+		return !refuted_;
+	}
+
+	bool add_clauses(std::vector<std::vector<lit_type>> const& clauses)
+	{
+		for (auto const& clause : clauses) {
+			add_clause(clause);
+		}
+		return !refuted_;
+	}
+
+	result get_model() const
+	{
+		assert(state_ == result::states::satisfiable);
+		return members_.at(winner_)->get_model();
+	}
+
+	/*! \brief Returns the core of the backend that answered.
+	 *
+	 * Only `glucose_41`, `ghack` and `maple` compute cores; for the other backends, the result
+	 * is unsatisfiable but holds no core.  If the clauses were refused, the core is empty.
+	 */
+	result get_core() const
+	{
+		assert(state_ == result::states::unsatisfiable);
+		if (winner_ < 0) {
+			return result(result::clause_type());
+		}
+		return members_.at(winner_)->get_core();
+	}
+
+	result get_result() const
+	{
+		assert(state_ != result::states::dirty);
+		if (state_ == result::states::satisfiable) {
+			return get_model();
+		} else if (state_ == result::states::unsatisfiable) {
+			return get_core();
+		} else {
+			return result();
+		}
+	}
+
+	/*! \brief Runs all backends in parallel, until one of them answers.
+	 *
+	 * \param assumptions Assumptions of this call
+	 * \param conflict_limit Conflict limit of each backend (0 for no limit)
+	 */
+	result::states solve(std::vector<lit_type> const& assumptions = {},
+	                     uint32_t conflict_limit = 0)
+	{
+		for (auto& member : members_) {
+			if (num_pending_variables_ > 0u) {
+				member->add_variables(num_pending_variables_);
+			}
+			if (pending_.num_clauses() > 0u && !refuted_) {
+				refuted_ = !member->add_clauses(pending_);
+			}
+		}
+		pending_.clear();
+		num_pending_variables_ = 0u;
+		if (refuted_) {
+			winner_ = -1;
+			state_ = result::states::unsatisfiable;
+			return state_;
+		}
+
+		/* interrupts of the previous call must not leak into this one, and must not be cleared
+		 * by a backend that starts after another one answered */
+		for (auto& member : members_) {
+			member->clear_interrupt();
+		}
+		std::atomic<int32_t> winner{-1};
+		std::vector<result::states> states(members_.size(), result::states::undefined);
+		auto run = [&](uint32_t index) {
+			auto& member = *members_.at(index);
+			auto const state = member.solve(assumptions, conflict_limit);
+			states.at(index) = state;
+			if (state != result::states::satisfiable && state != result::states::unsatisfiable) {
+				return;
+			}
+			int32_t expected = -1;
+			if (winner.compare_exchange_strong(expected, static_cast<int32_t>(index))) {
+				for (auto i = 0u; i < members_.size(); ++i) {
+					if (i != index) {
+						members_.at(i)->interrupt();
+					}
+				}
+			}
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(members_.size() - 1u);
+		for (auto i = 1u; i < members_.size(); ++i) {
+			threads.emplace_back(run, i);
+		}
+		run(0u);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		winner_ = winner.load();
+		state_ = winner_ < 0 ? result::states::undefined : states.at(winner_);
+		return state_;
+	}
+#pragma endregion
+
+#pragma region Properties
+	uint32_t num_variables() const
+	{
+		return num_variables_;
+	}
+
+	uint32_t num_clauses() const
+	{
+		return num_clauses_;
+	}
+
+	uint32_t num_backends() const
+	{
+		return members_.size();
+	}
+
+	/*! \brief Returns the backend that answered the last call to `solve`, if any. */
+	int32_t winner() const
+	{
+		return winner_;
+	}
+
+	solvers backend(uint32_t index) const
+	{
+		return backends_.at(index);
+	}
+
+	/*! \brief Returns the exchange of learnt clauses, if the backends share clauses. */
+	clause_exchange const* exchange() const
+	{
+		return exchange_.get();
+	}
+#pragma endregion
+
+private:
+	/* Randomizes the repetitions of a backend */
+	void configure()
+	{
+		for (auto i = 0u; i < backends_.size(); ++i) {
+			auto const repetitions = std::count(backends_.begin(), backends_.begin() + i,
+			                                    backends_.at(i));
+			if (repetitions > 0) {
+				members_.at(i)->set_random_phase(static_cast<uint32_t>(repetitions));
+			}
+		}
+	}
+
+private:
+	std::vector<solvers> backends_;
+	std::vector<std::unique_ptr<detail::portfolio_member>> members_;
+	std::unique_ptr<clause_exchange> exchange_;
+
+	/*! \brief Clauses and variables not yet passed to the backends */
+	clause_batch pending_;
+	uint32_t num_pending_variables_ = 0u;
+
+	uint32_t num_variables_ = 0u;
+	uint32_t num_clauses_ = 0u;
+	int32_t winner_ = -1;
+	/*! \brief Whether a backend refused the clauses, i.e., found a contradiction at level 0 */
+	bool refuted_ = false;
+	result::states state_ = result::states::undefined;
+};
+
+} // namespace bill
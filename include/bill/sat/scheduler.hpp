@@ -0,0 +1,311 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "solve_async.hpp"
+#include "solver.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Parameters of `solver_scheduler` */
+struct solver_scheduler_params {
+	/*! \brief Number of worker threads (0: one per hardware thread) */
+	uint32_t num_threads = 0u;
+
+	/*! \brief Conflicts per slice */
+	uint32_t conflict_slice = 1000u;
+
+	/*! \brief Estimated memory of the sessions in flight, in bytes (0 for no limit) */
+	uint64_t memory_limit = 0u;
+};
+
+/*! \brief Runs many solving sessions on a few threads, in slices of conflicts.
+ *
+ * A session is a call to `solve` on a solver owned by the caller.  The workers advance the
+ * sessions in flight by `conflict_slice` conflicts at a time, as `solve(assumptions, limit)`
+ * calls, and put them back in line until they answer.  Since the backends keep their learnt
+ * clauses, activities and saved phases between calls, a slice continues the search of the
+ * previous one from its last restart.  A long session hence only delays the others by one slice.
+ *
+ * The workers pick the session with the smallest pass, which grows by `1 / priority` per slice
+ * (stride scheduling): sessions of equal priority get slices in turn, and a session of priority 2
+ * gets twice as many slices as one of priority 1.
+ *
+ * Sessions are admitted in submission order while the estimated memory of the sessions in
+ * flight stays within `memory_limit`; the others wait.  At least one session is always in flight.
+ * The estimate grows with the numbers of variables and clauses of the solver at submission.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      solver_scheduler_params params;
+      params.num_threads = 4u;
+      solver_scheduler<solver<solvers::glucose_41>> scheduler(params);
+      auto answer = scheduler.submit(solver, {lit_type(0u)});
+      // ... `solver` must not be used until `answer` is ready
+   \endverbatim
+ */
+template<typename Solver = solver<>>
+class solver_scheduler {
+	struct session {
+		Solver* solver;
+		std::vector<lit_type> assumptions;
+		deadline_clock::time_point deadline;
+		uint64_t stride;
+		uint64_t memory;
+		uint64_t pass = 0u;
+		uint64_t sequence = 0u;
+		bool cancelled = false;
+		std::promise<result::states> promise;
+	};
+
+	/* Orders the sessions in line by pass, then by their turn */
+	struct later {
+		bool operator()(session const* a, session const* b) const
+		{
+			return a->pass != b->pass ? a->pass > b->pass : a->sequence > b->sequence;
+		}
+	};
+
+public:
+#pragma region Constructors
+	explicit solver_scheduler(solver_scheduler_params const& params = {})
+	    : params_(params)
+	{
+		if (params_.num_threads == 0u) {
+			params_.num_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		params_.conflict_slice = std::max(1u, params_.conflict_slice);
+		for (auto i = 0u; i < params_.num_threads; ++i) {
+			workers_.emplace_back([this]() { work(); });
+		}
+	}
+
+	/*! \brief Finishes the running slices, the unanswered sessions then hold `undefined`. */
+	~solver_scheduler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopped_ = true;
+		}
+		ready_.notify_all();
+		for (auto& worker : workers_) {
+			worker.join();
+		}
+		for (auto& [solver, s] : sessions_) {
+			if (s->cancelled) {
+				solver->clear_interrupt();
+			}
+			s->promise.set_value(result::states::undefined);
+		}
+	}
+
+	/* disallow copying */
+	solver_scheduler(solver_scheduler const&) = delete;
+	solver_scheduler& operator=(solver_scheduler const&) = delete;
+#pragma endregion
+
+#pragma region Modifiers
+	/*! \brief Submits a session, which the future answers.
+	 *
+	 * Clears the pending interrupts of `solver`, which must not be used until the future is
+	 * ready and must not be in another session.
+	 *
+	 * \param solver Solver of the session, which must outlive the session
+	 * \param assumptions Assumptions of the session
+	 * \param priority Share of the slices, relative to the other sessions (at least 1)
+	 * \param deadline Deadline, checked between slices; the future then holds `timeout`
+	 */
+	std::future<result::states> submit(Solver& solver, std::vector<lit_type> assumptions = {},
+	                                   uint32_t priority = 1u,
+	                                   deadline_clock::time_point deadline
+	                                   = deadline_clock::time_point::max())
+	{
+		solver.clear_interrupt();
+		auto s = std::make_unique<session>();
+		s->solver = &solver;
+		s->assumptions = std::move(assumptions);
+		s->deadline = deadline;
+		s->stride = max_stride / std::max(1u, priority);
+		s->memory = estimated_memory(solver);
+		auto answer = s->promise.get_future();
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		assert(sessions_.count(&solver) == 0u);
+		waiting_.emplace_back(s.get());
+		sessions_.emplace(&solver, std::move(s));
+		admit();
+		return answer;
+	}
+
+	/*! \brief Cancels the session of `solver`, whose future then holds `undefined`.
+	 *
+	 * Stops a running slice through the interrupt of the solver.  Returns false if `solver` is
+	 * in no session.
+	 */
+	bool cancel(Solver& solver)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto const it = sessions_.find(&solver);
+		if (it == sessions_.end()) {
+			return false;
+		}
+		it->second->cancelled = true;
+		solver.interrupt();
+		return true;
+	}
+#pragma endregion
+
+#pragma region Properties
+	uint32_t num_threads() const
+	{
+		return params_.num_threads;
+	}
+
+	/*! \brief Returns the number of unanswered sessions, in flight or waiting. */
+	uint32_t num_sessions() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return sessions_.size();
+	}
+
+	/*! \brief Returns the number of sessions waiting for admission. */
+	uint32_t num_waiting() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return waiting_.size();
+	}
+
+	/*! \brief Returns the estimated memory of the sessions in flight, in bytes. */
+	uint64_t memory_in_flight() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return memory_in_flight_;
+	}
+
+	/*! \brief Returns the estimated memory of a session, in bytes.
+	 *
+	 * Counts the watch lists, heap entries and assignment of each variable, and the literals,
+	 * header and watches of each clause, twice for the learnt clauses to come.
+	 */
+	static uint64_t estimated_memory(Solver const& solver)
+	{
+		return 128u * solver.num_variables() + 2u * 64u * solver.num_clauses();
+	}
+#pragma endregion
+
+private:
+	/* Moves waiting sessions in flight, while the memory limit allows; with the lock held */
+	void admit()
+	{
+		while (!waiting_.empty()) {
+			auto* const s = waiting_.front();
+			if (params_.memory_limit != 0u && num_in_flight_ > 0u
+			    && memory_in_flight_ + s->memory > params_.memory_limit) {
+				break;
+			}
+			waiting_.pop_front();
+			++num_in_flight_;
+			memory_in_flight_ += s->memory;
+			/* start at the current pass, so that the session neither jumps ahead nor waits for
+			 * the slices that the others had before it came */
+			s->pass = pass_;
+			s->sequence = sequence_++;
+			line_.push(s);
+			ready_.notify_one();
+		}
+	}
+
+	/* Answers a session in flight; with the lock held */
+	void finish(session* s, result::states state)
+	{
+		if (s->cancelled) {
+			s->solver->clear_interrupt();
+		}
+		--num_in_flight_;
+		memory_in_flight_ -= s->memory;
+		s->promise.set_value(state);
+		sessions_.erase(s->solver);
+		admit();
+	}
+
+	void work()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (true) {
+			ready_.wait(lock, [&]() { return stopped_ || !line_.empty(); });
+			if (stopped_) {
+				return;
+			}
+			auto* const s = line_.top();
+			line_.pop();
+			pass_ = s->pass;
+			if (s->cancelled) {
+				finish(s, result::states::undefined);
+				continue;
+			}
+			if (deadline_clock::now() >= s->deadline) {
+				finish(s, result::states::timeout);
+				continue;
+			}
+
+			lock.unlock();
+			auto const state = s->solver->solve(s->assumptions, params_.conflict_slice);
+			lock.lock();
+
+			if (s->cancelled) {
+				finish(s, result::states::undefined);
+			} else if (state != result::states::undefined) {
+				finish(s, state);
+			} else {
+				s->pass += s->stride;
+				s->sequence = sequence_++;
+				line_.push(s);
+			}
+		}
+	}
+
+private:
+	static constexpr uint64_t max_stride = 1u << 20;
+
+	solver_scheduler_params params_;
+	std::vector<std::thread> workers_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable ready_;
+	bool stopped_ = false;
+
+	/*! \brief Unanswered sessions, by solver */
+	std::unordered_map<Solver*, std::unique_ptr<session>> sessions_;
+
+	/*! \brief Sessions waiting for admission, in submission order */
+	std::deque<session*> waiting_;
+
+	/*! \brief Sessions in flight that no worker runs, by pass */
+	std::priority_queue<session*, std::vector<session*>, later> line_;
+
+	uint32_t num_in_flight_ = 0u;
+	uint64_t memory_in_flight_ = 0u;
+	uint64_t pass_ = 0u;
+	uint64_t sequence_ = 0u;
+};
+
+} // namespace bill
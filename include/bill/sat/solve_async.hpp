@@ -0,0 +1,101 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "interface/common.hpp"
+#include "interface/types.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Clock of the deadlines of `solve_async` */
+using deadline_clock = std::chrono::steady_clock;
+
+/*! \brief Solves on another thread, until an answer, a cancellation or a wall-clock deadline.
+ *
+ * Pending interrupts of `solver` are cleared before the call starts, so the call may be
+ * cancelled with `solver.interrupt()` as soon as `solve_async` returns; the future then holds
+ * `undefined`.  When the deadline expires, a watchdog thread interrupts the solver in the same
+ * way and the future holds `timeout`, unless the solver answered in the meantime.  The
+ * interrupt of the deadline is cleared when the call ends, the one of a cancellation holds
+ * until `clear_interrupt`.  The watchdog does not fire once the call is cancelled, hence a
+ * cancellation followed by the deadline still yields `undefined`; a cancellation after the
+ * deadline fired cannot be told apart from it.
+ *
+ * `solver` must not be used until the future is ready, except for `interrupt`.  Backends check
+ * their interrupt flags between conflicts (bsat2 every 64 conflicts), so the call may overrun the
+ * deadline by a few conflicts.
+ *
+ * \param solver Solver with `solve`, `interrupt`, `clear_interrupt` and `is_interrupted`, which
+ *               must outlive the call
+ * \param assumptions Assumptions of the call
+ * \param deadline Deadline of the call (default: none)
+ * \param conflict_limit Conflict limit of the call (0 for no limit)
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      solver<solvers::glucose_41> solver;
+      // ... add variables and clauses
+      auto answer = solve_async(solver, {}, deadline_clock::now() + std::chrono::seconds(1));
+      if (answer.get() == result::states::timeout) {
+        // ... retry later, the solver keeps its learnt clauses
+      }
+   \endverbatim
+ */
+template<typename Solver>
+std::future<result::states> solve_async(Solver& solver, std::vector<lit_type> assumptions = {},
+                                        deadline_clock::time_point deadline
+                                        = deadline_clock::time_point::max(),
+                                        uint32_t conflict_limit = 0u)
+{
+	solver.clear_interrupt();
+	auto task = [&solver, assumptions = std::move(assumptions), deadline, conflict_limit]() {
+		if (deadline == deadline_clock::time_point::max()) {
+			return solver.solve(assumptions, conflict_limit);
+		}
+
+		std::mutex mutex;
+		std::condition_variable finished;
+		bool done = false;
+		bool expired = false;
+		std::thread watchdog([&]() {
+			std::unique_lock<std::mutex> lock(mutex);
+			/* a pending interrupt is a cancellation, which the call must not clear */
+			if (!finished.wait_until(lock, deadline, [&]() { return done; })
+			    && !solver.is_interrupted()) {
+				expired = true;
+				solver.interrupt();
+			}
+		});
+		auto const state = solver.solve(assumptions, conflict_limit);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			done = true;
+		}
+		finished.notify_one();
+		watchdog.join();
+
+		if (!expired) {
+			return state;
+		}
+		solver.clear_interrupt();
+		return state == result::states::undefined ? result::states::timeout : state;
+	};
+	return std::async(std::launch::async, std::move(task));
+}
+
+} // namespace bill
@@ -377,6 +377,9 @@ class RegionAllocator
     Ref      ael       (const T* t)  { assert((void*)t >= (void*)&memory[0] && (void*)t < (void*)&memory[sz-1]);
         return  (Ref)(t - &memory[0]); }
 
+    // Frees all regions at once, keeping the memory.
+    void     clear     ()            { sz = 0; wasted_ = 0; }
+
     void     moveTo(RegionAllocator& to) {
         if (to.memory != NULL) ::free(to.memory);
         to.memory = memory;
@@ -1820,6 +1823,15 @@ class OccLists
         dirty  .clear(free);
         dirties.clear(free);
     }
+
+    // Empties all lists, keeping the memory of each list.
+    void  clearLists(){
+        for (int i = 0; i < occs.size(); i++){
+            occs[i].clear();
+            dirty[i] = 0;
+        }
+        dirties.clear();
+    }
 };
 
 
@@ -2140,6 +2152,8 @@ public:
     Solver();
     virtual ~Solver();
 
+    void    reset();          // Returns to the state of a new solver, keeping the allocated memory.
+
     // Problem specification:
     //
     Var     newVar    (bool polarity = true, bool dvar = true); // Add a new variable with parameters specifying variable mode.
@@ -2415,6 +2429,12 @@ protected:
     int      level            (Var x) const;
     double   progressEstimate ()      const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
     bool     withinBudget     ()      const;
+
+    // Clause sharing, with the hooks of the parallel version of Glucose 4.1
+    // (empty in the sequential solver, see bill/sat/clause_exchange.hpp)
+    virtual bool parallelImportClauses(); // true if the empty clause was received
+    virtual void parallelExportUnaryClause(Lit p);
+    virtual void parallelExportClauseDuringSearch(Clause &c);
     inline bool isSelector(Var v) {return (incremental && v>nbVarsInitialFormula);}
 
     // Static helpers:
@@ -2509,6 +2529,9 @@ inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
+inline bool     Solver::parallelImportClauses(){ return false; }
+inline void     Solver::parallelExportUnaryClause(Lit p){}
+inline void     Solver::parallelExportClauseDuringSearch(Clause &c){}
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
@@ -2741,6 +2764,103 @@ inline Solver::~Solver()
 {
 }
 
+// Returns to the state of the constructor, but empties the containers instead of freeing them.
+// The proof output, if any, is kept.
+inline void Solver::reset()
+{
+    model.clear();
+    conflict.clear();
+
+    // Parameters (user settable):
+    //
+    verbosity = 0;
+    showModel = 0;
+    K = opt_K;
+    R = opt_R;
+    sizeLBDQueue = opt_size_lbd_queue;
+    sizeTrailQueue = opt_size_trail_queue;
+    firstReduceDB = opt_first_reduce_db;
+    incReduceDB = opt_inc_reduce_db;
+    specialIncReduceDB = opt_spec_inc_reduce_db;
+    lbLBDFrozenClause = opt_lb_lbd_frozen_clause;
+    lbSizeMinimizingClause = opt_lb_size_minimzing_clause;
+    lbLBDMinimizingClause = opt_lb_lbd_minimzing_clause;
+    var_decay = opt_var_decay;
+    clause_decay = opt_clause_decay;
+    random_var_freq = opt_random_var_freq;
+    random_seed = opt_random_seed;
+    ccmin_mode = opt_ccmin_mode;
+    phase_saving = opt_phase_saving;
+    rnd_pol = false;
+    rnd_init_act = opt_rnd_init_act;
+    garbage_frac = opt_garbage_frac;
+
+    // Statistics: (formerly in 'SolverStats')
+    //
+    nbRemovedClauses = nbReducedClauses = nbDL2 = nbBin = nbUn = nbReduceDB = 0;
+    solves = starts = decisions = rnd_decisions = propagations = conflicts = conflictsRestarts = 0;
+    nbstopsrestarts = nbstopsrestartssame = lastblockatrestart = 0;
+    dec_vars = clauses_literals = learnts_literals = max_literals = tot_literals = 0;
+    curRestart = 1;
+
+    // Solver state:
+    //
+    ok = true;
+    cla_inc = 1;
+    activity.clear();
+    var_inc = 1;
+    watches.clearLists();
+    watchesBin.clearLists();
+    clauses.clear();
+    learnts.clear();
+    C.clear();
+    T.clear();
+    assigns.clear();
+    polarity.clear();
+    decision.clear();
+    trail.clear();
+    nbpos.clear();
+    trail_lim.clear();
+    vardata.clear();
+    qhead = 0;
+    simpDB_assigns = -1;
+    simpDB_props = 0;
+    assumptions.clear();
+    order_heap.clear();
+    progress_estimate = 0;
+    remove_satisfied = true;
+    permDiff.clear();
+#ifdef UPDATEVARACTIVITY
+    lastDecisionLevel.clear();
+#endif
+    ca.clear();
+    seen.clear();
+    analyze_stack.clear();
+    analyze_toclear.clear();
+    add_tmp.clear();
+
+    // Resource constraints:
+    //
+    conflict_budget = -1;
+    propagation_budget = -1;
+    asynch_interrupt = false;
+    incremental = opt_incremental;
+    nbVarsInitialFormula = INT32_MAX;
+    assumptionPositions.clear();
+    initialPositions.clear();
+
+    MYFLAG=H=Y=O=e=0;
+    G=1; A=4; Z=15000;
+    lbdQueue.clear();
+    trailQueue.clear();
+    lbdQueue.initSize(sizeLBDQueue);
+    trailQueue.initSize(sizeTrailQueue);
+    sumLBD = 0;
+    nbclausesbeforereduce = firstReduceDB;
+    totalTime4Sat=0;totalTime4Unsat=0;
+    nbSatCalls=0;nbUnsatCalls=0;
+}
+
 
 /****************************************************************
  Set the incremental mode
@@ -3662,6 +3782,8 @@ inline lbool Solver::search(int& n//of_conflicts
     unsigned int nblevels,szWoutSelectors;
     bool blocked=false;
     starts++;
+    if (decisionLevel() == 0 && parallelImportClauses())
+        return l_False;
     for (;;){
         CRef confl = propagate();
         if (confl != CRef_Undef){
@@ -3723,6 +3845,7 @@ inline lbool Solver::search(int& n//of_conflicts
 
             if (learnt_clause.size() == 1){
 	      uncheckedEnqueue(learnt_clause[0]);nbUn++;
+	      parallelExportUnaryClause(learnt_clause[0]);
             }else{
                 #define EE ca[cr]
                 CRef cr = ca.alloc(learnt_clause, true);
@@ -3740,6 +3863,7 @@ inline lbool Solver::search(int& n//of_conflicts
               }else{
                 learnts.push(cr); B(EE); }
                 attachClause(cr);
+                parallelExportClauseDuringSearch(ca[cr]);
 
                 //claBumpActivity(ca[cr]);
                 uncheckedEnqueue(learnt_clause[0], cr);
@@ -3752,7 +3876,7 @@ inline lbool Solver::search(int& n//of_conflicts
 	  // Our dynamic restart, see the SAT09 competition compagnion paper 
 	  if ((!G && n <= 0) || (G &&
 	      ( lbdQueue.isvalid() && ((lbdQueue.getavg()*(n > 0 ? K : .9)) > (sumLBD / H//conflictsRestarts
-              ))))) {
+              )))) || !withinBudget()) {
 	    lbdQueue.fastclear();
 	    progress_estimate = progressEstimate();
 	    int bt = 0;
@@ -3912,10 +4036,10 @@ printf("c ==================================[ Search Statistics (every %6d confl
      w = !H ? 10000 : a + G * a;
 
      var_decay = G ? .95 : .999;
-     while (status == l_Undef && w > 0)
+     while (status == l_Undef && w > 0 && withinBudget())
       status = search(w); // the parameter is useless in glucose, kept to allow modifications
 
-        //if (!withinBudget()) break;
+        if (!withinBudget()) break;
         curr_restarts++;
 
         if (!(G = !G)) a += a / 10;
@@ -400,6 +400,9 @@ class RegionAllocator
     Ref      ael       (const T* t)  { assert((void*)t >= (void*)&memory[0] && (void*)t < (void*)&memory[sz-1]);
         return  (Ref)(t - &memory[0]); }
 
+    // Frees all regions at once, keeping the memory.
+    void     clear     ()            { sz = 0; wasted_ = 0; }
+
     void     moveTo(RegionAllocator& to) {
         if (to.memory != NULL) ::free(to.memory);
         to.memory = memory;
@@ -1977,6 +1980,15 @@ class OccLists
         dirty  .clear(free);
         dirties.clear(free);
     }
+
+    // Empties all lists, keeping the memory of each list.
+    void  clearLists(){
+        for (int i = 0; i < occs.size(); i++){
+            occs[i].clear();
+            dirty[i] = 0;
+        }
+        dirties.clear();
+    }
 };
 
 
@@ -2515,6 +2527,8 @@ public:
     Solver(const  Solver &s);
     
     virtual ~Solver();
+
+    void    reset();          // Returns to the state of a new solver, keeping the allocated memory.
     
     /**
      * Clone function
@@ -3262,6 +3276,123 @@ verbosity(0)
     stats.growTo(coreStatsSize, 0);
 }
 
+//-------------------------------------------------------
+// Returns to the state of the constructor, but empties the containers instead of freeing them
+//-------------------------------------------------------
+
+inline void Solver::reset()
+{
+    model.clear();
+    conflict.clear();
+
+    // Parameters (user settable):
+    //
+    verbosity = 0;
+    showModel = 0;
+    K = opt_K;
+    R = opt_R;
+    sizeLBDQueue = opt_size_lbd_queue;
+    sizeTrailQueue = opt_size_trail_queue;
+    firstReduceDB = opt_first_reduce_db;
+    incReduceDB = opt_chanseok_hack ? 0 : opt_inc_reduce_db;
+    specialIncReduceDB = opt_chanseok_hack ? 0 : opt_spec_inc_reduce_db;
+    lbLBDFrozenClause = opt_lb_lbd_frozen_clause;
+    chanseokStrategy = opt_chanseok_hack;
+    coLBDBound = opt_chanseok_limit;
+    lbSizeMinimizingClause = opt_lb_size_minimzing_clause;
+    lbLBDMinimizingClause = opt_lb_lbd_minimzing_clause;
+    var_decay = opt_var_decay;
+    max_var_decay = opt_max_var_decay;
+    clause_decay = opt_clause_decay;
+    random_var_freq = opt_random_var_freq;
+    random_seed = opt_random_seed;
+    ccmin_mode = opt_ccmin_mode;
+    phase_saving = opt_phase_saving;
+    rnd_pol = false;
+    rnd_init_act = opt_rnd_init_act;
+    randomizeFirstDescent = false;
+    garbage_frac = opt_garbage_frac;
+    certifiedOutput = NULL;
+    certifiedUNSAT = false;
+    vbyte = false;
+    panicModeLastRemoved = panicModeLastRemovedShared = 0;
+    useUnaryWatched = false;
+    promoteOneWatchedClause = true;
+    solves = starts = decisions = propagations = conflicts = conflictsRestarts = 0;
+    curRestart = 1;
+    glureduce = opt_glu_reduction;
+    restart_inc = opt_restart_inc;
+    luby_restart = opt_luby_restart;
+    adaptStrategies = opt_adapt;
+    luby_restart_factor = opt_luby_restart_factor;
+    randomize_on_restarts = opt_randomize_phase_on_restarts;
+    fixed_randomize_on_restarts = opt_fixed_randomize_phase_on_restarts;
+    newDescent = 0;
+    randomDescentAssignments = 0;
+    forceUnsatOnNewDescent = opt_forceunsat;
+
+    // Solver state:
+    //
+    ok = true;
+    cla_inc = 1;
+    activity.clear();
+    var_inc = 1;
+    watches.clearLists();
+    watchesBin.clearLists();
+    unaryWatches.clearLists();
+    clauses.clear();
+    learnts.clear();
+    permanentLearnts.clear();
+    unaryWatchedClauses.clear();
+    assigns.clear();
+    polarity.clear();
+    forceUNSAT.clear();
+    decision.clear();
+    trail.clear();
+    nbpos.clear();
+    trail_lim.clear();
+    vardata.clear();
+    qhead = 0;
+    simpDB_assigns = -1;
+    simpDB_props = 0;
+    assumptions.clear();
+    order_heap.clear();
+    progress_estimate = 0;
+    remove_satisfied = true;
+    permDiff.clear();
+    lastDecisionLevel.clear();
+    ca.clear();
+    lastLearntClause = CRef_Undef;
+    seen.clear();
+    analyze_stack.clear();
+    analyze_toclear.clear();
+    add_tmp.clear();
+
+    // Resource constraints:
+    //
+    conflict_budget = -1;
+    propagation_budget = -1;
+    asynch_interrupt = false;
+    incremental = false;
+    nbVarsInitialFormula = INT32_MAX;
+    totalTime4Sat = 0.;
+    totalTime4Unsat = 0.;
+    nbSatCalls = 0;
+    nbUnsatCalls = 0;
+    assumptionPositions.clear();
+    initialPositions.clear();
+
+    MYFLAG = 0;
+    lbdQueue.clear();
+    trailQueue.clear();
+    lbdQueue.initSize(sizeLBDQueue);
+    trailQueue.initSize(sizeTrailQueue);
+    sumLBD = 0;
+    nbclausesbeforereduce = firstReduceDB;
+    stats.clear();
+    stats.growTo(coreStatsSize, 0);
+}
+
 //-------------------------------------------------------
 // Special constructor used for cloning solvers
 //-------------------------------------------------------
@@ -371,6 +371,9 @@ class RegionAllocator
     Ref      ael       (const T* t)  { assert((void*)t >= (void*)&memory[0] && (void*)t < (void*)&memory[sz-1]);
         return  (Ref)(t - &memory[0]); }
 
+    // Frees all regions at once, keeping the memory.
+    void     clear     ()            { sz = 0; wasted_ = 0; }
+
     void     moveTo(RegionAllocator& to) {
         if (to.memory != NULL) ::free(to.memory);
         to.memory = memory;
@@ -1807,6 +1810,15 @@ public:
         dirty  .clear(free);
         dirties.clear(free);
     }
+
+    // Empties all lists, keeping the memory of each list.
+    void  clearLists(){
+        for (int i = 0; i < occs.size(); i++){
+            occs[i].clear();
+            dirty[i] = 0;
+        }
+        dirties.clear();
+    }
 };
 
 
@@ -2038,6 +2050,8 @@ public:
     Solver();
     virtual ~Solver();
 
+    void    reset();          // Returns to the state of a new solver, keeping the allocated memory.
+
     // Problem specification:
     //
     Var     newVar    (bool polarity = true, bool dvar = true); // Add a new variable with parameters specifying variable mode.
@@ -2302,6 +2316,12 @@ protected:
     double   progressEstimate ()      const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
     bool     withinBudget     ()      const;
 
+    // Clause sharing, with the hooks of the parallel version of Glucose 4.1
+    // (empty in the sequential solver, see bill/sat/clause_exchange.hpp)
+    virtual bool parallelImportClauses(); // true if the empty clause was received
+    virtual void parallelExportUnaryClause(Lit p);
+    virtual void parallelExportClauseDuringSearch(Clause &c);
+
     template<class V> int computeLBD(const V& c) {
         int lbd = 0;
 
@@ -2487,6 +2507,9 @@ inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
+inline bool     Solver::parallelImportClauses(){ return false; }
+inline void     Solver::parallelExportUnaryClause(Lit p){}
+inline void     Solver::parallelExportClauseDuringSearch(Clause &c){}
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
@@ -2671,6 +2694,127 @@ inline Solver::~Solver()
 {
 }
 
+// Returns to the state of the constructor, but empties the containers instead of freeing them.
+inline void Solver::reset()
+{
+    model.clear();
+    conflict.clear();
+
+    // Parameters (user settable):
+    //
+    drup_file = NULL;
+    verbosity = 0;
+    step_size = opt_step_size;
+    step_size_dec = opt_step_size_dec;
+    min_step_size = opt_min_step_size;
+    timer = 5000;
+    var_decay = opt_var_decay;
+    clause_decay = opt_clause_decay;
+    random_var_freq = opt_random_var_freq;
+    random_seed = opt_random_seed;
+    VSIDS = false;
+    ccmin_mode = opt_ccmin_mode;
+    phase_saving = opt_phase_saving;
+    rnd_pol = false;
+    rnd_init_act = opt_rnd_init_act;
+    garbage_frac = opt_garbage_frac;
+    restart_first = opt_restart_first;
+    restart_inc = opt_restart_inc;
+
+    // Parameters (the rest):
+    //
+    learntsize_factor = (double)1/(double)3;
+    learntsize_inc = 1.1;
+
+    // Parameters (experimental):
+    //
+    learntsize_adjust_start_confl = 100;
+    learntsize_adjust_inc = 1.5;
+
+    // Statistics: (formerly in 'SolverStats')
+    //
+    solves = starts = decisions = rnd_decisions = propagations = conflicts = conflicts_VSIDS = 0;
+    dec_vars = clauses_literals = learnts_literals = max_literals = tot_literals = 0;
+    chrono_backtrack = non_chrono_backtrack = 0;
+    nbcollectfirstuip = nblearntclause = nbDoubleConflicts = nbTripleConflicts = 0;
+
+    // Solver state:
+    //
+    picked.clear();
+    conflicted.clear();
+    almost_conflicted.clear();
+#ifdef ANTI_EXPLORATION
+    canceled.clear();
+#endif
+    ok = true;
+    clauses.clear();
+    learnts_core.clear();
+    learnts_tier2.clear();
+    learnts_local.clear();
+    cla_inc = 1;
+    activity_CHB.clear();
+    activity_VSIDS.clear();
+    activity_distance.clear();
+    var_inc = 1;
+    watches_bin.clearLists();
+    watches.clearLists();
+    assigns.clear();
+    polarity.clear();
+    decision.clear();
+    trail.clear();
+    trail_lim.clear();
+    vardata.clear();
+    qhead = 0;
+    simpDB_assigns = -1;
+    simpDB_props = 0;
+    assumptions.clear();
+    order_heap_CHB.clear();
+    order_heap_VSIDS.clear();
+    order_heap_distance.clear();
+    progress_estimate = 0;
+    remove_satisfied = true;
+    core_lbd_cut = 3;
+    global_lbd_sum = 0;
+    lbd_queue.clear();
+    next_T2_reduce = 10000;
+    next_L_reduce = 15000;
+    ca.clear();
+    confl_to_chrono = opt_conf_to_chrono;
+    chrono = opt_chrono;
+    seen.clear();
+    analyze_stack.clear();
+    analyze_toclear.clear();
+    add_tmp.clear();
+    add_oc.clear();
+    seen2.clear();
+    counter = 0;
+
+    // Resource constraints:
+    //
+    conflict_budget = -1;
+    propagation_budget = -1;
+    asynch_interrupt = false;
+
+    // simplfiy
+    nbSimplifyAll = 0;
+    s_propagations = 0;
+    simp_learnt_clause.clear();
+    simp_reason_clause.clear();
+
+    // simplifyAll adjust occasion
+    curSimplify = 1;
+    nbconfbeforesimplify = 1000;
+    incSimplify = 1000;
+
+    var_iLevel.clear();
+    var_iLevel_tmp.clear();
+    pathCs.clear();
+    involved_lits.clear();
+    my_var_decay = 0.6;
+    DISTANCE = true;
+    var_iLevel_inc = 1;
+}
+
 
 // simplify All
 //
@@ -4370,6 +4514,9 @@ inline lbool Solver::search(int& nof_conflicts)
         nbconfbeforesimplify += incSimplify;
     }
 
+    if (decisionLevel() == 0 && parallelImportClauses())
+        return l_False;
+
     for (;;){
         CRef confl = propagate();
 
@@ -4418,6 +4565,7 @@ inline lbool Solver::search(int& nof_conflicts)
 
             if (learnt_clause.size() == 1){
                 uncheckedEnqueue(learnt_clause[0]);
+                parallelExportUnaryClause(learnt_clause[0]);
             }else{
                 CRef cr = ca.alloc(learnt_clause, true);
                 ca[cr].set_lbd(lbd);
@@ -4432,6 +4580,7 @@ inline lbool Solver::search(int& nof_conflicts)
                     learnts_local.push(cr);
                     claBumpActivity(ca[cr]); }
                 attachClause(cr);
+                parallelExportClauseDuringSearch(ca[cr]);
 
                 uncheckedEnqueue(learnt_clause[0], backtrack_level, cr);
 #ifdef PRINT_OUT
@@ -4473,7 +4622,7 @@ inline lbool Solver::search(int& nof_conflicts)
                 restart = lbd_queue.full() && (lbd_queue.avg() * 0.8 > global_lbd_sum / conflicts_VSIDS);
                 cached = true;
             }
-            if (restart /*|| !withinBudget()*/){
+            if (restart || !withinBudget()){
                 lbd_queue.clear();
                 cached = false;
                 // Reached bound on number of conflicts:
@@ -4602,13 +4751,13 @@ inline lbool Solver::solve_()
 
     VSIDS = true;
     int init = 10000;
-    while (status == l_Undef && init > 0 /*&& withinBudget()*/)
+    while (status == l_Undef && init > 0 && withinBudget())
         status = search(init);
     VSIDS = false;
 
     // Search:
     int curr_restarts = 0;
-    while (status == l_Undef /*&& withinBudget()*/){
+    while (status == l_Undef && withinBudget()){
         if (VSIDS){
             int weighted = INT32_MAX;
             status = search(weighted);
@@ -0,0 +1,228 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "solver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Parameters of `solver_farm` */
+struct solver_farm_params {
+	/*! \brief Number of worker threads (0: one per hardware thread) */
+	uint32_t num_threads = 0u;
+
+	/*! \brief Conflict limit per job (0 for no limit) */
+	uint32_t conflict_limit = 0u;
+};
+
+/*! \brief Solves many small independent problems on a pool of threads.
+ *
+ * A job is a `clause_batch` and assumptions; its future holds the model, the core (for backends
+ * with `get_core`), or the state of the call.  Each worker thread owns one solver, which it
+ * resets with `restart` between jobs instead of constructing a new one.
+ *
+ * Jobs are distributed round-robin over the queues of the workers.  A worker takes the oldest
+ * job of its own queue, and steals the newest job of another queue when its own is empty.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      solver_farm<solver<solvers::glucose_41>> farm;
+      std::vector<std::future<result>> answers;
+      for (auto const& clauses : problems) {
+        answers.emplace_back(farm.submit(clauses));
+      }
+   \endverbatim
+ */
+template<typename Solver = solver<>>
+class solver_farm {
+	struct job {
+		clause_batch clauses;
+		std::vector<lit_type> assumptions;
+		uint32_t num_variables;
+		std::promise<result> promise;
+	};
+
+	/* Jobs of one worker: the owner takes from the front, thieves from the back */
+	struct job_queue {
+		std::mutex mutex;
+		std::deque<job> jobs;
+	};
+
+public:
+#pragma region Constructors
+	explicit solver_farm(solver_farm_params const& params = {})
+	    : params_(params)
+	{
+		if (params_.num_threads == 0u) {
+			params_.num_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		for (auto i = 0u; i < params_.num_threads; ++i) {
+			solvers_.emplace_back(std::make_unique<Solver>());
+			queues_.emplace_back(std::make_unique<job_queue>());
+		}
+		for (auto i = 0u; i < params_.num_threads; ++i) {
+			workers_.emplace_back([this, i]() { work(i); });
+		}
+	}
+
+	/*! \brief Finishes all submitted jobs. */
+	~solver_farm()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopped_ = true;
+		}
+		ready_.notify_all();
+		for (auto& worker : workers_) {
+			worker.join();
+		}
+	}
+
+	/* disallow copying */
+	solver_farm(solver_farm const&) = delete;
+	solver_farm& operator=(solver_farm const&) = delete;
+#pragma endregion
+
+#pragma region Modifiers
+	/*! \brief Submits a job.
+	 *
+	 * \param clauses Clauses of the problem
+	 * \param assumptions Assumptions of the call
+	 * \param num_variables Number of variables, at least those of the literals (0: the largest
+	 *                      variable of the literals, plus one)
+	 */
+	std::future<result> submit(clause_batch clauses, std::vector<lit_type> assumptions = {},
+	                           uint32_t num_variables = 0u)
+	{
+		job j{std::move(clauses), std::move(assumptions), num_variables, {}};
+		for (auto i = 0u; i < j.clauses.num_clauses(); ++i) {
+			for (auto it = j.clauses.begin(i); it != j.clauses.end(i); ++it) {
+				j.num_variables = std::max(j.num_variables, it->variable() + 1u);
+			}
+		}
+		for (auto const lit : j.assumptions) {
+			j.num_variables = std::max(j.num_variables, lit.variable() + 1u);
+		}
+		auto answer = j.promise.get_future();
+
+		/* count the job before publishing it, a worker that takes it decrements the count under
+		 * `mutex_` and hence after us */
+		auto& queue = *queues_.at(next_queue_++ % queues_.size());
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			++num_queued_;
+			std::lock_guard<std::mutex> queue_lock(queue.mutex);
+			queue.jobs.emplace_back(std::move(j));
+		}
+		ready_.notify_one();
+		return answer;
+	}
+#pragma endregion
+
+#pragma region Properties
+	uint32_t num_threads() const
+	{
+		return params_.num_threads;
+	}
+
+	/*! \brief Returns the number of jobs that no worker has taken yet. */
+	uint64_t num_queued() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return num_queued_;
+	}
+#pragma endregion
+
+private:
+	void work(uint32_t index)
+	{
+		job j;
+		while (true) {
+			if (take(index, j)) {
+				run(*solvers_.at(index), j);
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(mutex_);
+			ready_.wait(lock, [&]() { return stopped_ || num_queued_ > 0u; });
+			if (num_queued_ == 0u) {
+				return;
+			}
+		}
+	}
+
+	/* Takes a job of the worker's own queue, or steals one */
+	bool take(uint32_t index, job& j)
+	{
+		for (auto i = 0u; i < queues_.size(); ++i) {
+			auto& queue = *queues_.at((index + i) % queues_.size());
+			std::unique_lock<std::mutex> lock(queue.mutex);
+			if (queue.jobs.empty()) {
+				continue;
+			}
+			if (i == 0u) {
+				j = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			} else {
+				j = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+			}
+			lock.unlock();
+			std::lock_guard<std::mutex> count_lock(mutex_);
+			--num_queued_;
+			return true;
+		}
+		return false;
+	}
+
+	void run(Solver& solver, job& j)
+	{
+		solver.restart();
+		solver.add_variables(j.num_variables);
+		if (!solver.add_clauses(j.clauses)) {
+			/* unsatisfiable at level 0, independently of the assumptions */
+			j.promise.set_value(result(result::clause_type()));
+			return;
+		}
+		auto const state = solver.solve(j.assumptions, params_.conflict_limit);
+		if (state == result::states::satisfiable) {
+			j.promise.set_value(solver.get_model());
+		} else if constexpr (detail::has_get_core<Solver>::value) {
+			j.promise.set_value(state == result::states::unsatisfiable ? solver.get_core() :
+			                                                             result(state));
+		} else {
+			j.promise.set_value(result(state));
+		}
+	}
+
+private:
+	solver_farm_params params_;
+	std::vector<std::unique_ptr<Solver>> solvers_;
+	std::vector<std::unique_ptr<job_queue>> queues_;
+	std::vector<std::thread> workers_;
+	std::atomic<uint64_t> next_queue_{0u};
+
+	/*! \brief Jobs in the queues, guarded by `mutex_` for the sleeping workers */
+	mutable std::mutex mutex_;
+	std::condition_variable ready_;
+	uint64_t num_queued_ = 0u;
+	bool stopped_ = false;
+};
+
+} // namespace bill
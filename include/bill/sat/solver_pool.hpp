@@ -0,0 +1,198 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "solver.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Parameters of `solver_pool` */
+struct solver_pool_params {
+	/*! \brief Number of solvers created with the pool */
+	uint32_t num_solvers = 0u;
+
+	/*! \brief Number of variables each new solver is warmed up with */
+	uint32_t num_variables = 0u;
+
+	/*! \brief Number of binary clauses each new solver is warmed up with */
+	uint32_t num_clauses = 0u;
+};
+
+/*! \brief A pool of reusable, pre-warmed solvers.
+ *
+ * New solvers are warmed up: they receive `num_variables` variables and `num_clauses` binary
+ * clauses, which allocate and touch their memory, and are then emptied with `restart`.  Since
+ * `restart` keeps the memory of the solvers (except for z3), problems up to that size then run
+ * without allocations.
+ *
+ * `acquire` hands out an empty solver, which returns to the pool when its handle is destroyed;
+ * the pool then empties it with `restart` and clears its interrupt.  The pool may be shared by
+ * several threads, and must outlive the handles.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      solver_pool_params params;
+      params.num_solvers = 8u;
+      params.num_variables = 1000u;
+      params.num_clauses = 5000u;
+      solver_pool<solver<solvers::glucose_41>> pool(params);
+      {
+        auto solver = pool.acquire();
+        solver->add_variables(n);
+        // ...
+      } // the solver returns to the pool
+   \endverbatim
+ */
+template<typename Solver = solver<>>
+class solver_pool {
+public:
+	/*! \brief A solver taken from a pool, returned to it on destruction */
+	class handle {
+	public:
+		handle(handle&& other) noexcept
+		    : pool_(other.pool_)
+		    , solver_(std::move(other.solver_))
+		{}
+
+		handle& operator=(handle&& other) noexcept
+		{
+			if (this != &other) {
+				release();
+				pool_ = other.pool_;
+				solver_ = std::move(other.solver_);
+			}
+			return *this;
+		}
+
+		~handle()
+		{
+			release();
+		}
+
+		Solver& operator*() const
+		{
+			return *solver_;
+		}
+
+		Solver* operator->() const
+		{
+			return solver_.get();
+		}
+
+		Solver* get() const
+		{
+			return solver_.get();
+		}
+
+	private:
+		friend class solver_pool;
+
+		handle(solver_pool* pool, std::unique_ptr<Solver> solver)
+		    : pool_(pool)
+		    , solver_(std::move(solver))
+		{}
+
+		void release()
+		{
+			if (solver_) {
+				pool_->release(std::move(solver_));
+			}
+		}
+
+	private:
+		solver_pool* pool_;
+		std::unique_ptr<Solver> solver_;
+	};
+
+#pragma region Constructors
+	explicit solver_pool(solver_pool_params const& params = {})
+	    : params_(params)
+	{
+		for (auto i = 0u; i < params_.num_solvers; ++i) {
+			available_.emplace_back(create());
+		}
+	}
+
+	/* disallow copying */
+	solver_pool(solver_pool const&) = delete;
+	solver_pool& operator=(solver_pool const&) = delete;
+#pragma endregion
+
+#pragma region Modifiers
+	/*! \brief Takes an empty solver of the pool, or a new one if none is available. */
+	handle acquire()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (!available_.empty()) {
+				auto solver = std::move(available_.back());
+				available_.pop_back();
+				return handle(this, std::move(solver));
+			}
+		}
+		return handle(this, create());
+	}
+#pragma endregion
+
+#pragma region Properties
+	/*! \brief Returns the number of solvers in the pool, i.e., not handed out. */
+	uint32_t num_available() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return available_.size();
+	}
+
+	/*! \brief Returns the number of solvers created by the pool. */
+	uint32_t num_created() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return num_created_;
+	}
+#pragma endregion
+
+private:
+	std::unique_ptr<Solver> create()
+	{
+		auto solver = std::make_unique<Solver>();
+		if (params_.num_variables > 0u) {
+			solver->add_variables(params_.num_variables);
+			for (auto i = 0u; i < params_.num_clauses; ++i) {
+				auto const var = i % params_.num_variables;
+				solver->add_clause({lit_type(var, negative_polarity),
+				                    lit_type((var + 1u) % params_.num_variables)});
+			}
+			solver->restart();
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		++num_created_;
+		return solver;
+	}
+
+	void release(std::unique_ptr<Solver> solver)
+	{
+		solver->restart();
+		solver->clear_interrupt();
+		std::lock_guard<std::mutex> lock(mutex_);
+		available_.emplace_back(std::move(solver));
+	}
+
+private:
+	solver_pool_params params_;
+	mutable std::mutex mutex_;
+	std::vector<std::unique_ptr<Solver>> available_;
+	uint32_t num_created_ = 0u;
+};
+
+} // namespace bill
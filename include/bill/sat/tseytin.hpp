@@ -20,9 +20,9 @@ template<typename Solver>
 lit_type add_tseytin_and(Solver& solver, lit_type const& a, lit_type const& b)
 {
 	auto const r = solver.add_variable();
-	solver.add_clause(std::vector{~a, ~b, lit_type(r, lit_type::polarities::positive)});
-	solver.add_clause(std::vector{a, lit_type(r, lit_type::polarities::negative)});
-	solver.add_clause(std::vector{b, lit_type(r, lit_type::polarities::negative)});
+	solver.add_clause({~a, ~b, lit_type(r, lit_type::polarities::positive)});
+	solver.add_clause({a, lit_type(r, lit_type::polarities::negative)});
+	solver.add_clause({b, lit_type(r, lit_type::polarities::negative)});
 	return lit_type(r, lit_type::polarities::positive);
 }
 
@@ -42,7 +42,7 @@ lit_type add_tseytin_and(Solver& solver, std::vector<lit_type> const& ls)
 	cls.emplace_back(lit_type(r, lit_type::polarities::positive));
 	solver.add_clause(cls);
 	for (const auto& l : ls)
-		solver.add_clause(std::vector{l, lit_type(r, lit_type::polarities::negative)});
+		solver.add_clause({l, lit_type(r, lit_type::polarities::negative)});
 	return lit_type(r, lit_type::polarities::positive);
 }
 
@@ -57,9 +57,9 @@ template<typename Solver>
 lit_type add_tseytin_or(Solver& solver, lit_type const& a, lit_type const& b)
 {
 	auto const r = solver.add_variable();
-	solver.add_clause(std::vector{a, b, lit_type(r, lit_type::polarities::negative)});
-	solver.add_clause(std::vector{~a, lit_type(r, lit_type::polarities::positive)});
-	solver.add_clause(std::vector{~b, lit_type(r, lit_type::polarities::positive)});
+	solver.add_clause({a, b, lit_type(r, lit_type::polarities::negative)});
+	solver.add_clause({~a, lit_type(r, lit_type::polarities::positive)});
+	solver.add_clause({~b, lit_type(r, lit_type::polarities::positive)});
 	return lit_type(r, lit_type::polarities::positive);
 }
 
@@ -77,7 +77,7 @@ lit_type add_tseytin_or(Solver& solver, std::vector<lit_type> const& ls)
 	cls.emplace_back(lit_type(r, lit_type::polarities::negative));
 	solver.add_clause(cls);
 	for (const auto& l : ls)
-		solver.add_clause(std::vector{~l, lit_type(r, lit_type::polarities::positive)});
+		solver.add_clause({~l, lit_type(r, lit_type::polarities::positive)});
 	return lit_type(r, lit_type::polarities::positive);
 }
 
@@ -92,10 +92,10 @@ template<typename Solver>
 lit_type add_tseytin_xor(Solver& solver, lit_type const& a, lit_type const& b)
 {
 	auto const r = solver.add_variable();
-	solver.add_clause(std::vector{~a, ~b, lit_type(r, lit_type::polarities::negative)});
-	solver.add_clause(std::vector{~a, b, lit_type(r, lit_type::polarities::positive)});
-	solver.add_clause(std::vector{a, ~b, lit_type(r, lit_type::polarities::positive)});
-	solver.add_clause(std::vector{a, b, lit_type(r, lit_type::polarities::negative)});
+	solver.add_clause({~a, ~b, lit_type(r, lit_type::polarities::negative)});
+	solver.add_clause({~a, b, lit_type(r, lit_type::polarities::positive)});
+	solver.add_clause({a, ~b, lit_type(r, lit_type::polarities::positive)});
+	solver.add_clause({a, b, lit_type(r, lit_type::polarities::negative)});
 	return lit_type(r, lit_type::polarities::positive);
 }
 
@@ -110,10 +110,10 @@ template<typename Solver>
 lit_type add_tseytin_equals(Solver& solver, lit_type const& a, lit_type const& b)
 {
 	auto const r = solver.add_variable();
-	solver.add_clause(std::vector{~a, ~b, lit_type(r, lit_type::polarities::positive)});
-	solver.add_clause(std::vector{~a, b, lit_type(r, lit_type::polarities::negative)});
-	solver.add_clause(std::vector{a, ~b, lit_type(r, lit_type::polarities::negative)});
-	solver.add_clause(std::vector{a, b, lit_type(r, lit_type::polarities::positive)});
+	solver.add_clause({~a, ~b, lit_type(r, lit_type::polarities::positive)});
+	solver.add_clause({~a, b, lit_type(r, lit_type::polarities::negative)});
+	solver.add_clause({a, ~b, lit_type(r, lit_type::polarities::negative)});
+	solver.add_clause({a, b, lit_type(r, lit_type::polarities::positive)});
 	return lit_type(r, lit_type::polarities::positive);
 }
 
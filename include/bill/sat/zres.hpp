@@ -0,0 +1,376 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "../dd/zdd.hpp"
+#include "interface/common.hpp"
+#include "interface/types.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace bill {
+
+/*! \brief Parameters of `zres_preprocessor`. */
+struct zres_params {
+	/*! \brief Number of clauses by which an elimination may increase the clause set */
+	uint64_t max_clause_growth = 0u;
+	/*! \brief Use the number of ZDD nodes instead of the number of clauses as bound */
+	bool symbolic_bound = false;
+	/*! \brief Number of ZDD nodes by which an elimination may increase the clause set (if
+	 * `symbolic_bound` is set) */
+	uint64_t max_node_growth = 0u;
+	/*! \brief Variables that must not be eliminated, e.g., the ones used in assumptions */
+	std::vector<var_type> frozen;
+};
+
+/*! \brief Statistics of `zres_preprocessor`. */
+struct zres_stats {
+	/*! \brief Number of clauses of the input */
+	uint64_t num_input_clauses = 0u;
+	/*! \brief Number of clauses removed because they were subsumed, duplicated, or tautologies */
+	uint64_t num_subsumed_clauses = 0u;
+	/*! \brief Number of eliminated variables */
+	uint32_t num_eliminated_vars = 0u;
+	/*! \brief Number of eliminations that were tried and rejected by the bound */
+	uint32_t num_rejected_eliminations = 0u;
+};
+
+/*! \brief ZDD-based clause-set preprocessor (ZRes, Chatalic and Simon).
+ *
+ * The clause set is stored as a ZDD over literals: literal `l` of `lit_type` is ZDD variable
+ * `2 * l.variable() + (l.is_complemented() ? 1 : 0)`, i.e., the numeral of the literal.  Hence
+ * up to 2047 variables are supported.  The set is kept free of subsumed clauses, of
+ * duplicates, and of tautologies.
+ *
+ * Variables are eliminated by symbolic Davis-Putnam resolution: with `P` and `N` the clauses
+ * that contain `x` and `~x` (without it), the resolvents are the join `P * N`, whose
+ * tautologies are removed with `nonsupersets`.  The number of resolvents can be exponential in
+ * the size of the ZDD, which is why an elimination can be bounded by the number of nodes
+ * instead of the number of clauses.
+ *
+ * The reduced CNF is equisatisfiable with the input; `extend_model` turns a model of the
+ * reduced CNF into a model of the input.
+ *
+ * \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      zres_preprocessor zres(num_vars, clauses);
+      zres.eliminate();
+      for (auto const& clause : zres.clauses()) {
+        solver.add_clause(clause);
+      }
+      if (solver.solve() == result::states::satisfiable) {
+        auto model = solver.get_model().model();
+        zres.extend_model(model);
+      }
+   \endverbatim
+ */
+class zres_preprocessor {
+	using node_index = zdd_base::node_index;
+
+public:
+	/*! \brief Builds the clause set.
+	 *
+	 * \param num_vars Number of variables of the CNF
+	 * \param clauses Clauses of the CNF
+	 * \param ps Parameters
+	 */
+	zres_preprocessor(uint32_t num_vars, std::vector<std::vector<lit_type>> const& clauses,
+	                  zres_params const& ps = {})
+	    : num_vars_(num_vars)
+	    , ps_(ps)
+	    , zdd_(2u * num_vars)
+	    , frozen_(num_vars, false)
+	    , eliminated_(num_vars, false)
+	{
+		for (auto const var : ps.frozen) {
+			frozen_.at(var) = true;
+		}
+
+		/* the family of all tautologies {x, ~x} */
+		tautologies_ = zdd_.ref(zdd_.bottom());
+		for (auto var = 0u; var < num_vars; ++var) {
+			auto const pair = zdd_.join(zdd_.elementary(2u * var), zdd_.elementary(2u * var + 1u));
+			replace(tautologies_, zdd_.union_(tautologies_, pair));
+			zdd_.deref(pair);
+		}
+
+		clauses_ = zdd_.ref(zdd_.bottom());
+		for (auto const& clause : clauses) {
+			auto set = zdd_.ref(zdd_.top());
+			for (auto const lit : clause) {
+				assert(uint32_t(lit.variable()) < num_vars);
+				replace(set, zdd_.join(set, zdd_.elementary(zdd_var(lit))));
+			}
+			replace(clauses_, zdd_.union_(clauses_, set));
+			zdd_.deref(set);
+		}
+		replace(clauses_, zdd_.nonsupersets(clauses_, tautologies_));
+		replace(clauses_, minimal(clauses_));
+
+		st_.num_input_clauses = clauses.size();
+		st_.num_subsumed_clauses = clauses.size() - num_clauses();
+	}
+
+	zres_preprocessor(zres_preprocessor const&) = delete;
+	zres_preprocessor& operator=(zres_preprocessor const&) = delete;
+
+	~zres_preprocessor()
+	{
+		zdd_.deref(clauses_);
+		zdd_.deref(tautologies_);
+	}
+
+#pragma region Preprocessing
+	/*! \brief Eliminates variables until no elimination satisfies the bound.
+	 *
+	 * Candidates are tried by increasing number of resolvents `|P| * |N|`.
+	 *
+	 * \return Number of variables eliminated by this call
+	 */
+	uint32_t eliminate()
+	{
+		uint32_t num_eliminated = 0u;
+		bool progress = true;
+		while (progress && !is_unsatisfiable()) {
+			progress = false;
+			std::vector<std::pair<uint64_t, uint32_t>> candidates;
+			for (auto var = 0u; var < num_vars_; ++var) {
+				if (frozen_.at(var) || eliminated_.at(var)) {
+					continue;
+				}
+				auto const num_pos = count_occurrences(lit_type(var, positive_polarity));
+				auto const num_neg = count_occurrences(lit_type(var, negative_polarity));
+				candidates.emplace_back(num_pos * num_neg, var);
+			}
+			std::sort(candidates.begin(), candidates.end());
+			for (auto const& [_, var] : candidates) {
+				if (eliminate(var)) {
+					++num_eliminated;
+					progress = true;
+				}
+			}
+		}
+		return num_eliminated;
+	}
+
+	/*! \brief Eliminates variable `var` if the resulting clause set satisfies the bound.
+	 *
+	 * \return True if `var` was eliminated
+	 */
+	bool eliminate(var_type var)
+	{
+		assert(uint32_t(var) < num_vars_ && !frozen_.at(var) && !eliminated_.at(var));
+		auto const pos = zdd_.elementary(zdd_var(lit_type(var, positive_polarity)));
+		auto const neg = zdd_.elementary(zdd_var(lit_type(var, negative_polarity)));
+
+		auto const with_pos = zdd_.edivide(clauses_, pos);
+		auto const with_neg = zdd_.edivide(clauses_, neg);
+		auto rest = zdd_.nonsupersets(clauses_, pos);
+		replace(rest, zdd_.nonsupersets(rest, neg));
+
+		auto resolvents = zdd_.join(with_pos, with_neg);
+		replace(resolvents, zdd_.nonsupersets(resolvents, tautologies_));
+		auto candidate = zdd_.union_(rest, resolvents);
+		replace(candidate, minimal(candidate));
+		zdd_.deref(resolvents);
+		zdd_.deref(rest);
+
+		bool accept;
+		if (ps_.symbolic_bound) {
+			accept = zdd_.count_nodes(candidate) <= zdd_.count_nodes(clauses_) + ps_.max_node_growth;
+		} else {
+			accept = zdd_.count_sets(candidate) <= num_clauses() + ps_.max_clause_growth;
+		}
+		if (accept) {
+			/* keep the removed clauses to extend models later */
+			auto& removed = eliminations_.emplace_back();
+			removed.var = var;
+			removed.clauses = as_clauses(with_pos, lit_type(var, positive_polarity));
+			auto const negative = as_clauses(with_neg, lit_type(var, negative_polarity));
+			removed.clauses.insert(removed.clauses.end(), negative.begin(), negative.end());
+			eliminated_.at(var) = true;
+			++st_.num_eliminated_vars;
+			replace(clauses_, candidate);
+		} else {
+			++st_.num_rejected_eliminations;
+			zdd_.deref(candidate);
+		}
+		zdd_.deref(with_pos);
+		zdd_.deref(with_neg);
+		return accept;
+	}
+#pragma endregion
+
+#pragma region Results
+	/*! \brief Returns true if the clause set contains the empty clause. */
+	bool is_unsatisfiable()
+	{
+		auto const empty = zdd_.intersection(clauses_, zdd_.top());
+		zdd_.deref(empty);
+		return empty == zdd_.top();
+	}
+
+	/*! \brief Returns the number of clauses. */
+	uint64_t num_clauses() const
+	{
+		return zdd_.count_sets(clauses_);
+	}
+
+	/*! \brief Returns the reduced clause set. */
+	std::vector<std::vector<lit_type>> clauses() const
+	{
+		std::vector<std::vector<lit_type>> result;
+		zdd_.foreach_set(clauses_, [&](auto const& set) {
+			auto& clause = result.emplace_back();
+			for (auto const element : set) {
+				clause.emplace_back(element >> 1,
+				                    (element & 1u) ? negative_polarity : positive_polarity);
+			}
+			return true;
+		});
+		return result;
+	}
+
+	/*! \brief Returns true if `var` was eliminated. */
+	bool is_eliminated(var_type var) const
+	{
+		return eliminated_.at(var);
+	}
+
+	/*! \brief Assigns the eliminated variables of a model of the reduced clause set.
+	 *
+	 * The eliminated variables are assigned in reverse order of elimination, each one such
+	 * that the clauses removed by its elimination are satisfied.
+	 *
+	 * \param model Model of the reduced CNF (at least `num_vars` entries)
+	 */
+	void extend_model(result::model_type& model) const
+	{
+		assert(model.size() >= num_vars_);
+		auto const is_true = [&](lit_type lit) {
+			auto const value = model.at(lit.variable());
+			return lit.is_complemented() ? value == lbool_type::false_
+			                             : value == lbool_type::true_;
+		};
+		for (auto it = eliminations_.rbegin(); it != eliminations_.rend(); ++it) {
+			model.at(it->var) = lbool_type::false_;
+			for (auto const& clause : it->clauses) {
+				if (!std::any_of(clause.begin(), clause.end(), is_true)) {
+					model.at(it->var) = lbool_type::true_;
+					break;
+				}
+			}
+		}
+	}
+
+	/*! \brief Returns the ZDD base holding the clause set. */
+	zdd_base const& zdd() const
+	{
+		return zdd_;
+	}
+
+	/*! \brief Returns the root of the clause set in `zdd()`. */
+	node_index root() const
+	{
+		return clauses_;
+	}
+
+	zres_stats const& stats() const
+	{
+		return st_;
+	}
+#pragma endregion
+
+private:
+	struct elimination {
+		var_type var;
+		std::vector<std::vector<lit_type>> clauses;
+	};
+
+	static uint32_t zdd_var(lit_type lit)
+	{
+		return 2u * lit.variable() + (lit.is_complemented() ? 1u : 0u);
+	}
+
+	/* Replaces `index` by `new_index`, which owns a reference */
+	void replace(node_index& index, node_index new_index)
+	{
+		zdd_.deref(index);
+		index = new_index;
+	}
+
+	uint64_t count_occurrences(lit_type lit)
+	{
+		auto const with_lit = zdd_.edivide(clauses_, zdd_.elementary(zdd_var(lit)));
+		auto const count = zdd_.count_sets(with_lit);
+		zdd_.deref(with_lit);
+		return count;
+	}
+
+	/* Clauses of `family`, each one extended with `lit` */
+	std::vector<std::vector<lit_type>> as_clauses(node_index family, lit_type lit) const
+	{
+		std::vector<std::vector<lit_type>> result;
+		zdd_.foreach_set(family, [&](auto const& set) {
+			auto& clause = result.emplace_back(1u, lit);
+			for (auto const element : set) {
+				clause.emplace_back(element >> 1,
+				                    (element & 1u) ? negative_polarity : positive_polarity);
+			}
+			return true;
+		});
+		return result;
+	}
+
+	/* Returns the family of the minimal sets of `family`, i.e., removes subsumed clauses */
+	node_index minimal(node_index family)
+	{
+		std::unordered_map<node_index, node_index> visited;
+		auto const result = minimal_rec(family, visited);
+		for (auto const& [_, index] : visited) {
+			zdd_.deref(index);
+		}
+		return result;
+	}
+
+	node_index minimal_rec(node_index index, std::unordered_map<node_index, node_index>& visited)
+	{
+		if (index <= zdd_.top()) {
+			return zdd_.ref(index);
+		}
+		if (auto const it = visited.find(index); it != visited.end()) {
+			return zdd_.ref(it->second);
+		}
+		/* sets with the variable are subsumed by the sets without it that they contain */
+		auto const lo = minimal_rec(zdd_.lo(index), visited);
+		auto const hi_minimal = minimal_rec(zdd_.hi(index), visited);
+		auto const hi = zdd_.nonsupersets(hi_minimal, lo);
+		zdd_.deref(hi_minimal);
+		auto const result = zdd_.unique(zdd_.var(index), lo, hi);
+		visited.emplace(index, zdd_.ref(result));
+		return result;
+	}
+
+private:
+	uint32_t num_vars_;
+	zres_params ps_;
+	zdd_base zdd_;
+	node_index clauses_;
+	node_index tautologies_;
+	std::vector<bool> frozen_;
+	std::vector<bool> eliminated_;
+	std::vector<elimination> eliminations_;
+	zres_stats st_;
+};
+
+} // namespace bill
@@ -0,0 +1,129 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "../sat/cnf_fixtures.hpp"
+
+#include <bill/dd/allsat.hpp>
+#include <bill/sat/solver.hpp>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace {
+
+/* Projected solutions by exhaustive enumeration, as sets of projection indices */
+std::set<std::vector<uint32_t>> brute_force(uint32_t num_vars, cnf_type const& clauses,
+                                            std::vector<bill::var_type> const& projection)
+{
+	std::set<std::vector<uint32_t>> solutions;
+	for (uint32_t assignment = 0u; assignment < (1u << num_vars); ++assignment) {
+		auto const is_true = [&](bill::lit_type lit) {
+			return bool((assignment >> lit.variable()) & 1u) != lit.is_complemented();
+		};
+		auto const satisfied = std::all_of(clauses.begin(), clauses.end(), [&](auto const& c) {
+			return std::any_of(c.begin(), c.end(), is_true);
+		});
+		if (!satisfied) {
+			continue;
+		}
+		std::vector<uint32_t> set;
+		for (auto i = 0u; i < projection.size(); ++i) {
+			if ((assignment >> projection.at(i)) & 1u) {
+				set.emplace_back(i);
+			}
+		}
+		solutions.insert(set);
+	}
+	return solutions;
+}
+
+template<class Manager>
+std::set<std::vector<uint32_t>> as_set(bill::zdd_family<Manager> const& family)
+{
+	std::set<std::vector<uint32_t>> sets;
+	family.foreach_set([&](auto set) {
+		std::sort(set.begin(), set.end());
+		sets.insert(set);
+		return true;
+	});
+	return sets;
+}
+
+template<class Solver>
+void add_cnf(Solver& solver, uint32_t num_vars, cnf_type const& clauses)
+{
+	solver.add_variables(num_vars);
+	for (auto const& clause : clauses) {
+		solver.add_clause(clause);
+	}
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("AllSAT to ZDD", "[zdd][cudd][allsat]", bill::zdd_base, cudd::cudd_zdd)
+{
+	using namespace bill;
+	SECTION("Random CNFs")
+	{
+		uint64_t num_cache_hits = 0u;
+		for (auto seed = 0u; seed < 10u; ++seed) {
+			auto const clauses = random_cnf(12u, 15u + 3u * seed, seed);
+			std::vector<var_type> const all = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+			std::vector<var_type> const some = {9, 2, 5, 0, 7};
+			for (auto const& projection : {all, some}) {
+				solver<solvers::glucose_41> solver;
+				add_cnf(solver, 12u, clauses);
+				TestType zdd(projection.size());
+				allsat_zdd_stats st;
+				auto const family = allsat_zdd(solver, clauses, projection, zdd, &st);
+				CHECK(as_set(family) == brute_force(12u, clauses, projection));
+				num_cache_hits += st.num_cache_hits;
+			}
+		}
+		CHECK(num_cache_hits > 0u);
+	}
+	SECTION("Unsatisfiable CNF")
+	{
+		cnf_type const clauses = {{lit_type(0, positive_polarity)},
+		                          {lit_type(0, negative_polarity)}};
+		solver<solvers::glucose_41> solver;
+		add_cnf(solver, 1u, clauses);
+		TestType zdd(1u);
+		CHECK(allsat_zdd(solver, clauses, {0}, zdd).count_sets() == 0u);
+	}
+	SECTION("Independent components")
+	{
+		/* 20 disjoint clauses (x_2i or x_2i+1), and 4 unconstrained variables */
+		cnf_type clauses;
+		for (auto i = 0u; i < 20u; ++i) {
+			clauses.push_back({lit_type(2 * i, positive_polarity),
+			                   lit_type(2 * i + 1, positive_polarity)});
+		}
+		std::vector<var_type> projection(44u);
+		std::iota(projection.begin(), projection.end(), 0u);
+		solver<solvers::glucose_41> solver;
+		add_cnf(solver, 44u, clauses);
+		TestType zdd(44u);
+		allsat_zdd_stats st;
+		auto const family = allsat_zdd(solver, clauses, projection, zdd, &st);
+		CHECK(family.count_sets() == uint64_t(3486784401u) * 16u);
+		CHECK(st.num_solver_calls < 100u);
+		CHECK(st.num_components >= 20u);
+	}
+}
+
+TEMPLATE_TEST_CASE("AllSAT to ZDD with different solvers", "[zdd][allsat]",
+                   bill::solver<bill::solvers::ghack>, bill::solver<bill::solvers::bsat2>)
+{
+	using namespace bill;
+	auto const clauses = random_cnf(10u, 25u, 42u);
+	std::vector<var_type> const projection = {1, 3, 5, 7, 9};
+	TestType solver;
+	add_cnf(solver, 10u, clauses);
+	zdd_base zdd(projection.size());
+	auto const family = allsat_zdd(solver, clauses, projection, zdd);
+	CHECK(as_set(family) == brute_force(10u, clauses, projection));
+}
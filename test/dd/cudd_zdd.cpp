@@ -121,3 +121,139 @@ TEST_CASE("CUDD ZDD join operator (*)", "[cudd]")
   }
 }
 
+
+TEST_CASE("CUDD ZDD reordering", "[cudd]")
+{
+  /* one of the variables i and i + 8 for each i, the identity order is bad for this family */
+  auto const build = []( cudd::cudd_zdd& zdd ) {
+    auto family = zdd.top();
+    for ( auto i = 0u; i < 8u; ++i )
+    {
+      family = zdd.join( family, zdd.union_( zdd.elementary( i ), zdd.elementary( i + 8u ) ) );
+    }
+    return family;
+  };
+
+  SECTION( "On demand" )
+  {
+    cudd::cudd_zdd_params ps;
+    ps.unique_slots = 64u;
+    ps.cache_slots = 1024u;
+    cudd::cudd_zdd zdd( 16u, ps );
+    auto const family = build( zdd );
+    CHECK( zdd.count_sets( family ) == 256u );
+    CHECK( zdd.reordering_stats().num_reorderings == 0u );
+    CHECK( !zdd.reordering_stats().auto_reorder );
+
+    CHECK( zdd.reorder( CUDD_REORDER_SIFT ) );
+    CHECK( zdd.reordering_stats().num_reorderings == 1u );
+    CHECK( zdd.count_sets( family ) == 256u );
+    CHECK( zdd.count_sets( zdd.tautology() ) == 65536u );
+    CHECK( zdd.count_sets( zdd.choose( zdd.union_( zdd.elementary( 0 ), zdd.elementary( 8 ) ), 1 ) ) == 2u );
+  }
+  SECTION( "Automatic" )
+  {
+    cudd::cudd_zdd_params ps;
+    ps.auto_reorder = true;
+    ps.reorder_method = CUDD_REORDER_SIFT;
+    ps.first_reordering = 16u;
+    cudd::cudd_zdd zdd( 16u, ps );
+    CHECK( zdd.reordering_stats().auto_reorder );
+    auto const family = build( zdd );
+    CHECK( zdd.count_sets( family ) == 256u );
+    CHECK( zdd.count_sets( zdd.nonsupersets( family, zdd.elementary( 0 ) ) ) == 128u );
+    CHECK( zdd.count_sets( zdd.care( { 0, 8 } ) ) == 4u );
+
+    zdd.disable_reordering();
+    CHECK( !zdd.reordering_stats().auto_reorder );
+  }
+}
+
+TEST_CASE("CUDD ZDD maximal, meet, nonsubsets and edivide", "[cudd]")
+{
+  cudd::cudd_zdd zdd( 7 );
+  auto const family = [&]( std::vector<std::vector<uint32_t>> const& sets ) {
+    auto result = zdd.bottom();
+    for ( auto const& set : sets )
+    {
+      auto product = zdd.top();
+      for ( auto const var : set )
+      {
+        product = zdd.join( product, zdd.elementary( var ) );
+      }
+      result = zdd.union_( result, product );
+    }
+    return result;
+  };
+  auto const zdd_x = family( { { 1, 2, 3 }, { 3, 4 }, { 5 } } );
+  auto const zdd_y = family( { { 0, 2, 3 }, { 3, 4 }, { 6 } } );
+
+  SECTION( "Meet" )
+  {
+    CHECK( zdd.meet( zdd_x, zdd_y ) == family( { {}, { 3 }, { 2, 3 }, { 3, 4 } } ) );
+    CHECK( zdd.meet( zdd_y, zdd_x ) == zdd.meet( zdd_x, zdd_y ) );
+    CHECK( zdd.meet( zdd_x, zdd.bottom() ) == zdd.bottom() );
+    CHECK( zdd.meet( zdd_x, zdd.top() ) == zdd.top() );
+    CHECK( zdd.meet( zdd_x, zdd.elementary( 5 ) ) == family( { {}, { 5 } } ) );
+  }
+  SECTION( "Nonsubsets" )
+  {
+    CHECK( zdd.nonsubsets( zdd_x, zdd_y ) == family( { { 1, 2, 3 }, { 5 } } ) );
+    CHECK( zdd.nonsubsets( zdd_x, zdd.bottom() ) == zdd_x );
+    CHECK( zdd.nonsubsets( zdd_x, zdd_x ) == zdd.bottom() );
+    CHECK( zdd.nonsubsets( family( { { 1 } } ), family( { { 0, 1 } } ) ) == zdd.bottom() );
+  }
+  SECTION( "Maximal" )
+  {
+    CHECK( zdd.maximal( zdd.union_( zdd_x, family( { { 3 }, { 1, 2 }, {} } ) ) ) == zdd_x );
+    CHECK( zdd.maximal( zdd.tautology() ) == family( { { 0, 1, 2, 3, 4, 5, 6 } } ) );
+  }
+  SECTION( "Edivide" )
+  {
+    auto const f = zdd.union_( zdd.join( family( { { 0 }, { 1 } } ), family( { { 2 }, { 3 } } ) ), family( { { 4 } } ) );
+    CHECK( zdd.edivide( f, family( { { 2 }, { 3 } } ) ) == family( { { 0 }, { 1 } } ) );
+    CHECK( zdd.edivide( f, family( { { 2 } } ) ) == family( { { 0 }, { 1 } } ) );
+    CHECK( zdd.edivide( f, zdd.top() ) == f );
+    CHECK( zdd.edivide( f, f ) == zdd.top() );
+    CHECK( zdd.edivide( f, family( { { 5 } } ) ) == zdd.bottom() );
+  }
+  SECTION( "Counting" )
+  {
+    CHECK( zdd.count_sets( zdd.tautology() ) == 128u );
+    CHECK( zdd.count_sets_double( zdd_x ) == 3.0 );
+
+    cudd::cudd_zdd large( 60u );
+    CHECK( large.count_sets( large.tautology() ) == uint64_t( 1 ) << 60 );
+  }
+}
+
+TEST_CASE("CUDD ZDD statistics", "[cudd]")
+{
+  cudd::cudd_zdd zdd( 8 );
+  auto universe = zdd.bottom();
+  for ( auto var = 0u; var < 8u; ++var )
+  {
+    universe = zdd.union_( universe, zdd.elementary( var ) );
+  }
+  auto const pairs = zdd.choose( universe, 2 );
+  auto const family = zdd.join( pairs, pairs );
+  CHECK( zdd.count_sets( family ) == 1u + 28u + 56u + 70u - 1u );
+
+  auto st = zdd.stats();
+  CHECK( st.operation( bill::zdd_operation::choose ).cache_lookups > 0u );
+  CHECK( st.operation( bill::zdd_operation::join ).calls > 0u );
+  CHECK( st.operation( bill::zdd_operation::meet ).calls == 0u );
+  CHECK( st.cache_lookups >= st.operation( bill::zdd_operation::join ).cache_lookups );
+  CHECK( st.cache_slots > 0u );
+  CHECK( st.num_nodes > 0u );
+  CHECK( st.unique_entries > 0u );
+  CHECK( st.unique_load_factor() > 0.0 );
+  CHECK( st.memory_in_use > 0u );
+  CHECK( st.peak_memory >= st.memory_in_use );
+
+  zdd.reset_stats();
+  st = zdd.stats();
+  CHECK( st.cache_lookups == 0u );
+  CHECK( st.operation( bill::zdd_operation::join ).calls == 0u );
+  CHECK( st.num_garbage_collections == 0u );
+}
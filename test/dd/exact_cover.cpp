@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <bill/dd/exact_cover.hpp>
+#include <vector>
+
+namespace {
+
+/* n-queens as exact cover: rows and columns are primary, diagonals are secondary */
+std::vector<std::vector<uint32_t>> queens_options(uint32_t n)
+{
+	std::vector<std::vector<uint32_t>> options;
+	for (auto row = 0u; row < n; ++row) {
+		for (auto column = 0u; column < n; ++column) {
+			options.push_back({row, n + column, 2 * n + row + column,
+			                   2 * n + (2 * n - 1) + (n - 1) + row - column});
+		}
+	}
+	return options;
+}
+
+} // namespace
+
+TEST_CASE("Exact cover", "[zdd][exact_cover]")
+{
+	using namespace bill;
+	SECTION("Knuth's example")
+	{
+		/* items a, ..., g */
+		std::vector<std::vector<uint32_t>> const options = {
+		    {2, 4}, {0, 3, 6}, {1, 2, 5}, {0, 3, 5}, {1, 6}, {3, 4, 6}};
+		zdd_base zdd(options.size());
+		auto const covers = exact_covers(zdd, 7, options);
+		CHECK(zdd.count_sets(covers) == 1u);
+		CHECK(zdd.sets_as_vectors(covers) == std::vector<std::vector<uint32_t>>{{0, 3, 4}});
+	}
+	SECTION("Reversed variable order")
+	{
+		std::vector<std::vector<uint32_t>> const options = {
+		    {2, 4}, {0, 3, 6}, {1, 2, 5}, {0, 3, 5}, {1, 6}, {3, 4, 6}};
+		zdd_base zdd(std::vector<uint32_t>{5, 4, 3, 2, 1, 0});
+		auto const covers = exact_covers(zdd, 7, options);
+		CHECK(zdd.sets_as_vectors(covers) == std::vector<std::vector<uint32_t>>{{4, 3, 0}});
+	}
+	SECTION("Uncoverable item")
+	{
+		zdd_base zdd(1);
+		CHECK(exact_covers(zdd, 2, {{0}}) == zdd.bottom());
+	}
+	SECTION("Secondary items")
+	{
+		/* item 1 is secondary, so it does not need to be covered */
+		zdd_base zdd(2);
+		auto const covers = exact_covers(zdd, 2, {{0}, {0, 1}}, 1);
+		CHECK(zdd.count_sets(covers) == 2u);
+	}
+	SECTION("n queens")
+	{
+		std::vector<uint64_t> const solutions = {1, 0, 0, 2, 10, 4, 40, 92};
+		for (auto n = 1u; n <= 8u; ++n) {
+			auto const options = queens_options(n);
+			zdd_base zdd(options.size());
+			auto const covers = exact_covers(zdd, 2 * n + 2 * (2 * n - 1), options,
+			                                 2 * (2 * n - 1));
+			CHECK(zdd.count_sets(covers) == solutions.at(n - 1));
+			zdd.foreach_set(covers, [&](auto const& set) {
+				CHECK(set.size() == n);
+				return true;
+			});
+		}
+	}
+}
@@ -0,0 +1,174 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <bill/dd/pidd.hpp>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+using permutation_type = bill::pidd_base::permutation_type;
+
+std::set<permutation_type> as_set(bill::pidd_base const& pidd, bill::pidd_base::node_index f)
+{
+	std::set<permutation_type> permutations;
+	pidd.foreach_permutation(f, [&](auto const& p) {
+		permutations.insert(p);
+		return true;
+	});
+	return permutations;
+}
+
+std::vector<permutation_type> random_permutations(uint32_t n, uint32_t count, std::mt19937& rng)
+{
+	std::vector<permutation_type> permutations(count, permutation_type(n));
+	for (auto& p : permutations) {
+		std::iota(p.begin(), p.end(), 0u);
+		std::shuffle(p.begin(), p.end(), rng);
+	}
+	return permutations;
+}
+
+bill::pidd_base::node_index build(bill::pidd_base& pidd,
+                                  std::vector<permutation_type> const& permutations)
+{
+	auto family = pidd.ref(pidd.bottom());
+	for (auto const& p : permutations) {
+		auto const single = pidd.permutation(p);
+		auto const temp = pidd.union_(family, single);
+		pidd.deref(single);
+		pidd.deref(family);
+		family = temp;
+	}
+	return family;
+}
+
+} // namespace
+
+TEST_CASE("πDD permutations", "[pidd]")
+{
+	using namespace bill;
+	pidd_base pidd(5u);
+	permutation_type p(5u);
+	std::iota(p.begin(), p.end(), 0u);
+	do {
+		auto const f = pidd.permutation(p);
+		CHECK(pidd.count_permutations(f) == 1u);
+		CHECK(as_set(pidd, f) == std::set<permutation_type>{p});
+		pidd.deref(f);
+	} while (std::next_permutation(p.begin(), p.end()));
+
+	auto const identity = pidd.permutation({0u, 1u, 2u, 3u, 4u});
+	CHECK(identity == pidd.top());
+	CHECK(pidd.transposition(1u, 3u) == pidd.permutation({0u, 3u, 2u, 1u, 4u}));
+}
+
+TEST_CASE("πDD symmetric group", "[pidd]")
+{
+	using namespace bill;
+	uint64_t factorial = 1u;
+	for (auto n = 1u; n <= 7u; ++n) {
+		factorial *= n;
+		pidd_base pidd(n);
+		auto const group = pidd.symmetric_group();
+		CHECK(pidd.count_permutations(group) == factorial);
+		CHECK(pidd.count_nodes(group) == n * (n - 1u) / 2u);
+
+		/* S_n is closed under composition */
+		auto const square = pidd.product(group, group);
+		CHECK(square == group);
+		pidd.deref(square);
+		pidd.deref(group);
+	}
+}
+
+TEST_CASE("πDD swap and product", "[pidd]")
+{
+	using namespace bill;
+	constexpr uint32_t n = 6u;
+	std::mt19937 rng(1u);
+	pidd_base pidd(n);
+	for (auto round = 0u; round < 10u; ++round) {
+		auto const ps = random_permutations(n, 12u, rng);
+		auto const qs = random_permutations(n, 8u, rng);
+		auto const f = build(pidd, ps);
+		auto const g = build(pidd, qs);
+
+		for (auto x = 1u; x < n; ++x) {
+			for (auto y = 0u; y < x; ++y) {
+				std::set<permutation_type> expected;
+				for (auto p : ps) {
+					std::swap(p.at(x), p.at(y));
+					expected.insert(p);
+				}
+				auto const swapped = pidd.swap(f, x, y);
+				CHECK(as_set(pidd, swapped) == expected);
+				pidd.deref(swapped);
+			}
+		}
+
+		std::set<permutation_type> expected;
+		for (auto const& p : ps) {
+			for (auto const& q : qs) {
+				permutation_type pq(n);
+				for (auto i = 0u; i < n; ++i) {
+					pq.at(i) = p.at(q.at(i));
+				}
+				expected.insert(pq);
+			}
+		}
+		auto const fg = pidd.product(f, g);
+		CHECK(as_set(pidd, fg) == expected);
+		CHECK(pidd.count_permutations(fg) == expected.size());
+		pidd.deref(fg);
+
+		pidd.deref(f);
+		pidd.deref(g);
+		if (round % 3u == 2u) {
+			pidd.collect_garbage();
+		}
+	}
+}
+
+TEST_CASE("πDD set operations", "[pidd]")
+{
+	using namespace bill;
+	constexpr uint32_t n = 5u;
+	std::mt19937 rng(7u);
+	pidd_base pidd(n);
+	auto const ps = random_permutations(n, 30u, rng);
+	auto const qs = random_permutations(n, 30u, rng);
+	auto const f = build(pidd, ps);
+	auto const g = build(pidd, qs);
+	std::set<permutation_type> const set_f(ps.begin(), ps.end());
+	std::set<permutation_type> const set_g(qs.begin(), qs.end());
+
+	std::set<permutation_type> expected;
+	std::set_union(set_f.begin(), set_f.end(), set_g.begin(), set_g.end(),
+	               std::inserter(expected, expected.end()));
+	auto const u = pidd.union_(f, g);
+	CHECK(as_set(pidd, u) == expected);
+
+	expected.clear();
+	std::set_intersection(set_f.begin(), set_f.end(), set_g.begin(), set_g.end(),
+	                      std::inserter(expected, expected.end()));
+	auto const i = pidd.intersection(f, g);
+	CHECK(as_set(pidd, i) == expected);
+
+	expected.clear();
+	std::set_difference(set_f.begin(), set_f.end(), set_g.begin(), set_g.end(),
+	                    std::inserter(expected, expected.end()));
+	auto const d = pidd.difference(f, g);
+	CHECK(as_set(pidd, d) == expected);
+	CHECK(pidd.count_permutations(d) == expected.size());
+
+	for (auto const index : {u, i, d, f, g}) {
+		pidd.deref(index);
+	}
+}
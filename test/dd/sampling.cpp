@@ -0,0 +1,90 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <bill/dd/sampling.hpp>
+#include <bill/dd/zdd_manager.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Uniform sampling of ZDD families", "[zdd][cudd][sampling]", bill::zdd_base,
+                   cudd::cudd_zdd)
+{
+	using namespace bill;
+	std::vector<std::vector<uint32_t>> const sets = {{0, 2}, {1}, {0, 1, 3, 5}, {4}, {}, {2, 3}};
+	zdd_manager<TestType> zdd(std::vector<uint32_t>{3, 0, 5, 1, 4, 2});
+	auto const family = zdd.family(sets);
+
+	zdd_sampler const sampler(zdd.backend(), family.node());
+	CHECK_FALSE(sampler.empty());
+	CHECK(sampler.total() == 6.0);
+
+	std::mt19937 rng(1u);
+	std::map<std::vector<uint32_t>, uint32_t> histogram;
+	for (auto set : sampler.sample(rng, 60000u)) {
+		std::sort(set.begin(), set.end());
+		++histogram[set];
+	}
+	CHECK(histogram.size() == sets.size());
+	for (auto const& set : sets) {
+		CHECK(histogram[set] > 9500u);
+		CHECK(histogram[set] < 10500u);
+	}
+
+	zdd_sampler const empty(zdd.backend(), zdd.bottom().node());
+	CHECK(empty.empty());
+	zdd_sampler const unit(zdd.backend(), zdd.top().node());
+	CHECK(unit.sample(rng).empty());
+}
+
+TEMPLATE_TEST_CASE("Weighted sampling of ZDD families", "[zdd][cudd][sampling]", bill::zdd_base,
+                   cudd::cudd_zdd)
+{
+	using namespace bill;
+	zdd_manager<TestType> zdd(3u);
+	auto const family = zdd.family({{}, {0}, {1}, {0, 1}, {2}});
+
+	/* weights 1, 3, 1, 3, 0 */
+	zdd_sampler const sampler(zdd.backend(), family.node(), {3.0, 1.0, 0.0});
+	CHECK(sampler.total() == 8.0);
+
+	std::mt19937 rng(2u);
+	std::map<std::vector<uint32_t>, uint32_t> histogram;
+	std::vector<uint32_t> set;
+	for (auto i = 0u; i < 80000u; ++i) {
+		sampler.sample_into(rng, set);
+		std::sort(set.begin(), set.end());
+		++histogram[set];
+	}
+	CHECK(histogram.count({2}) == 0u);
+	for (auto const& [s, expected] : std::map<std::vector<uint32_t>, uint32_t>{
+	         {{}, 10000u}, {{0}, 30000u}, {{1}, 10000u}, {{0, 1}, 30000u}}) {
+		CHECK(std::abs(double(histogram[s]) - expected) < 0.05 * expected);
+	}
+}
+
+TEMPLATE_TEST_CASE("Sampling of huge ZDD families", "[zdd][cudd][sampling]", bill::zdd_base,
+                   cudd::cudd_zdd)
+{
+	using namespace bill;
+	/* 2^70 sets do not fit into 64-bit counts */
+	zdd_manager<TestType> zdd(70u);
+	auto const family = zdd.tautology();
+	zdd_sampler const sampler(zdd.backend(), family.node());
+	CHECK(sampler.total() == std::ldexp(1.0, 70));
+	CHECK(sampler.num_nodes() == 70u);
+
+	std::mt19937 rng(3u);
+	uint64_t num_elements = 0u;
+	for (auto const& set : sampler.sample(rng, 100u)) {
+		num_elements += set.size();
+	}
+	/* each variable is in half of the sets */
+	CHECK(num_elements > 3000u);
+	CHECK(num_elements < 4000u);
+}
@@ -0,0 +1,161 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <algorithm>
+#include <bill/dd/simpath.hpp>
+#include <vector>
+
+namespace {
+
+/* Edges of a n x n grid graph in row-by-row order */
+std::vector<bill::graph_edge> grid_graph(uint32_t n)
+{
+	std::vector<bill::graph_edge> edges;
+	for (auto row = 0u; row < n; ++row) {
+		for (auto column = 0u; column < n; ++column) {
+			auto const v = row * n + column;
+			if (column + 1 < n) {
+				edges.emplace_back(v, v + 1);
+			}
+			if (row + 1 < n) {
+				edges.emplace_back(v, v + n);
+			}
+		}
+	}
+	return edges;
+}
+
+} // namespace
+
+TEST_CASE("ZDD simple paths", "[zdd][simpath]")
+{
+	using namespace bill;
+	SECTION("Single edge")
+	{
+		zdd_base zdd(1);
+		auto const paths = simple_paths(zdd, 2, {{0, 1}}, 0, 1);
+		CHECK(paths == zdd.elementary(0));
+	}
+	SECTION("Disconnected terminals")
+	{
+		zdd_base zdd(1);
+		auto const paths = simple_paths(zdd, 4, {{0, 1}}, 0, 3);
+		CHECK(paths == zdd.bottom());
+	}
+	SECTION("3 x 3 grid")
+	{
+		auto const edges = grid_graph(3);
+		zdd_base zdd(edges.size());
+		auto const paths = simple_paths(zdd, 9, edges, 0, 8);
+		CHECK(zdd.count_sets(paths) == 12u);
+
+		/* restrict to shortest paths */
+		auto universe = zdd.bottom();
+		for (auto i = 0u; i < edges.size(); ++i) {
+			universe = zdd.union_(universe, zdd.elementary(i));
+		}
+		auto const shortest = zdd.intersection(paths, zdd.choose(universe, 4));
+		CHECK(zdd.count_sets(shortest) == 6u);
+	}
+	SECTION("4 x 4 grid")
+	{
+		auto const edges = grid_graph(4);
+		zdd_base zdd(edges.size());
+		auto const paths = simple_paths(zdd, 16, edges, 0, 15);
+		CHECK(zdd.count_sets(paths) == 184u);
+	}
+	SECTION("Reversed variable order")
+	{
+		auto const edges = grid_graph(3);
+		std::vector<uint32_t> order(edges.size());
+		for (auto level = 0u; level < order.size(); ++level) {
+			order.at(level) = order.size() - 1u - level;
+		}
+		zdd_base zdd(order);
+		zdd_base reference(edges.size());
+		auto const paths = simple_paths(zdd, 9, edges, 0, 8);
+		auto const expected = simple_paths(reference, 9, edges, 0, 8);
+		CHECK(zdd.count_sets(paths) == 12u);
+
+		auto sets = zdd.sets_as_vectors(paths);
+		for (auto& set : sets) {
+			std::sort(set.begin(), set.end());
+		}
+		std::sort(sets.begin(), sets.end());
+		auto expected_sets = reference.sets_as_vectors(expected);
+		std::sort(expected_sets.begin(), expected_sets.end());
+		CHECK(sets == expected_sets);
+	}
+}
+
+TEST_CASE("ZDD simple cycles", "[zdd][simpath]")
+{
+	using namespace bill;
+	SECTION("Triangle")
+	{
+		zdd_base zdd(3);
+		auto const cycles = simple_cycles(zdd, 3, {{0, 1}, {1, 2}, {0, 2}});
+		CHECK(zdd.sets_as_vectors(cycles) == std::vector<std::vector<uint32_t>>{{0, 1, 2}});
+	}
+	SECTION("Grids")
+	{
+		auto const edges_3 = grid_graph(3);
+		zdd_base zdd_3(edges_3.size());
+		CHECK(zdd_3.count_sets(simple_cycles(zdd_3, 9, edges_3)) == 13u);
+
+		auto const edges_4 = grid_graph(4);
+		zdd_base zdd_4(edges_4.size());
+		CHECK(zdd_4.count_sets(simple_cycles(zdd_4, 16, edges_4)) == 213u);
+	}
+}
+
+TEST_CASE("ZDD spanning forests and trees", "[zdd][simpath]")
+{
+	using namespace bill;
+	SECTION("Triangle")
+	{
+		zdd_base zdd(3);
+		std::vector<graph_edge> const edges = {{0, 1}, {1, 2}, {0, 2}};
+		CHECK(zdd.count_sets(spanning_forests(zdd, 3, edges)) == 7u);
+		CHECK(zdd.count_sets(spanning_trees(zdd, 3, edges)) == 3u);
+	}
+	SECTION("Isolated vertex")
+	{
+		zdd_base zdd(1);
+		CHECK(spanning_trees(zdd, 3, {{0, 1}}) == zdd.bottom());
+	}
+	SECTION("Grids")
+	{
+		auto const edges_3 = grid_graph(3);
+		zdd_base zdd_3(edges_3.size());
+		CHECK(zdd_3.count_sets(spanning_forests(zdd_3, 9, edges_3)) == 3102u);
+		CHECK(zdd_3.count_sets(spanning_trees(zdd_3, 9, edges_3)) == 192u);
+
+		auto const edges_4 = grid_graph(4);
+		zdd_base zdd_4(edges_4.size());
+		CHECK(zdd_4.count_sets(spanning_trees(zdd_4, 16, edges_4)) == 100352u);
+	}
+}
+
+TEST_CASE("ZDD matchings", "[zdd][simpath]")
+{
+	using namespace bill;
+	auto const edges_3 = grid_graph(3);
+	zdd_base zdd_3(edges_3.size());
+	CHECK(zdd_3.count_sets(matchings(zdd_3, 9, edges_3)) == 131u);
+	CHECK(perfect_matchings(zdd_3, 9, edges_3) == zdd_3.bottom());
+
+	auto const edges_4 = grid_graph(4);
+	zdd_base zdd_4(edges_4.size());
+	CHECK(zdd_4.count_sets(perfect_matchings(zdd_4, 16, edges_4)) == 36u);
+
+	std::vector<uint32_t> order(edges_4.size());
+	for (auto level = 0u; level < order.size(); ++level) {
+		order.at(level) = order.size() - 1u - level;
+	}
+	zdd_base reversed(order);
+	CHECK(reversed.count_sets(perfect_matchings(reversed, 16, edges_4)) == 36u);
+}
@@ -0,0 +1,105 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <bill/dd/exact_cover.hpp>
+#include <bill/dd/transfer.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+template<class Manager, class Node>
+std::vector<std::vector<uint32_t>> sorted_sets(Manager& zdd, Node const& f)
+{
+	auto sets = zdd.sets_as_vectors(f);
+	for (auto& set : sets) {
+		std::sort(set.begin(), set.end());
+	}
+	std::sort(sets.begin(), sets.end());
+	return sets;
+}
+
+} // namespace
+
+TEST_CASE("Transfer ZDDs between zdd_base and CUDD", "[zdd][cudd][transfer]")
+{
+	using namespace bill;
+	/* 6-queens as exact cover, see test/dd/exact_cover.cpp */
+	std::vector<std::vector<uint32_t>> options;
+	for (auto row = 0u; row < 6u; ++row) {
+		for (auto column = 0u; column < 6u; ++column) {
+			options.push_back({row, 6u + column, 12u + row + column, 23u + 5u + row - column});
+		}
+	}
+	zdd_base zdd(options.size());
+	auto const covers = exact_covers(zdd, 34u, options, 22u);
+	REQUIRE(zdd.count_sets(covers) == 4u);
+	auto const partial = zdd.choose(zdd.union_(zdd.elementary(0), zdd.elementary(1)), 1);
+
+	SECTION("Same order")
+	{
+		cudd::cudd_zdd cudd_zdd(options.size());
+		auto const copies = transfer(zdd, {covers, partial, covers}, cudd_zdd);
+		CHECK(cudd_zdd.count_sets(copies.at(0)) == 4u);
+		CHECK(cudd_zdd.count_nodes(copies.at(0).getNode()) == zdd.count_nodes(covers));
+		CHECK(copies.at(0) == copies.at(2));
+		CHECK(sorted_sets(cudd_zdd, copies.at(0)) == sorted_sets(zdd, covers));
+		CHECK(copies.at(1) == cudd_zdd.union_(cudd_zdd.elementary(0), cudd_zdd.elementary(1)));
+
+		/* the node is canonical, hence the round trip gives back the same node */
+		auto const back = transfer(cudd_zdd, copies.at(0), zdd);
+		CHECK(back == covers);
+		zdd.deref(back);
+	}
+	SECTION("Different order")
+	{
+		std::vector<uint32_t> order(options.size());
+		for (auto i = 0u; i < order.size(); ++i) {
+			order.at(i) = order.size() - 1u - i;
+		}
+		cudd::cudd_zdd cudd_zdd(order);
+		auto const copy = transfer(zdd, covers, cudd_zdd);
+		CHECK(sorted_sets(cudd_zdd, copy) == sorted_sets(zdd, covers));
+
+		zdd_base reversed(order);
+		auto const back = transfer(cudd_zdd, copy, reversed);
+		CHECK(sorted_sets(reversed, back) == sorted_sets(zdd, covers));
+	}
+}
+
+TEST_CASE("Convert between CUDD ZDDs and BDDs", "[cudd][transfer]")
+{
+	SECTION("Characteristic functions")
+	{
+		cudd::cudd_zdd zdd( 3u );
+		auto const f = ( zdd.bdd_variable( 0 ) & !zdd.bdd_variable( 1 ) ) | zdd.bdd_variable( 2 );
+		auto const family = zdd.from_bdd( f );
+		CHECK( zdd.count_sets( family ) == 5u );
+		CHECK( zdd.to_bdd( family ) == f );
+		CHECK( zdd.to_bdd( zdd.tautology() ) == zdd.manager().bddOne() );
+		CHECK( zdd.from_bdd( zdd.manager().bddZero() ) == zdd.bottom() );
+	}
+	SECTION("Characteristic functions with a given order")
+	{
+		cudd::cudd_zdd zdd( std::vector<uint32_t>{ 2u, 0u, 1u } );
+		auto const f = zdd.bdd_variable( 0 ) ^ zdd.bdd_variable( 2 );
+		auto const family = zdd.from_bdd( f );
+		CHECK( zdd.count_sets( family ) == 4u );
+		CHECK( zdd.to_bdd( family ) == f );
+	}
+	SECTION("Irredundant sum of products")
+	{
+		/* 3 BDD variables, one ZDD variable per literal */
+		cudd::cudd_zdd zdd( 6u );
+		auto const f = ( zdd.bdd_variable( 0 ) & !zdd.bdd_variable( 1 ) ) | zdd.bdd_variable( 2 );
+		BDD function;
+		auto const cover = zdd.isop( f, f, &function );
+		CHECK( function == f );
+		auto sets = zdd.sets_as_vectors( cover );
+		std::sort( sets.begin(), sets.end() );
+		CHECK( sets == std::vector<std::vector<uint32_t>>{ { 0, 3 }, { 4 } } );
+	}
+}
@@ -0,0 +1,149 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <bill/dd/cudd_zdd.hpp>
+#include <bill/dd/simpath.hpp>
+#include <bill/dd/variable_order.hpp>
+#include <bill/dd/zdd.hpp>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+bool is_permutation(std::vector<uint32_t> order, uint32_t size)
+{
+	std::vector<uint32_t> identity(size);
+	std::iota(identity.begin(), identity.end(), 0u);
+	std::sort(order.begin(), order.end());
+	return order == identity;
+}
+
+/* A path 0 - 1 - ... - (n - 1) whose vertices are scrambled */
+bill::hypergraph scrambled_chain(uint32_t n)
+{
+	bill::hypergraph hyperedges;
+	for (auto i = 0u; i + 1 < n; ++i) {
+		hyperedges.push_back({(i * 7u) % n, ((i + 1) * 7u) % n});
+	}
+	return hyperedges;
+}
+
+} // namespace
+
+TEST_CASE("Variable order heuristics", "[zdd][variable_order]")
+{
+	using namespace bill;
+	auto const chain = scrambled_chain(20);
+	std::vector<uint32_t> identity(20);
+	std::iota(identity.begin(), identity.end(), 0u);
+	auto const initial_span = total_span(identity, chain);
+
+	SECTION("FORCE")
+	{
+		auto const order = force_order(20, chain);
+		CHECK(is_permutation(order, 20));
+		CHECK(total_span(order, chain) < initial_span);
+	}
+	SECTION("Cuthill-McKee")
+	{
+		auto const order = cuthill_mckee_order(20, chain);
+		CHECK(is_permutation(order, 20));
+		CHECK(total_span(order, chain) == 19u);
+	}
+	SECTION("CNF")
+	{
+		std::vector<std::vector<lit_type>> clauses;
+		for (auto const& hyperedge : chain) {
+			clauses.push_back({lit_type(hyperedge.at(0), negative_polarity),
+			                   lit_type(hyperedge.at(1), positive_polarity)});
+		}
+		auto const order = clause_order(20, clauses);
+		CHECK(is_permutation(order, 20));
+		CHECK(total_span(order, chain) == 19u);
+	}
+	SECTION("Frontier width")
+	{
+		/* a 4 x 4 grid whose edges are in a bad order */
+		std::vector<graph_edge> edges;
+		for (auto column = 0u; column < 4u; ++column) {
+			for (auto row = 0u; row < 4u; ++row) {
+				if (column + 1 < 4u) {
+					edges.emplace_back(row * 4 + column, row * 4 + column + 1);
+				}
+			}
+		}
+		for (auto row = 0u; row + 1 < 4u; ++row) {
+			for (auto column = 0u; column < 4u; ++column) {
+				edges.emplace_back(row * 4 + column, (row + 1) * 4 + column);
+			}
+		}
+		std::vector<uint32_t> given(edges.size());
+		std::iota(given.begin(), given.end(), 0u);
+		auto const order = frontier_order(16, edges);
+		CHECK(is_permutation(order, edges.size()));
+		CHECK(frontier_width(16, edges, order) <= 5u);
+		CHECK(frontier_width(16, edges, order) < frontier_width(16, edges, given));
+
+		std::vector<graph_edge> ordered_edges;
+		for (auto const index : order) {
+			ordered_edges.emplace_back(edges.at(index));
+		}
+		zdd_base zdd(edges.size());
+		CHECK(zdd.count_sets(simple_paths(zdd, 16, ordered_edges, 0, 15)) == 184u);
+	}
+}
+
+TEST_CASE("ZDD with a given variable order", "[zdd][variable_order]")
+{
+	using namespace bill;
+	std::vector<uint32_t> const order = {2, 0, 3, 1};
+	zdd_base zdd(order);
+	CHECK(zdd.level(2) == 0u);
+	CHECK(zdd.var_at_level(3) == 1u);
+
+	auto const zdd_01 = zdd.join(zdd.elementary(0), zdd.elementary(1));
+	auto const zdd_23 = zdd.join(zdd.elementary(2), zdd.elementary(3));
+	auto const family = zdd.union_(zdd_01, zdd.union_(zdd_23, zdd.elementary(1)));
+	CHECK(zdd.count_sets(family) == 3u);
+
+	std::vector<std::vector<uint32_t>> sets;
+	zdd.foreach_set(family, [&](auto set) {
+		std::sort(set.begin(), set.end());
+		sets.emplace_back(set);
+		return true;
+	});
+	std::sort(sets.begin(), sets.end());
+	CHECK(sets == std::vector<std::vector<uint32_t>>{{0, 1}, {1}, {2, 3}});
+
+	auto const pairs = zdd.choose(zdd.union_(zdd.union_(zdd.elementary(0), zdd.elementary(1)),
+	                                         zdd.union_(zdd.elementary(2), zdd.elementary(3))),
+	                              2);
+	CHECK(zdd.count_sets(pairs) == 6u);
+	CHECK(zdd.count_sets(zdd.intersection(pairs, family)) == 2u);
+}
+
+TEST_CASE("CUDD ZDD with a given variable order", "[cudd][variable_order]")
+{
+	std::vector<uint32_t> const order = {2, 0, 3, 1};
+	cudd::cudd_zdd zdd( order );
+	CHECK( zdd.level( 2 ) == 0u );
+	CHECK( zdd.var_at_level( 3 ) == 1u );
+
+	auto const zdd_01 = zdd.join( zdd.elementary( 0 ), zdd.elementary( 1 ) );
+	auto const zdd_23 = zdd.join( zdd.elementary( 2 ), zdd.elementary( 3 ) );
+	auto const family = zdd.union_( zdd_01, zdd.union_( zdd_23, zdd.elementary( 1 ) ) );
+	CHECK( zdd.count_sets( family ) == 3u );
+
+	auto const all = zdd.union_( zdd.union_( zdd.elementary( 0 ), zdd.elementary( 1 ) ),
+	                             zdd.union_( zdd.elementary( 2 ), zdd.elementary( 3 ) ) );
+	auto const pairs = zdd.choose( all, 2 );
+	CHECK( zdd.count_sets( pairs ) == 6u );
+	CHECK( zdd.count_sets( zdd.intersection( pairs, family ) ) == 2u );
+	CHECK( zdd.count_sets( zdd.nonsupersets( pairs, zdd.elementary( 0 ) ) ) == 3u );
+	CHECK( zdd.count_sets( zdd.tautology() ) == 16u );
+	CHECK( zdd.count_sets( zdd.care( { 0, 3 } ) ) == 4u );
+}
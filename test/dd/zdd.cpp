@@ -5,10 +5,12 @@
 #include "../catch2.hpp"
 
 #include <bill/dd/zdd.hpp>
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <vector>
 
 // TODO: Improve test case for choose
-// TODO: Implement test case for nonsubsets
 // TODO: Implement test case for nonsupersets
 // TODO: Implement test case which uses garbage collection
 
@@ -441,6 +443,53 @@ TEST_CASE("ZDD meet operator (@)", "[zdd]")
 	}
 }
 
+TEST_CASE("ZDD nonsubsets, maximal and edivide", "[zdd]")
+{
+	using namespace bill;
+	zdd_base zdd(7);
+	auto const family = [&](std::vector<std::vector<uint32_t>> const& sets) {
+		auto result = zdd.bottom();
+		for (auto const& set : sets) {
+			auto product = zdd.top();
+			for (auto const var : set) {
+				product = zdd.join(product, zdd.elementary(var));
+			}
+			result = zdd.union_(result, product);
+		}
+		return result;
+	};
+	auto const sorted_sets = [&](auto f) {
+		auto sets = zdd.sets_as_vectors(f);
+		std::sort(sets.begin(), sets.end());
+		return sets;
+	};
+	auto const zdd_x = family({{1, 2, 3}, {3, 4}, {5}});
+	auto const zdd_y = family({{0, 2, 3}, {3, 4}, {6}});
+
+	SECTION("Nonsubsets")
+	{
+		CHECK(sorted_sets(zdd.nonsubsets(zdd_x, zdd_y))
+		      == std::vector<std::vector<uint32_t>>{{1, 2, 3}, {5}});
+		CHECK(zdd.nonsubsets(zdd_x, zdd.bottom()) == zdd_x);
+		CHECK(zdd.nonsubsets(zdd_x, zdd_x) == zdd.bottom());
+		CHECK(zdd.nonsubsets(family({{1}}), family({{0, 1}})) == zdd.bottom());
+	}
+	SECTION("Maximal")
+	{
+		CHECK(zdd.maximal(zdd.union_(zdd_x, family({{3}, {1, 2}, {}}))) == zdd_x);
+		CHECK(zdd.maximal(zdd.top()) == zdd.top());
+	}
+	SECTION("Edivide")
+	{
+		auto const f = zdd.union_(zdd.join(family({{0}, {1}}), family({{2}, {3}})), family({{4}}));
+		CHECK(zdd.edivide(f, family({{2}, {3}})) == family({{0}, {1}}));
+		CHECK(zdd.edivide(f, family({{2}})) == family({{0}, {1}}));
+		CHECK(zdd.edivide(f, zdd.top()) == f);
+		CHECK(zdd.edivide(f, f) == zdd.top());
+		CHECK(zdd.edivide(f, family({{5}})) == zdd.bottom());
+	}
+}
+
 TEST_CASE("ZDD union operator (|)", "[zdd]")
 {
 	using namespace bill;
@@ -534,3 +583,150 @@ TEST_CASE("ZDD tautology", "[zdd]")
 		                  "{ 0, 1, 2 }\n");
 	}
 }
+
+TEST_CASE("ZDD statistics", "[zdd]")
+{
+	using namespace bill;
+	zdd_base zdd(8);
+	auto universe = zdd.bottom();
+	for (auto var = 0u; var < 8u; ++var) {
+		auto const next = zdd.union_(universe, zdd.elementary(var));
+		zdd.deref(universe);
+		universe = next;
+	}
+	auto const pairs = zdd.choose(universe, 2);
+	zdd.deref(zdd.choose(universe, 2));
+
+	auto st = zdd.stats();
+	auto const& choose = st.operation(zdd_operation::choose);
+	CHECK(choose.calls > 0u);
+	CHECK(choose.cache_lookups > choose.cache_misses);
+	CHECK(choose.hit_rate() > 0.0);
+	CHECK(st.operation(zdd_operation::join).calls == 0u);
+	CHECK(st.cache_lookups >= choose.cache_lookups);
+	CHECK(st.num_nodes == zdd.num_nodes());
+	CHECK(st.peak_nodes >= st.num_nodes);
+	CHECK(st.unique_entries > 0u);
+	CHECK(st.unique_load_factor() > 0.0);
+	CHECK(st.memory_in_use > 0u);
+	CHECK(st.peak_memory >= st.memory_in_use);
+
+	zdd.deref(pairs);
+	zdd.collect_garbage();
+	auto const num_garbage_collections = st.num_garbage_collections;
+	st = zdd.stats();
+	CHECK(st.num_garbage_collections == num_garbage_collections + 1u);
+	CHECK(st.num_dead_nodes == 0u);
+
+	zdd.reset_stats();
+	st = zdd.stats();
+	CHECK(st.cache_lookups == 0u);
+	CHECK(st.operation(zdd_operation::choose).calls == 0u);
+	CHECK(st.num_garbage_collections == 0u);
+	CHECK(st.peak_nodes == zdd.num_nodes());
+}
+
+TEST_CASE("ZDD limits", "[zdd]")
+{
+	using namespace bill;
+	zdd_base zdd(16, 6);
+	auto const num_initial_nodes = zdd.num_nodes();
+	auto universe = zdd.bottom();
+	for (auto var = 0u; var < 16u; ++var) {
+		auto const next = zdd.union_(universe, zdd.elementary(var));
+		zdd.deref(universe);
+		universe = next;
+	}
+	auto const pairs = zdd.choose(universe, 2);
+	zdd.collect_garbage();
+	auto const num_nodes = zdd.num_nodes();
+	CHECK(zdd.status() == zdd_status::ok);
+
+	SECTION("Node limit")
+	{
+		zdd.set_limits({num_nodes + 10u});
+		CHECK(zdd.join(pairs, pairs) == zdd.aborted());
+		CHECK(zdd.status() == zdd_status::node_limit);
+		CHECK(zdd.num_nodes() == num_nodes);
+		zdd.set_limits({num_nodes});
+		CHECK(zdd.unique(0, zdd.ref(zdd.top()), zdd.ref(zdd.top())) == zdd.aborted());
+		CHECK(zdd.num_nodes() == num_nodes);
+	}
+	SECTION("Memory limit")
+	{
+		zdd_limits limits;
+		limits.max_memory = 1u;
+		zdd.set_limits(limits);
+		CHECK(zdd.join(pairs, pairs) == zdd.aborted());
+		CHECK(zdd.status() == zdd_status::memory_limit);
+		CHECK(zdd.num_nodes() == num_nodes);
+	}
+	SECTION("Step limit")
+	{
+		zdd_limits limits;
+		limits.max_steps = 5u;
+		zdd.set_limits(limits);
+		CHECK(zdd.join(pairs, pairs) == zdd.aborted());
+		CHECK(zdd.status() == zdd_status::step_limit);
+		CHECK(zdd.num_nodes() == num_nodes);
+		auto const pair = zdd.join(zdd.elementary(0), zdd.elementary(1));
+		CHECK(zdd.status() == zdd_status::ok);
+		CHECK(zdd.count_sets(pair) == 1u);
+		zdd.deref(pair);
+	}
+
+	/* The ZDD base is still consistent, the operation succeeds once the limits are lifted */
+	zdd.set_limits({});
+	auto const sets = zdd.join(pairs, pairs);
+	CHECK(zdd.status() == zdd_status::ok);
+	CHECK(zdd.count_sets(sets) == 120u + 560u + 1820u);
+	zdd.deref(sets);
+	zdd.deref(pairs);
+	zdd.deref(universe);
+	zdd.collect_garbage();
+	CHECK(zdd.num_nodes() == num_initial_nodes);
+}
+
+TEST_CASE("ZDD time limit", "[zdd]")
+{
+	using namespace bill;
+	zdd_base zdd(64, 21);
+	auto const num_initial_nodes = zdd.num_nodes();
+	auto universe = zdd.bottom();
+	for (auto var = 0u; var < 64u; ++var) {
+		auto const next = zdd.union_(universe, zdd.elementary(var));
+		zdd.deref(universe);
+		universe = next;
+	}
+	auto const sixes = zdd.choose(universe, 6);
+	zdd.collect_garbage();
+	auto const num_nodes = zdd.num_nodes();
+
+	/* the join takes tens of milliseconds even in optimized builds */
+	zdd_limits limits;
+	limits.time_limit = std::chrono::milliseconds(1);
+	zdd.set_limits(limits);
+	CHECK(zdd.join(sixes, sixes) == zdd.aborted());
+	CHECK(zdd.status() == zdd_status::timeout);
+	zdd.collect_garbage();
+	CHECK(zdd.num_nodes() == num_nodes);
+
+	/* the ZDD base is still consistent, the operation completes once the limit is lifted */
+	zdd.set_limits({});
+	auto const sets = zdd.join(sixes, sixes);
+	CHECK(zdd.status() == zdd_status::ok);
+	uint64_t expected = 0u;
+	for (auto size = 6u; size <= 12u; ++size) {
+		uint64_t binomial = 1u;
+		for (auto i = 0u; i < size; ++i) {
+			binomial = binomial * (64u - i) / (i + 1u);
+		}
+		expected += binomial;
+	}
+	CHECK(zdd.count_sets(sets) == expected);
+	zdd.deref(sets);
+	zdd.deref(sixes);
+	zdd.deref(universe);
+	zdd.collect_garbage();
+	CHECK(zdd.num_nodes() == num_initial_nodes);
+}
@@ -0,0 +1,100 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <bill/dd/zdd_cnf.hpp>
+#include <bill/dd/zdd_manager.hpp>
+#include <bill/sat/solver.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/* Checks, for every assignment of `vars`, that the solver agrees with the family */
+template<class Manager, class Solver>
+bool matches_family(bill::zdd_family<Manager> const& family, Solver& solver,
+                    std::vector<bill::lit_type> const& vars, bill::lit_type y)
+{
+	using namespace bill;
+	auto const sets = family.sets_as_vectors();
+	for (uint32_t mask = 0u; mask < (1u << vars.size()); ++mask) {
+		std::vector<uint32_t> set;
+		std::vector<lit_type> assumptions;
+		for (auto i = 0u; i < vars.size(); ++i) {
+			auto const value = bool((mask >> i) & 1u);
+			if (value) {
+				set.emplace_back(i);
+			}
+			assumptions.emplace_back(value ? vars.at(i) : ~vars.at(i));
+		}
+		auto const in_family = std::any_of(sets.begin(), sets.end(), [&](auto other) {
+			std::sort(other.begin(), other.end());
+			return other == set;
+		});
+		assumptions.emplace_back(y);
+		if ((solver.solve(assumptions) == result::states::satisfiable) != in_family) {
+			return false;
+		}
+		assumptions.back() = ~y;
+		if ((solver.solve(assumptions) == result::states::satisfiable) == in_family) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Encode a ZDD as CNF", "[zdd][cudd][zdd_cnf]", bill::zdd_base, cudd::cudd_zdd)
+{
+	using namespace bill;
+	std::vector<std::vector<uint32_t>> const sets = {{0, 2}, {1}, {0, 1, 3, 5}, {4}, {}, {2, 3}};
+
+	SECTION("Families")
+	{
+		for (auto const& order : {std::vector<uint32_t>{0, 1, 2, 3, 4, 5},
+		                          std::vector<uint32_t>{3, 0, 5, 1, 4, 2}}) {
+			zdd_manager<TestType> zdd(order);
+			auto universe = zdd.bottom();
+			for (auto var = 0u; var < 6u; ++var) {
+				universe = universe | zdd.elementary(var);
+			}
+			for (auto const& family : {zdd.family(sets), zdd.choose(universe, 2), zdd.tautology(),
+			                           zdd.top(), zdd.bottom()}) {
+				solver<solvers::glucose_41> solver;
+				std::vector<lit_type> vars;
+				for (auto i = 0u; i < 6u; ++i) {
+					vars.emplace_back(solver.add_variable(), positive_polarity);
+				}
+				auto const y = add_zdd_constraint(solver, zdd.backend(), family.node(), vars);
+				CHECK(matches_family(family, solver, vars, y));
+			}
+		}
+	}
+	SECTION("Propagation")
+	{
+		/* exactly two of six: after asserting two variables, the others are implied */
+		zdd_manager<TestType> zdd(6u);
+		auto universe = zdd.bottom();
+		for (auto var = 0u; var < 6u; ++var) {
+			universe = universe | zdd.elementary(var);
+		}
+		auto const pairs = zdd.choose(universe, 2);
+		solver<solvers::glucose_41> solver;
+		std::vector<lit_type> vars;
+		for (auto i = 0u; i < 6u; ++i) {
+			vars.emplace_back(solver.add_variable(), positive_polarity);
+		}
+		auto const y = add_zdd_constraint(solver, zdd.backend(), pairs.node(), vars);
+		solver.add_clause(y);
+		CHECK(solver.solve({vars.at(1), vars.at(4)}, 1u) == result::states::satisfiable);
+		auto const model = solver.get_model().model();
+		for (auto i = 0u; i < 6u; ++i) {
+			CHECK((model.at(vars.at(i).variable()) == lbool_type::true_) == (i == 1u || i == 4u));
+		}
+		CHECK(solver.solve({vars.at(0), vars.at(2), vars.at(5)}) ==
+		      result::states::unsatisfiable);
+	}
+}
@@ -0,0 +1,144 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include <bill/dd/zdd_manager.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+template<class Manager>
+std::vector<std::vector<uint32_t>> sorted_sets(bill::zdd_family<Manager> const& f)
+{
+	auto sets = f.sets_as_vectors();
+	for (auto& set : sets) {
+		std::sort(set.begin(), set.end());
+	}
+	std::sort(sets.begin(), sets.end());
+	return sets;
+}
+
+template<class Manager>
+uint64_t count_pairs(bill::zdd_manager<Manager>& zdd)
+{
+	auto universe = zdd.bottom();
+	for (auto var = 0u; var < zdd.num_variables(); ++var) {
+		universe = universe | zdd.elementary(var);
+	}
+	return zdd.choose(universe, 2).count_sets();
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("ZDD front end", "[zdd][cudd][zdd_manager]", bill::zdd_base, cudd::cudd_zdd)
+{
+	using namespace bill;
+	zdd_manager<TestType> zdd(7u);
+	CHECK(zdd.num_variables() == 7u);
+
+	auto const zdd_x = zdd.family({{1, 2, 3}, {3, 4}, {5}});
+	auto const zdd_y = zdd.family({{0, 2, 3}, {3, 4}, {6}});
+	CHECK(zdd_x.count_sets() == 3u);
+	CHECK(zdd.tautology().count_sets() == 128u);
+	CHECK(zdd.bottom().count_sets() == 0u);
+	CHECK(zdd.top().count_sets() == 1u);
+
+	SECTION("Set operations")
+	{
+		CHECK(sorted_sets(zdd_x | zdd_y)
+		      == std::vector<std::vector<uint32_t>>{{0, 2, 3}, {1, 2, 3}, {3, 4}, {5}, {6}});
+		CHECK((zdd_x & zdd_y) == zdd.family({{3, 4}}));
+		CHECK((zdd_x - zdd_y) == zdd.family({{1, 2, 3}, {5}}));
+		CHECK((zdd_x * zdd_y).count_sets() == 9u);
+		CHECK(zdd.join(zdd_x, zdd_y) == zdd_y * zdd_x);
+		CHECK(zdd.union_(zdd_x, zdd.bottom()) == zdd_x);
+	}
+	SECTION("Family algebra")
+	{
+		CHECK(zdd.meet(zdd_x, zdd_y) == zdd.family({{}, {3}, {2, 3}, {3, 4}}));
+		CHECK(zdd.nonsubsets(zdd_x, zdd_y) == zdd.family({{1, 2, 3}, {5}}));
+		CHECK(zdd.nonsupersets(zdd_x, zdd.elementary(3)) == zdd.family({{5}}));
+		CHECK(zdd.maximal(zdd_x | zdd.family({{3}, {1, 2}})) == zdd_x);
+		CHECK(zdd.edivide(zdd_x, zdd.elementary(3)) == zdd.family({{1, 2}, {4}}));
+		CHECK(count_pairs(zdd) == 21u);
+	}
+	SECTION("Handles")
+	{
+		auto copy = zdd_x;
+		CHECK(copy == zdd_x);
+		auto moved = std::move(copy);
+		CHECK(moved == zdd_x);
+		moved = zdd_y;
+		CHECK(moved != zdd_x);
+		CHECK(moved.count_nodes() == zdd_y.count_nodes());
+	}
+}
+
+TEST_CASE("ZDD front end releases nodes", "[zdd][zdd_manager]")
+{
+	using namespace bill;
+	zdd_manager<zdd_base> zdd(8u);
+	auto const num_nodes = zdd.backend().num_nodes();
+	{
+		auto universe = zdd.bottom();
+		for (auto var = 0u; var < 8u; ++var) {
+			universe = universe | zdd.elementary(var);
+		}
+		auto const triples = zdd.choose(universe, 3);
+		CHECK(triples.count_sets() == 56u);
+		CHECK(zdd.backend().num_nodes() > num_nodes);
+	}
+	CHECK(zdd.backend().num_nodes() == num_nodes);
+}
+
+TEST_CASE("ZDD front end releases terminals", "[zdd][zdd_manager]")
+{
+	using namespace bill;
+	zdd_manager<zdd_base> zdd(4u);
+	auto& backend = zdd.backend();
+	auto const bottom_refs = backend.num_references(backend.bottom());
+	auto const top_refs = backend.num_references(backend.top());
+	{
+		auto const x = zdd.family({{0, 1}, {2}});
+		auto const y = zdd.family({{3}});
+		for (auto i = 0u; i < 100u; ++i) {
+			/* operations that yield terminals */
+			auto const empty = x & y;
+			auto const unit = zdd.edivide(x, x);
+			CHECK(empty == zdd.bottom());
+			CHECK(unit == zdd.top());
+			auto copy = unit;
+			auto moved = std::move(copy);
+		}
+	}
+	CHECK(backend.num_references(backend.bottom()) == bottom_refs);
+	CHECK(backend.num_references(backend.top()) == top_refs);
+
+	/* a family holding an aborted result owns no reference */
+	{
+		auto const universe = zdd.family({{0}, {1}, {2}, {3}});
+		zdd_limits limits;
+		limits.max_nodes = backend.num_nodes();
+		backend.set_limits(limits);
+		auto const aborted = zdd.choose(universe, 2u);
+		CHECK(aborted.node() == backend.aborted());
+		auto const copy = aborted;
+		backend.set_limits({});
+	}
+	CHECK(backend.num_references(backend.bottom()) == bottom_refs);
+	CHECK(backend.num_references(backend.top()) == top_refs);
+}
+
+TEST_CASE("ZDD backend selected at run time", "[zdd][cudd][zdd_manager]")
+{
+	using namespace bill;
+	for (auto const backend : {zdd_backend::bill, zdd_backend::cudd}) {
+		auto const count = with_zdd_manager(backend, 10u, [](auto& zdd) {
+			return count_pairs(zdd);
+		});
+		CHECK(count == 45u);
+	}
+}
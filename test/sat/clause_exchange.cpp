@@ -0,0 +1,190 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+
+#include <bill/sat/clause_exchange.hpp>
+#include <bill/sat/portfolio.hpp>
+#include <bill/sat/solver.hpp>
+#include <future>
+#include <utility>
+#include <vector>
+
+#if defined(BILL_WINDOWS_PLATFORM)
+#define SHARING_SOLVER_TYPES bill::solver<bill::solvers::glucose_41>, bill::solver<bill::solvers::ghack>
+#else
+#define SHARING_SOLVER_TYPES                                                                     \
+	bill::solver<bill::solvers::glucose_41>, bill::solver<bill::solvers::ghack>, \
+	    bill::solver<bill::solvers::maple>
+#endif
+
+namespace {
+
+/* Solves `clauses` with two solvers that share clauses, returns the numbers of imports (which
+ * may be zero if a solver answers before its first restart) */
+template<typename First, typename Second>
+std::pair<uint64_t, uint64_t> solve_sharing(cnf_type const& clauses, uint32_t num_variables,
+                                            bill::clause_exchange_params const& params)
+{
+	using namespace bill;
+	clause_exchange exchange(2u, params);
+	First first;
+	Second second;
+	first.share_clauses(exchange);
+	second.share_clauses(exchange);
+	first.add_variables(num_variables);
+	second.add_variables(num_variables);
+	first.add_clauses(clauses);
+	second.add_clauses(clauses);
+
+	auto answer = std::async(std::launch::async, [&]() { return second.solve(); });
+	CHECK(first.solve() == result::states::unsatisfiable);
+	CHECK(answer.get() == result::states::unsatisfiable);
+	CHECK(exchange.num_exported(0u) > 0u);
+	CHECK(exchange.num_exported(1u) > 0u);
+	return {exchange.num_imported(0u), exchange.num_imported(1u)};
+}
+
+} // namespace
+
+TEST_CASE("Clause exchange", "[clause_exchange]")
+{
+	using namespace bill;
+	clause_exchange_params params;
+	params.max_size = 3u;
+	params.max_lbd = 2u;
+	params.capacity = 3u;
+	clause_exchange exchange(3u, params);
+	auto const a = exchange.join(), b = exchange.join(), c = exchange.join();
+	CHECK(exchange.num_participants() == 3u);
+
+	std::vector<lit_type> const clause = {lit_type(0u), ~lit_type(1u), lit_type(2u), lit_type(3u)};
+	CHECK(exchange.export_clause(a, clause.data(), clause.data() + 2, 2u));
+	CHECK_FALSE(exchange.export_clause(a, clause.data(), clause.data() + 4, 2u));
+	CHECK_FALSE(exchange.export_clause(a, clause.data(), clause.data() + 2, 3u));
+	CHECK(exchange.export_clause(b, clause.data() + 1, clause.data() + 2, 1u));
+
+	auto const never = []() { return false; };
+	auto import = [&](uint32_t id) {
+		std::vector<std::vector<lit_type>> imported;
+		exchange.import_clauses(
+		    id,
+		    [&](lit_type const* begin, lit_type const* end, uint32_t) {
+			    imported.emplace_back(begin, end);
+			    return true;
+		    },
+		    never);
+		return imported;
+	};
+	CHECK(import(c) == std::vector<std::vector<lit_type>>{{lit_type(0u), ~lit_type(1u)}, {~lit_type(1u)}});
+	CHECK(import(c).empty());
+	CHECK(import(a) == std::vector<std::vector<lit_type>>{{~lit_type(1u)}});
+
+	/* a slow reader loses the clauses that may be overwritten (the capacity is rounded up to
+	 * 4, and the next write may overwrite the oldest clause) */
+	for (auto i = 0u; i < 6u; ++i) {
+		lit_type const unit(10u + i);
+		exchange.export_clause(a, &unit, &unit + 1, 1u);
+	}
+	auto const imported = import(b);
+	REQUIRE(imported.size() == 3u);
+	CHECK(imported.front() == std::vector{lit_type(13u)});
+	CHECK(imported.back() == std::vector{lit_type(15u)});
+	CHECK(exchange.num_exported(a) == 7u);
+	CHECK(exchange.num_imported(c) == 2u);
+}
+
+TEST_CASE("Clause exchange stops at a falsified clause", "[clause_exchange]")
+{
+	using namespace bill;
+	clause_exchange exchange(2u);
+	auto const a = exchange.join(), b = exchange.join();
+	std::vector<lit_type> const units = {lit_type(0u), lit_type(1u)};
+	exchange.export_clause(b, units.data(), units.data() + 1, 1u);
+	exchange.export_clause(b, units.data() + 1, units.data() + 2, 1u);
+
+	/* the falsified clause is the last one of the batch */
+	auto const never = []() { return false; };
+	auto num_calls = 0u;
+	CHECK_FALSE(exchange.import_clauses(
+	    a,
+	    [&](lit_type const*, lit_type const*, uint32_t) { return ++num_calls < 2u; },
+	    never));
+	CHECK(num_calls == 2u);
+}
+
+TEMPLATE_TEST_CASE("Import a falsified clause", "[clause_exchange][template]",
+                   SHARING_SOLVER_TYPES)
+{
+	using namespace bill;
+	clause_exchange exchange(2u);
+	TestType instance;
+	instance.share_clauses(exchange);
+	auto const other = exchange.join();
+	instance.add_variables(2u);
+	instance.add_clause({lit_type(0u), lit_type(1u)});
+
+	/* the second clause contradicts the first, and ends the batch */
+	std::vector<lit_type> const units = {lit_type(0u), ~lit_type(0u)};
+	exchange.export_clause(other, units.data(), units.data() + 1, 1u);
+	exchange.export_clause(other, units.data() + 1, units.data() + 2, 1u);
+	CHECK(instance.solve() == result::states::unsatisfiable);
+}
+
+TEMPLATE_TEST_CASE("Share learnt clauses", "[clause_exchange][template]", SHARING_SOLVER_TYPES)
+{
+	using namespace bill;
+	auto const clauses = pigeon_hole(8u);
+	solve_sharing<TestType, TestType>(clauses, 56u, {});
+
+	clause_exchange_params params;
+	params.deterministic = true;
+	solve_sharing<TestType, TestType>(clauses, 56u, params);
+}
+
+TEST_CASE("Deterministic clause sharing", "[clause_exchange]")
+{
+	using namespace bill;
+	clause_exchange_params params;
+	params.deterministic = true;
+	auto const clauses = pigeon_hole(8u);
+#if defined(BILL_WINDOWS_PLATFORM)
+	using second_type = solver<solvers::ghack>;
+#else
+	using second_type = solver<solvers::maple>;
+#endif
+	auto const imported = solve_sharing<solver<solvers::glucose_41>, second_type>(clauses, 56u,
+	                                                                               params);
+	CHECK(imported.first + imported.second > 0u);
+	for (auto run = 0u; run < 3u; ++run) {
+		CHECK(solve_sharing<solver<solvers::glucose_41>, second_type>(clauses, 56u, params)
+		      == imported);
+	}
+}
+
+TEST_CASE("Portfolio solver sharing clauses", "[clause_exchange][portfolio]")
+{
+	using namespace bill;
+	portfolio_solver portfolio;
+	portfolio.share_clauses();
+	REQUIRE(portfolio.exchange() != nullptr);
+
+	for (auto round = 0u; round < 10u; ++round) {
+		portfolio.restart();
+		auto const clauses = random_cnf(60u, 255u, 7u + round);
+		portfolio.add_variables(60u);
+		portfolio.add_clauses(clauses);
+
+		solver<solvers::glucose_41> reference;
+		reference.add_variables(60u);
+		reference.add_clauses(clauses);
+		auto const state = portfolio.solve();
+		CHECK(state == reference.solve());
+		if (state == result::states::satisfiable) {
+			CHECK(satisfies(portfolio.get_model().model(), clauses));
+		}
+	}
+}
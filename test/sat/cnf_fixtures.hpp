@@ -0,0 +1,89 @@
+#pragma once
+#include <bill/sat/solver.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/* CNF instances and checks shared by the SAT and decision diagram tests */
+
+using cnf_type = std::vector<std::vector<bill::lit_type>>;
+
+/* `num_pigeons` pigeons in `num_pigeons - 1` holes, over the variables from `first` */
+inline cnf_type pigeon_hole(uint32_t num_pigeons, uint32_t first = 0u)
+{
+	using namespace bill;
+	auto const num_holes = num_pigeons - 1u;
+	auto var = [&](uint32_t p, uint32_t h) { return first + p * num_holes + h; };
+	cnf_type clauses;
+	for (auto p = 0u; p < num_pigeons; ++p) {
+		auto& clause = clauses.emplace_back();
+		for (auto h = 0u; h < num_holes; ++h) {
+			clause.emplace_back(var(p, h));
+		}
+	}
+	for (auto h = 0u; h < num_holes; ++h) {
+		for (auto p = 0u; p < num_pigeons; ++p) {
+			for (auto q = p + 1u; q < num_pigeons; ++q) {
+				clauses.push_back({lit_type(var(p, h), negative_polarity),
+				                   lit_type(var(q, h), negative_polarity)});
+			}
+		}
+	}
+	return clauses;
+}
+
+/* Adds the pigeon hole problem over new variables of `solver` */
+template<typename Solver>
+void add_pigeon_hole(Solver& solver, uint32_t num_pigeons)
+{
+	auto const first = solver.num_variables();
+	solver.add_variables(num_pigeons * (num_pigeons - 1u));
+	for (auto const& clause : pigeon_hole(num_pigeons, first)) {
+		solver.add_clause(clause);
+	}
+}
+
+/* Random 3-CNF of its own `seed` */
+inline cnf_type random_cnf(uint32_t num_vars, uint32_t num_clauses, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<uint32_t> var(0u, num_vars - 1u);
+	std::bernoulli_distribution negative(0.5);
+	cnf_type clauses;
+	for (auto i = 0u; i < num_clauses; ++i) {
+		auto& clause = clauses.emplace_back();
+		for (auto j = 0u; j < 3u; ++j) {
+			clause.emplace_back(var(rng), negative(rng) ? bill::negative_polarity :
+			                                              bill::positive_polarity);
+		}
+	}
+	return clauses;
+}
+
+inline bool satisfies(bill::result::model_type const& model, bill::lit_type lit)
+{
+	auto const value = model.at(lit.variable());
+	return lit.is_complemented() ? value == bill::lbool_type::false_ :
+	                               value == bill::lbool_type::true_;
+}
+
+inline bool satisfies(bill::result::model_type const& model, cnf_type const& clauses)
+{
+	return std::all_of(clauses.begin(), clauses.end(), [&](auto const& clause) {
+		return std::any_of(clause.begin(), clause.end(),
+		                   [&](bill::lit_type lit) { return satisfies(model, lit); });
+	});
+}
+
+inline bool satisfies(bill::result::model_type const& model, bill::clause_batch const& clauses)
+{
+	for (auto i = 0u; i < clauses.num_clauses(); ++i) {
+		if (std::none_of(clauses.begin(i), clauses.end(i),
+		                 [&](bill::lit_type lit) { return satisfies(model, lit); })) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,100 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+#include "solver_types.hpp"
+
+#include <bill/sat/cube_and_conquer.hpp>
+#include <bill/sat/solver.hpp>
+#include <random>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Cube and conquer", "[cube_and_conquer][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	cube_and_conquer_params params;
+	params.num_threads = 4u;
+	params.cube_depth = 5u;
+	cube_and_conquer_solver<TestType> cnc(params);
+	CHECK(cnc.num_threads() == 4u);
+
+	/* 7 pigeons in 6 holes */
+	cnc.add_variables(42u);
+	for (auto p = 0u; p < 7u; ++p) {
+		std::vector<lit_type> clause;
+		for (auto h = 0u; h < 6u; ++h) {
+			clause.emplace_back(p * 6u + h);
+		}
+		cnc.add_clause(clause);
+	}
+	for (auto h = 0u; h < 6u; ++h) {
+		for (auto p = 0u; p < 7u; ++p) {
+			for (auto q = p + 1u; q < 7u; ++q) {
+				cnc.add_clause({lit_type(p * 6u + h, negative_polarity),
+				                   lit_type(q * 6u + h, negative_polarity)});
+			}
+		}
+	}
+	CHECK(cnc.solve() == result::states::unsatisfiable);
+	CHECK(cnc.num_cubes() + cnc.num_refuted_cubes() > 1u);
+
+	for (auto round = 0u; round < 8u; ++round) {
+		cnc.restart();
+		auto const clauses = random_cnf(50u, 213u, 11u + round);
+		cnc.add_variables(50u);
+		cnc.add_clauses(clauses);
+
+		solver<solvers::glucose_41> reference;
+		reference.add_variables(50u);
+		reference.add_clauses(clauses);
+		auto const state = cnc.solve();
+		CHECK(state == reference.solve());
+		if (state == result::states::satisfiable) {
+			CHECK(satisfies(cnc.get_model().model(), clauses));
+
+			/* incremental: assumptions, then a clause that blocks the model */
+			auto const model = cnc.get_model().model();
+			std::vector<lit_type> blocking;
+			for (auto v = 0u; v < 50u; ++v) {
+				blocking.emplace_back(v, model.at(v) == lbool_type::true_ ? negative_polarity :
+				                                                            positive_polarity);
+			}
+			auto const flipped = ~blocking.front();
+			CHECK(cnc.solve({flipped}) == reference.solve({flipped}));
+			cnc.add_clause(blocking);
+			reference.add_clause(blocking);
+			CHECK(cnc.solve() == reference.solve());
+		}
+	}
+}
+
+TEST_CASE("Cube and conquer prunes cubes with cores", "[cube_and_conquer]")
+{
+	using namespace bill;
+	cube_and_conquer_params params;
+	params.num_threads = 1u;
+	params.cube_depth = 4u;
+	params.num_candidates = 4u;
+	cube_and_conquer_solver<solver<solvers::glucose_41>> cnc(params);
+
+	/* x0 contradicts all assignments to x1 and x2, which the lookahead does not probe since the
+	 * other variables occur more often */
+	cnc.add_variables(12u);
+	for (auto const x1 : {lit_type(1u), ~lit_type(1u)}) {
+		for (auto const x2 : {lit_type(2u), ~lit_type(2u)}) {
+			cnc.add_clause({~lit_type(0u), x1, x2});
+		}
+	}
+	std::mt19937 rng(3u);
+	for (auto i = 0u; i < 40u; ++i) {
+		cnc.add_clause({lit_type(3u + rng() % 9u), ~lit_type(3u + rng() % 9u),
+		                lit_type(3u + rng() % 9u)});
+	}
+	CHECK(cnc.solve({lit_type(0u)}) == result::states::unsatisfiable);
+	CHECK(cnc.num_cubes() > 1u);
+	CHECK(cnc.num_pruned_cubes() + 1u == cnc.num_cubes());
+	CHECK(cnc.solve({~lit_type(0u)}) == result::states::satisfiable);
+}
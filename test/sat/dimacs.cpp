@@ -0,0 +1,162 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "solver_types.hpp"
+
+#include <bill/sat/dimacs.hpp>
+#include <bill/sat/solver.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/* pigeon hole: 3 pigeons, 2 holes; variable 2 * p + h + 1 */
+std::string const php_32 = "c pigeon hole\n"
+                           "p cnf 6 9\n"
+                           "1 2 0\n3 4 0\n5 6 0\n"
+                           "-1 -3 0 -1 -5 0 -3 -5 0\n"
+                           "-2 -4 0\n-2 -6 0\n-4 -6\n";
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Read DIMACS", "[dimacs][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	{
+		TestType solver;
+		/* tiny batches to cross batch boundaries */
+		dimacs_reader reader(php_32.data(), php_32.size(), 3u);
+		CHECK(reader.read(solver) == dimacs_status::success);
+		CHECK(reader.num_variables() == 6u);
+		CHECK(reader.num_clauses() == 9u);
+		CHECK(solver.num_variables() == 6u);
+		CHECK(solver.solve() == result::states::unsatisfiable);
+	}
+	{
+		std::string const cnf = "1 -2 0\n2 3 0\n-1 0\n%\n0\n";
+		TestType solver;
+		dimacs_reader reader(cnf.data(), cnf.size());
+		CHECK(reader.read(solver) == dimacs_status::success);
+		CHECK(reader.num_clauses() == 3u);
+		REQUIRE(solver.solve() == result::states::satisfiable);
+		auto const model = solver.get_model().model();
+		CHECK(model.at(0u) == lbool_type::false_);
+		CHECK(model.at(1u) == lbool_type::false_);
+		CHECK(model.at(2u) == lbool_type::true_);
+	}
+}
+
+TEMPLATE_TEST_CASE("Read iCNF", "[dimacs][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	std::string const icnf = "p inccnf\n"
+	                         "1 2 0\n"
+	                         "a -1 0\n"
+	                         "-2 3 0\n"
+	                         "a -1 -3 0\n"
+	                         "a 2 0\n";
+	TestType solver;
+	dimacs_reader reader(icnf.data(), icnf.size());
+	std::vector<result::states> answers;
+	CHECK(reader.read(solver, [&](std::vector<lit_type> const& assumptions) {
+		answers.emplace_back(solver.solve(assumptions));
+		return true;
+	}) == dimacs_status::success);
+	CHECK(reader.is_incremental());
+	CHECK(reader.num_queries() == 3u);
+	CHECK(answers == std::vector{result::states::satisfiable, result::states::unsatisfiable,
+	                             result::states::satisfiable});
+}
+
+TEST_CASE("DIMACS syntax errors", "[dimacs]")
+{
+	using namespace bill;
+	for (auto const& [text, line] : std::vector<std::pair<std::string, uint64_t>>{
+	         {"p cnf 2 1\n1 x 0\n", 2u},
+	         {"p dnf 2 1\n1 2 0\n", 1u},
+	         {"1 2 0\n\n3 -0\n", 3u},
+	         {"1 2 0\n3 4- 0\n", 2u},
+	         {"1 99999999999 0\n", 1u},
+	         {"p inccnf\na 1 2\n", 3u}}) {
+		solver<solvers::glucose_41> solver;
+		dimacs_reader reader(text.data(), text.size());
+		CHECK(reader.read(solver) == dimacs_status::syntax_error);
+		CHECK(reader.error_line() == line);
+	}
+
+	dimacs_reader reader(std::string("/nonexistent/bill.cnf"));
+	CHECK_FALSE(reader.is_open());
+	solver<solvers::glucose_41> solver;
+	CHECK(reader.read(solver) == dimacs_status::cannot_open);
+}
+
+TEST_CASE("Write and read DIMACS files", "[dimacs]")
+{
+	using namespace bill;
+	auto const filename = (std::filesystem::temp_directory_path() / "bill_test_dimacs.cnf").string();
+	std::vector<std::vector<lit_type>> clauses;
+	for (auto i = 0u; i < 2000u; ++i) {
+		clauses.push_back({lit_type(i % 97u, positive_polarity),
+		                   lit_type((7u * i) % 1001u, negative_polarity),
+		                   lit_type(i, i % 2u ? negative_polarity : positive_polarity)});
+	}
+	{
+		std::ofstream os(filename, std::ios::binary);
+		dimacs_writer writer(os, false, 256u);
+		writer.add_clause({lit_type(3u)});
+		writer.add_clauses(clauses);
+		CHECK(writer.num_variables() == 2000u);
+		CHECK(writer.num_clauses() == 2001u);
+	}
+
+	std::vector<std::vector<lit_type>> read;
+	dimacs_reader reader(filename, 100u);
+	REQUIRE(reader.is_open());
+	CHECK(reader.parse(
+	          [&](clause_batch const& batch, uint32_t) {
+		          for (auto i = 0u; i < batch.num_clauses(); ++i) {
+			          read.emplace_back(batch.begin(i), batch.end(i));
+		          }
+	          },
+	          [](std::vector<lit_type> const&, uint32_t) { return true; })
+	      == dimacs_status::success);
+	CHECK(reader.num_variables() == 2000u);
+	REQUIRE(read.size() == 2001u);
+	CHECK(read.front() == std::vector{lit_type(3u)});
+	CHECK(std::equal(clauses.begin(), clauses.end(), read.begin() + 1));
+	std::remove(filename.c_str());
+}
+
+TEST_CASE("Write iCNF", "[dimacs]")
+{
+	using namespace bill;
+	std::ostringstream os;
+	{
+		dimacs_writer writer(os, true);
+		auto const a = writer.add_variable();
+		auto const b = writer.add_variable();
+		writer.add_clause({lit_type(a), lit_type(b)});
+		writer.add_query({lit_type(a, negative_polarity)});
+	}
+	CHECK(os.str() == "p inccnf\n1 2 0\na -1 0\n");
+
+	std::ostringstream cnf;
+	{
+		dimacs_writer writer(cnf);
+		writer.add_clause(lit_type(1u, negative_polarity));
+	}
+	std::string const text = cnf.str();
+	CHECK(text.substr(0u, text.find(' ', 6u)) == "p cnf 2");
+	dimacs_reader reader(text.data(), text.size());
+	solver<solvers::glucose_41> solver;
+	CHECK(reader.read(solver) == dimacs_status::success);
+	CHECK(reader.num_clauses() == 1u);
+	CHECK(solver.num_variables() == 2u);
+}
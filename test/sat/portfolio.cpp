@@ -0,0 +1,103 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+#include "solver_types.hpp"
+
+#include <bill/sat/portfolio.hpp>
+#include <bill/sat/solver.hpp>
+#include <chrono>
+#include <future>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Interrupt solver", "[portfolio][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	TestType solver;
+	add_pigeon_hole(solver, 12u);
+
+	/* pending interrupt */
+	solver.interrupt();
+	CHECK(solver.solve() == result::states::undefined);
+
+	/* interrupt from another thread */
+	solver.clear_interrupt();
+	auto answer = std::async(std::launch::async, [&]() { return solver.solve(); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	solver.interrupt();
+	REQUIRE(answer.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+	CHECK(answer.get() == result::states::undefined);
+
+	TestType small;
+	add_pigeon_hole(small, 4u);
+	small.interrupt();
+	small.clear_interrupt();
+	CHECK(small.solve() == result::states::unsatisfiable);
+}
+
+TEST_CASE("Portfolio solver", "[portfolio]")
+{
+	using namespace bill;
+	portfolio_solver solver;
+	CHECK(solver.num_backends() == portfolio_solver::default_backends().size());
+
+	lit_type const a(solver.add_variable()), b(solver.add_variable()), c(solver.add_variable());
+	solver.add_clause({a, b});
+	solver.add_clause({~a, c});
+	CHECK(solver.solve() == result::states::satisfiable);
+	CHECK(solver.winner() >= 0);
+	auto model = solver.get_model().model();
+	CHECK(satisfies(model, {{a, b}, {~a, c}}));
+
+	/* incremental: assumptions and new clauses */
+	CHECK(solver.solve({~b, ~c}) == result::states::unsatisfiable);
+	CHECK(solver.solve({~b}) == result::states::satisfiable);
+	model = solver.get_model().model();
+	CHECK(model.at(0u) == lbool_type::true_);
+	CHECK(model.at(2u) == lbool_type::true_);
+	solver.add_clause(~c);
+	CHECK(solver.solve() == result::states::satisfiable);
+	CHECK(solver.get_model().model().at(1u) == lbool_type::true_);
+	solver.add_clause(~b);
+	CHECK(solver.solve() == result::states::unsatisfiable);
+	CHECK(solver.num_clauses() == 4u);
+
+	/* contradiction at level 0, with assumptions */
+	solver.restart();
+	lit_type const x(solver.add_variable()), y(solver.add_variable());
+	solver.add_clause(x);
+	solver.add_clause(~x);
+	CHECK(solver.solve({y}) == result::states::unsatisfiable);
+	CHECK(solver.winner() == -1);
+	CHECK(solver.get_core().core().empty());
+	CHECK_FALSE(solver.add_clause({x, y}));
+	CHECK(solver.solve({~y}) == result::states::unsatisfiable);
+}
+
+TEST_CASE("Portfolio solver with repeated backends", "[portfolio]")
+{
+	using namespace bill;
+	portfolio_solver portfolio({solvers::glucose_41, solvers::glucose_41, solvers::bsat2,
+	                         solvers::bsat2});
+	add_pigeon_hole(portfolio, 8u);
+	CHECK(portfolio.solve() == result::states::unsatisfiable);
+
+	for (auto round = 0u; round < 10u; ++round) {
+		portfolio.restart();
+		auto const clauses = random_cnf(40u, 150u, 5u + round);
+		portfolio.add_variables(40u);
+		portfolio.add_clauses(clauses);
+
+		solver<solvers::glucose_41> reference;
+		reference.add_variables(40u);
+		reference.add_clauses(clauses);
+		auto const state = portfolio.solve();
+		CHECK(state == reference.solve());
+		if (state == result::states::satisfiable) {
+			CHECK(satisfies(portfolio.get_model().model(), clauses));
+		}
+	}
+}
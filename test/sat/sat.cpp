@@ -10,6 +10,7 @@
 #include <bill/sat/solver.hpp>
 #include <bill/sat/tseytin.hpp>
 #include <bill/sat/xor_clauses.hpp>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -234,6 +235,62 @@ TEMPLATE_TEST_CASE("XOR clause", "[sat][template]", SOLVER_TYPES)
 	}
 }
 
+TEMPLATE_TEST_CASE("Batched clauses", "[sat][template]", SOLVER_TYPES)
+{
+	TestType solver;
+	solver.add_variables(3u);
+	lit_type const a(0u), b(1u), c(2u);
+
+	/* exactly one of a, b, c */
+	clause_batch batch;
+	batch.reserve(4u, 9u);
+	batch.add_clause({a, b, c});
+	batch.add_clause({~a, ~b});
+	batch.add_clause(std::vector{~a, ~c});
+	batch.add_clause({~b, ~c});
+	CHECK(batch.num_clauses() == 4u);
+	CHECK(batch.num_literals() == 9u);
+	solver.add_clauses(batch);
+
+	CHECK(solver.solve({a}) == result::states::satisfiable);
+	CHECK(solver.solve({a, b}) == result::states::unsatisfiable);
+	CHECK(solver.solve({~a, ~b, ~c}) == result::states::unsatisfiable);
+
+	/* the batch can be refilled */
+	batch.clear();
+	CHECK(batch.num_clauses() == 0u);
+	batch.add_clause({~a});
+	solver.add_clauses(batch);
+	solver.add_clauses(std::vector<std::vector<lit_type>>{{~b}});
+	CHECK(solver.solve() == result::states::satisfiable);
+	CHECK(solver.get_model().model().at(2u) == lbool_type::true_);
+
+	clause_batch const flat({a, b, ~a, ~b}, {0u, 2u, 3u, 4u});
+	CHECK(flat.num_clauses() == 3u);
+	CHECK(flat.end(1u) - flat.begin(1u) == 1);
+	TestType other;
+	other.add_variables(2u);
+	other.add_clauses(flat);
+	CHECK(other.solve() == result::states::unsatisfiable);
+}
+
+TEST_CASE("Literal layout", "[sat]")
+{
+	for (auto var = 0u; var < 100u; var += 7u) {
+		for (auto const sign : {false, true}) {
+			lit_type const lit(var, sign ? negative_polarity : positive_polarity);
+			int numeral;
+			std::memcpy(&numeral, &lit, sizeof(lit));
+			CHECK(numeral == Glucose::mkLit(var, sign).x);
+			CHECK(numeral == GHack::mkLit(var, sign).x);
+#if !defined(BILL_WINDOWS_PLATFORM)
+			CHECK(numeral == Maple::mkLit(var, sign).x);
+#endif
+			CHECK(numeral == pabc::Abc_Var2Lit(var, sign));
+		}
+	}
+}
+
 TEMPLATE_TEST_CASE("Push/pop", "[sat][template]", STACKABLE_SOLVER_TYPES)
 {
 	TestType solver;
@@ -0,0 +1,105 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+#include "solver_types.hpp"
+
+#include <bill/sat/scheduler.hpp>
+#include <bill/sat/solver.hpp>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Scheduler", "[scheduler][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	using namespace std::chrono_literals;
+	/* the solvers outlive the scheduler */
+	TestType hog;
+	std::vector<std::unique_ptr<TestType>> instances;
+	solver_scheduler_params params;
+	params.num_threads = 1u;
+	params.conflict_slice = 100u;
+	solver_scheduler<TestType> scheduler(params);
+
+	/* a session that does not answer does not starve the others, even on one thread */
+	add_pigeon_hole(hog, 12u);
+	auto hog_answer = scheduler.submit(hog);
+
+	std::vector<result::states> expected;
+	std::vector<std::future<result::states>> answers;
+	for (auto i = 0u; i < 6u; ++i) {
+		auto const clauses = random_cnf(60u, 255u, 11u + i);
+		auto& solver = *instances.emplace_back(std::make_unique<TestType>());
+		solver.add_variables(60u);
+		solver.add_clauses(clauses);
+		bill::solver<solvers::glucose_41> reference;
+		reference.add_variables(60u);
+		reference.add_clauses(clauses);
+		expected.emplace_back(reference.solve());
+		answers.emplace_back(scheduler.submit(solver, {}, 1u + i % 2u));
+	}
+	for (auto i = 0u; i < answers.size(); ++i) {
+		REQUIRE(answers[i].wait_for(60s) == std::future_status::ready);
+		CHECK(answers[i].get() == expected[i]);
+	}
+	CHECK(hog_answer.wait_for(0s) == std::future_status::timeout);
+	CHECK(scheduler.num_sessions() == 1u);
+
+	/* the solvers may be used again once answered */
+	CHECK(scheduler.submit(*instances.front(), {}, 1u, deadline_clock::now() + 1h).get()
+	      == expected.front());
+
+	CHECK(scheduler.cancel(hog));
+	REQUIRE(hog_answer.wait_for(10s) == std::future_status::ready);
+	CHECK(hog_answer.get() == result::states::undefined);
+	CHECK_FALSE(scheduler.cancel(hog));
+
+	/* deadlines */
+	auto late = scheduler.submit(hog, {}, 1u, deadline_clock::now() + 50ms);
+	REQUIRE(late.wait_for(10s) == std::future_status::ready);
+	CHECK(late.get() == result::states::timeout);
+	CHECK(scheduler.num_sessions() == 0u);
+}
+
+TEST_CASE("Scheduler memory limit", "[scheduler]")
+{
+	using namespace bill;
+	using namespace std::chrono_literals;
+	using solver_type = solver<solvers::glucose_41>;
+	solver_type first, second;
+	add_pigeon_hole(first, 12u);
+	add_pigeon_hole(second, 12u);
+
+	/* only one session fits */
+	solver_scheduler_params params;
+	params.num_threads = 2u;
+	params.conflict_slice = 100u;
+	params.memory_limit = solver_scheduler<solver_type>::estimated_memory(first) + 1u;
+	solver_scheduler<solver_type> scheduler(params);
+	auto first_answer = scheduler.submit(first);
+	auto second_answer = scheduler.submit(second);
+	CHECK(scheduler.num_sessions() == 2u);
+	CHECK(scheduler.num_waiting() == 1u);
+	CHECK(scheduler.memory_in_flight() == params.memory_limit - 1u);
+
+	scheduler.cancel(first);
+	REQUIRE(first_answer.wait_for(10s) == std::future_status::ready);
+	CHECK(first_answer.get() == result::states::undefined);
+	CHECK(scheduler.num_waiting() == 0u);
+	CHECK(second_answer.wait_for(0s) == std::future_status::timeout);
+
+	/* the destructor leaves unanswered sessions undefined */
+	{
+		solver_scheduler<solver_type> other(params);
+		first_answer = other.submit(first);
+	}
+	CHECK(first_answer.get() == result::states::undefined);
+	scheduler.cancel(second);
+	CHECK(second_answer.get() == result::states::undefined);
+}
@@ -0,0 +1,73 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+#include "solver_types.hpp"
+
+#include <bill/sat/solve_async.hpp>
+#include <bill/sat/solver.hpp>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Solve asynchronously", "[solve_async][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	using namespace std::chrono_literals;
+	TestType solver;
+	add_pigeon_hole(solver, 12u);
+
+	/* deadline */
+	auto answer = solve_async(solver, {}, deadline_clock::now() + 50ms);
+	REQUIRE(answer.wait_for(10s) == std::future_status::ready);
+	CHECK(answer.get() == result::states::timeout);
+
+	/* a deadline in the past */
+	answer = solve_async(solver, {}, deadline_clock::now() - 1s);
+	REQUIRE(answer.wait_for(10s) == std::future_status::ready);
+	CHECK(answer.get() == result::states::timeout);
+
+	/* cancellation, also of a call with a deadline */
+	answer = solve_async(solver);
+	std::this_thread::sleep_for(50ms);
+	solver.interrupt();
+	REQUIRE(answer.wait_for(10s) == std::future_status::ready);
+	CHECK(answer.get() == result::states::undefined);
+	answer = solve_async(solver, {}, deadline_clock::now() + 1h);
+	solver.interrupt();
+	REQUIRE(answer.wait_for(10s) == std::future_status::ready);
+	CHECK(answer.get() == result::states::undefined);
+
+	/* a cancellation survives a deadline that expires afterwards */
+	answer = solve_async(solver, {}, deadline_clock::now() + 20ms);
+	solver.interrupt();
+	std::this_thread::sleep_for(100ms);
+	REQUIRE(answer.wait_for(10s) == std::future_status::ready);
+	CHECK(answer.get() == result::states::undefined);
+	CHECK(solver.is_interrupted());
+	CHECK(solver.solve() == result::states::undefined);
+	solver.clear_interrupt();
+	CHECK_FALSE(solver.is_interrupted());
+
+	/* the interrupt of the deadline alone is cleared */
+	CHECK(solve_async(solver, {}, deadline_clock::now() + 20ms).get() == result::states::timeout);
+	CHECK_FALSE(solver.is_interrupted());
+
+	/* answers before the deadline, and after an interrupted call */
+	TestType small;
+	add_pigeon_hole(small, 4u);
+	small.interrupt();
+	CHECK(solve_async(small, {}, deadline_clock::now() + 1h).get()
+	      == result::states::unsatisfiable);
+	TestType sat;
+	lit_type const a(sat.add_variable()), b(sat.add_variable());
+	sat.add_clause({a, b});
+	CHECK(solve_async(sat, {~a}, deadline_clock::now() + 1h).get()
+	      == result::states::satisfiable);
+	CHECK(sat.get_model().model().at(1u) == lbool_type::true_);
+	CHECK(solve_async(sat, {~a, ~b}).get() == result::states::unsatisfiable);
+}
@@ -0,0 +1,71 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+#include "solver_types.hpp"
+
+#include <bill/sat/solver.hpp>
+#include <bill/sat/solver_farm.hpp>
+#include <future>
+#include <vector>
+
+TEMPLATE_TEST_CASE("Solver farm", "[solver_farm][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	solver_farm_params params;
+	params.num_threads = 4u;
+	solver_farm<TestType> farm(params);
+	CHECK(farm.num_threads() == 4u);
+
+	std::vector<clause_batch> problems;
+	std::vector<result::states> expected;
+	std::vector<std::future<result>> answers;
+	for (auto i = 0u; i < 40u; ++i) {
+		auto& clauses = problems.emplace_back();
+		for (auto const& clause : random_cnf(30u, 128u, 17u + i)) {
+			clauses.add_clause(clause);
+		}
+		solver<solvers::glucose_41> reference;
+		reference.add_variables(30u);
+		reference.add_clauses(clauses);
+		expected.emplace_back(reference.solve());
+		answers.emplace_back(farm.submit(clauses, {}, 30u));
+	}
+	for (auto i = 0u; i < answers.size(); ++i) {
+		auto const answer = answers[i].get();
+		if (expected[i] == result::states::satisfiable) {
+			REQUIRE(answer.is_satisfiable());
+			CHECK(answer.model().size() == 30u);
+			CHECK(satisfies(answer.model(), problems[i]));
+		} else {
+			CHECK(answer.is_unsatisfiable());
+		}
+	}
+
+	/* assumptions, and variables of the literals only */
+	clause_batch clauses;
+	clauses.add_clause({lit_type(0u), lit_type(1u)});
+	auto const sat = farm.submit(clauses, {~lit_type(0u)}).get();
+	REQUIRE(sat.is_satisfiable());
+	CHECK(sat.model().size() == 2u);
+	CHECK(sat.model().at(1u) == lbool_type::true_);
+	auto const unsat = farm.submit(clauses, {~lit_type(0u), ~lit_type(1u)}).get();
+	CHECK(unsat.is_unsatisfiable());
+	if constexpr (detail::has_get_core<TestType>::value) {
+		CHECK(unsat.core().size() == 2u);
+	}
+
+	/* contradiction at level 0, with assumptions */
+	clause_batch contradiction;
+	contradiction.add_clause({lit_type(0u)});
+	contradiction.add_clause({~lit_type(0u)});
+	auto const refuted = farm.submit(contradiction, {lit_type(1u)}, 2u).get();
+	CHECK(refuted.is_unsatisfiable());
+	if constexpr (detail::has_get_core<TestType>::value) {
+		CHECK(refuted.core().empty());
+	}
+	CHECK(farm.num_queued() == 0u);
+}
@@ -0,0 +1,91 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+#include "solver_types.hpp"
+
+#include <bill/sat/solver.hpp>
+#include <bill/sat/solver_pool.hpp>
+#include <vector>
+
+#if defined(BILL_WINDOWS_PLATFORM)
+#define RESET_SOLVER_TYPES bill::solver<bill::solvers::glucose_41>, bill::solver<bill::solvers::ghack>
+#else
+#define RESET_SOLVER_TYPES                                                                     \
+	bill::solver<bill::solvers::glucose_41>, bill::solver<bill::solvers::ghack>, \
+	    bill::solver<bill::solvers::maple>
+#endif
+
+TEMPLATE_TEST_CASE("Restart resets in place", "[solver_pool][template]", RESET_SOLVER_TYPES)
+{
+	using namespace bill;
+	TestType reused;
+	for (auto i = 0u; i < 20u; ++i) {
+		auto const clauses = random_cnf(50u, 213u, 23u + i);
+		if (i % 5u == 0u) {
+			/* leave learnt clauses, activities and a conflict-limited call behind */
+			reused.add_variables(50u);
+			reused.add_clauses(clauses);
+			reused.solve({lit_type(0u)}, 10u);
+			reused.solve();
+			reused.restart();
+		}
+		CHECK(reused.num_variables() == 0u);
+		CHECK(reused.num_clauses() == 0u);
+
+		TestType fresh;
+		fresh.add_variables(50u);
+		fresh.add_clauses(clauses);
+		reused.add_variables(50u);
+		reused.add_clauses(clauses);
+		auto const state = fresh.solve();
+		REQUIRE(reused.solve() == state);
+		if (state == result::states::satisfiable) {
+			CHECK(reused.get_model().model() == fresh.get_model().model());
+		}
+		reused.restart();
+	}
+}
+
+TEMPLATE_TEST_CASE("Solver pool", "[solver_pool][template]", SOLVER_TYPES)
+{
+	using namespace bill;
+	solver_pool_params params;
+	params.num_solvers = 2u;
+	params.num_variables = 100u;
+	params.num_clauses = 400u;
+	solver_pool<TestType> pool(params);
+	CHECK(pool.num_created() == 2u);
+	CHECK(pool.num_available() == 2u);
+
+	for (auto round = 0u; round < 3u; ++round) {
+		std::vector<typename solver_pool<TestType>::handle> handles;
+		for (auto i = 0u; i < 3u; ++i) {
+			auto& instance = *handles.emplace_back(pool.acquire());
+			CHECK(instance.num_variables() == 0u);
+			CHECK(instance.num_clauses() == 0u);
+
+			auto const clauses = random_cnf(40u, 170u, 29u + 3u * round + i);
+			solver<solvers::glucose_41> reference;
+			reference.add_variables(40u);
+			reference.add_clauses(clauses);
+			instance.add_variables(40u);
+			instance.add_clauses(clauses);
+			CHECK(instance.solve() == reference.solve());
+		}
+		handles.front()->interrupt();
+		CHECK(pool.num_available() == 0u);
+	}
+	CHECK(pool.num_created() == 3u);
+	CHECK(pool.num_available() == 3u);
+
+	/* returned solvers are clean */
+	auto instance = pool.acquire();
+	instance->add_variables(2u);
+	instance->add_clause({lit_type(0u), lit_type(1u)});
+	CHECK(instance->solve({~lit_type(0u)}) == result::states::satisfiable);
+	CHECK(instance->solve({~lit_type(0u), ~lit_type(1u)}) == result::states::unsatisfiable);
+}
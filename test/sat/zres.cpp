@@ -0,0 +1,128 @@
+/*-------------------------------------------------------------------------------------------------
+| This file is distributed under the MIT License.
+| See accompanying file /LICENSE for details.
+*------------------------------------------------------------------------------------------------*/
+#include "../catch2.hpp"
+
+#include "cnf_fixtures.hpp"
+
+#include <bill/sat/solver.hpp>
+#include <bill/sat/zres.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+bill::result::states solve(uint32_t num_vars, cnf_type const& clauses,
+                           bill::result::model_type& model)
+{
+	if (std::find(clauses.begin(), clauses.end(), std::vector<bill::lit_type>{}) != clauses.end()) {
+		return bill::result::states::unsatisfiable;
+	}
+	if (clauses.empty()) {
+		model.assign(num_vars, bill::lbool_type::false_);
+		return bill::result::states::satisfiable;
+	}
+	bill::solver<bill::solvers::glucose_41> solver;
+	solver.add_variables(num_vars);
+	for (auto const& clause : clauses) {
+		solver.add_clause(clause);
+	}
+	auto const state = solver.solve();
+	if (state == bill::result::states::satisfiable) {
+		model = solver.get_model().model();
+	}
+	return state;
+}
+
+} // namespace
+
+TEST_CASE("ZRes subsumption", "[zres]")
+{
+	using namespace bill;
+	lit_type const a(0u), b(1u), c(2u);
+	cnf_type const clauses = {{a, b}, {a, b, c}, {b, a}, {a, ~a, c}, {~c}};
+
+	zres_preprocessor zres(3u, clauses);
+	CHECK(zres.num_clauses() == 2u);
+	CHECK(zres.stats().num_input_clauses == 5u);
+	CHECK(zres.stats().num_subsumed_clauses == 3u);
+	CHECK_FALSE(zres.is_unsatisfiable());
+
+	auto result = zres.clauses();
+	for (auto& clause : result) {
+		std::sort(clause.begin(), clause.end());
+	}
+	std::sort(result.begin(), result.end());
+	CHECK(result == cnf_type{{a, b}, {~c}});
+}
+
+TEST_CASE("ZRes eliminate implication chain", "[zres]")
+{
+	using namespace bill;
+	/* x0 -> x1 -> ... -> x9 */
+	cnf_type clauses;
+	for (auto i = 0u; i < 9u; ++i) {
+		clauses.push_back({lit_type(i, negative_polarity), lit_type(i + 1u)});
+	}
+
+	zres_params ps;
+	ps.frozen = {0u, 9u};
+	zres_preprocessor zres(10u, clauses, ps);
+	CHECK(zres.eliminate() == 8u);
+	CHECK(zres.stats().num_eliminated_vars == 8u);
+	CHECK_FALSE(zres.is_eliminated(0u));
+	CHECK(zres.is_eliminated(5u));
+
+	auto result = zres.clauses();
+	REQUIRE(result.size() == 1u);
+	std::sort(result.front().begin(), result.front().end());
+	CHECK(result.front() == std::vector{lit_type(0u, negative_polarity), lit_type(9u)});
+
+	result::model_type model(10u, lbool_type::undefined);
+	model.at(0u) = lbool_type::true_;
+	model.at(9u) = lbool_type::true_;
+	zres.extend_model(model);
+	CHECK(satisfies(model, clauses));
+}
+
+TEST_CASE("ZRes unsatisfiable", "[zres]")
+{
+	using namespace bill;
+	lit_type const a(0u), b(1u);
+	cnf_type const clauses = {{a, b}, {a, ~b}, {~a, b}, {~a, ~b}};
+
+	zres_preprocessor zres(2u, clauses);
+	zres.eliminate();
+	CHECK(zres.is_unsatisfiable());
+	CHECK(zres.clauses() == cnf_type{{}});
+}
+
+TEST_CASE("ZRes random CNFs", "[zres]")
+{
+	using namespace bill;
+	constexpr uint32_t num_vars = 12u;
+	for (auto seed = 0u; seed < 40u; ++seed) {
+		auto const clauses = random_cnf(num_vars, 30u + seed % 30u, seed);
+
+		zres_params ps;
+		ps.max_clause_growth = seed % 3u;
+		ps.symbolic_bound = (seed % 4u) == 3u;
+		ps.max_node_growth = 4u;
+		zres_preprocessor zres(num_vars, clauses, ps);
+		zres.eliminate();
+		auto const reduced = zres.clauses();
+
+		result::model_type model;
+		auto const expected = solve(num_vars, clauses, model);
+		auto const state = solve(num_vars, reduced, model);
+		CHECK(state == expected);
+		CHECK(zres.is_unsatisfiable() == (std::find(reduced.begin(), reduced.end(),
+		                                            std::vector<lit_type>{})
+		                                  != reduced.end()));
+		if (state == result::states::satisfiable) {
+			zres.extend_model(model);
+			CHECK(satisfies(model, clauses));
+		}
+	}
+}